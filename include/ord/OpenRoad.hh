@@ -205,7 +205,8 @@ class OpenRoad
                const char* lib_name,
                const char* tech_name,
                bool make_tech,
-               bool make_library);
+               bool make_library,
+               const char* cache_dir = "");
 
   void readDef(const char* filename,
                odb::dbTech* tech,
@@ -228,6 +229,8 @@ class OpenRoad
                 const std::vector<const char*>& mastersFilenames,
                 bool includeFillers);
 
+  void writeGds(const char* filename, const char* layer_map);
+
   void readVerilog(const char* filename);
   void linkDesign(const char* design_name, bool hierarchy);
   // Used if a design is created programmatically rather than loaded
@@ -259,6 +262,7 @@ class OpenRoad
 
  private:
   OpenRoad();
+  void addMetricsCounters();
 
   Tcl_Interp* tcl_interp_ = nullptr;
   utl::Logger* logger_ = nullptr;
@@ -159,7 +159,8 @@ proc report_power_metric { args } {
 define_cmd_args "report_units_metric" {}
 proc report_units_metric { args } {
 
-  utl::push_metrics_stage "run__flow__platform__{}_units"
+  # Units are not a flow step, so skip the stage resource metrics.
+  utl::push_metrics_stage "run__flow__platform__{}_units" false
 
   foreach unit {"time" "capacitance" "resistance" "voltage" "current" "power" "distance"} {
     utl::metric $unit "1[unit_scale_abbreviation $unit][unit_suffix $unit]"
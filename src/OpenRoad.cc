@@ -66,6 +66,7 @@
 #include "odb/db.h"
 #include "odb/defin.h"
 #include "odb/defout.h"
+#include "odb/gdsout.h"
 #include "odb/lefin.h"
 #include "odb/lefout.h"
 #include "ord/InitOpenRoad.hh"
@@ -85,6 +86,7 @@
 #include "utl/Logger.h"
 #include "utl/MakeLogger.h"
 #include "utl/ScopedTemporaryFile.h"
+#include "utl/ThreadPool.h"
 
 namespace sta {
 extern const char* openroad_swig_tcl_inits[];
@@ -141,7 +143,13 @@ OpenRoad::~OpenRoad()
   deleteReplace(replace_);
   deleteFinale(finale_);
   deleteAntennaChecker(antenna_checker_);
+  // Close any open metrics stages while the design counters can still be
+  // sampled.
+  if (logger_ != nullptr) {
+    logger_->clearMetricsStage();
+  }
   odb::dbDatabase::destroy(db_);
+  db_ = nullptr;
   deletePartitionMgr(partitionMgr_);
   deletePdnGen(pdngen_);
   deleteICeWall(icewall_);
@@ -178,6 +186,7 @@ void OpenRoad::init(Tcl_Interp* tcl_interp)
   // Make components.
   logger_ = makeLogger(log_filename, metrics_filename);
   db_->setLogger(logger_);
+  addMetricsCounters();
   sta_ = makeDbSta();
   verilog_network_ = makeDbVerilogNetwork();
   ioPlacer_ = makeIoplacer();
@@ -252,15 +261,46 @@ void OpenRoad::init(Tcl_Interp* tcl_interp)
   }
 }
 
+void OpenRoad::addMetricsCounters()
+{
+  // Sampled at the start and end of each metrics stage so the change in
+  // design size per flow step shows up next to its runtime and memory.
+  auto block_counter = [this](auto count) {
+    return [this, count]() -> int64_t {
+      if (db_ == nullptr) {
+        return 0;
+      }
+      dbChip* chip = db_->getChip();
+      if (chip == nullptr || chip->getBlock() == nullptr) {
+        return 0;
+      }
+      return count(chip->getBlock());
+    };
+  };
+  logger_->addMetricsCounter(
+      "design__instance__count",
+      block_counter([](dbBlock* block) { return block->getInsts().size(); }));
+  logger_->addMetricsCounter(
+      "design__net__count",
+      block_counter([](dbBlock* block) { return block->getNets().size(); }));
+  logger_->addMetricsCounter(
+      "design__io__count",
+      block_counter([](dbBlock* block) { return block->getBTerms().size(); }));
+  logger_->addMetricsCounter("flow__threads",
+                             [this]() -> int64_t { return threads_; });
+}
+
 ////////////////////////////////////////////////////////////////
 
 void OpenRoad::readLef(const char* filename,
                        const char* lib_name,
                        const char* tech_name,
                        bool make_tech,
-                       bool make_library)
+                       bool make_library,
+                       const char* cache_dir)
 {
   odb::lefin lef_reader(db_, logger_, false);
+  lef_reader.setCacheDir(cache_dir);
   dbLib* lib = nullptr;
   dbTech* tech = nullptr;
   if (make_tech && make_library) {
@@ -437,6 +477,22 @@ void OpenRoad::writeCdl(const char* outFilename,
   }
 }
 
+void OpenRoad::writeGds(const char* filename, const char* layer_map)
+{
+  odb::dbChip* chip = db_->getChip();
+  if (chip) {
+    odb::dbBlock* block = chip->getBlock();
+    if (block) {
+      utl::StreamHandler stream_handler(filename, true);
+      odb::gdsout writer(logger_, stream_handler.getStream());
+      if (layer_map[0] != '\0') {
+        writer.readLayerMap(layer_map);
+      }
+      writer.writeBlock(block);
+    }
+  }
+}
+
 void OpenRoad::readDb(const char* filename)
 {
   if (db_->getChip() && db_->getChip()->getBlock()) {
@@ -570,6 +626,7 @@ void OpenRoad::setThreadCount(int threads, bool printInfo)
 
   // place limits on tools with threads
   sta_->setThreadCount(threads_);
+  utl::ThreadPool::global().setThreadCount(threads_);
 }
 
 void OpenRoad::setThreadCount(const char* threads, bool printInfo)
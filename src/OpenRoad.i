@@ -332,10 +332,12 @@ read_lef_cmd(const char *filename,
 	     const char *lib_name,
 	     const char *tech_name,
 	     bool make_tech,
-	     bool make_library)
+	     bool make_library,
+	     const char *cache_dir)
 {
   OpenRoad *ord = getOpenRoad();
-  ord->readLef(filename, lib_name, tech_name, make_tech, make_library);
+  ord->readLef(filename, lib_name, tech_name, make_tech, make_library,
+               cache_dir);
 }
 
 void
@@ -396,6 +398,14 @@ write_cdl_cmd(const char *outFilename,
   ord->writeCdl(outFilename, *mastersFilenames, includeFillers);
 }
 
+void
+write_gds_cmd(const char *filename,
+              const char *layer_map)
+{
+  OpenRoad *ord = getOpenRoad();
+  ord->writeGds(filename, layer_map);
+}
+
 void
 read_db_cmd(const char *filename)
 {
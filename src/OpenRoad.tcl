@@ -34,10 +34,12 @@
 ############################################################################
 
 # -library is the default
-sta::define_cmd_args "read_lef" {[-tech] [-library] [-tech_name name] filename}
+sta::define_cmd_args "read_lef" {[-tech] [-library] [-tech_name name]\
+                                   [-cache_dir dir] filename}
 
 proc read_lef { args } {
-  sta::parse_key_args "read_lef" args keys {-tech_name} flags {-tech -library}
+  sta::parse_key_args "read_lef" args keys {-tech_name -cache_dir} \
+    flags {-tech -library}
   sta::check_argc_eq1 "read_lef" $args
 
   set filename [file nativename [lindex $args 0]]
@@ -67,7 +69,13 @@ proc read_lef { args } {
     set tech_name $lib_name
   }
 
-  ord::read_lef_cmd $filename $lib_name $tech_name $make_tech $make_lib
+  set cache_dir ""
+  if { [info exists keys(-cache_dir)] } {
+    set cache_dir [file nativename $keys(-cache_dir)]
+  }
+
+  ord::read_lef_cmd $filename $lib_name $tech_name $make_tech $make_lib \
+    $cache_dir
 }
 
 sta::define_cmd_args "read_def" {[-floorplan_initialize|-incremental|-child]\
@@ -181,6 +189,19 @@ proc write_cdl { args } {
   ord::write_cdl_cmd $out_filename $masters_filenames $fillers
 }
 
+sta::define_cmd_args "write_gds" {[-layer_map layer_map_file] filename}
+
+proc write_gds { args } {
+  sta::parse_key_args "write_gds" args keys {-layer_map} flags {}
+  sta::check_argc_eq1 "write_gds" $args
+  set layer_map ""
+  if { [info exists keys(-layer_map)] } {
+    set layer_map [file nativename $keys(-layer_map)]
+  }
+  set filename [file nativename [lindex $args 0]]
+  ord::write_gds_cmd $filename $layer_map
+}
+
 
 sta::define_cmd_args "read_db" {filename}
 
@@ -32,6 +32,8 @@
 #pragma once
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <unordered_set>
 
@@ -50,9 +52,11 @@ using utl::Logger;
 struct PARinfo;
 struct ARinfo;
 struct AntennaModel;
+class AntennaDbCbk;
 
 ///////////////////////////////////////
 struct GraphNode;
+class NodeIndex;
 
 struct NodeInfo
 {
@@ -119,8 +123,9 @@ struct Violation
 };
 
 using LayerToNodeInfo = std::map<odb::dbTechLayer*, NodeInfo>;
-using GraphNodes = std::vector<GraphNode*>;
+using GraphNodes = std::vector<GraphNode>;
 using LayerToGraphNodes = std::unordered_map<odb::dbTechLayer*, GraphNodes>;
+using LayerToNodeIndex = std::unordered_map<odb::dbTechLayer*, NodeIndex>;
 using GateToLayerToNodeInfo = std::map<std::string, LayerToNodeInfo>;
 using Violations = std::vector<Violation>;
 using GateToViolationLayers
@@ -146,6 +151,8 @@ class AntennaChecker
                                   float ratio_margin);
   void initAntennaRules();
   void setReportFileName(const char* file_name);
+  // Drops the cached per net results, eg after the antenna rules changed.
+  void clearCache();
 
  private:
   bool haveRoutedNets();
@@ -161,6 +168,10 @@ class AntennaChecker
   getViolatedWireLength(odb::dbNet* net, int routing_level);
   bool isValidGate(odb::dbMTerm* mterm);
   void buildLayerMaps(odb::dbNet* net, LayerToGraphNodes& node_by_layer_map);
+  GateToLayerToNodeInfo computeGateInfo(odb::dbNet* net);
+  // Cached gate info of a routed net, computed if the net is dirty.
+  std::shared_ptr<const GateToLayerToNodeInfo> getGateInfo(odb::dbNet* net);
+  void invalidateNet(odb::dbNet* net);
   void checkNet(odb::dbNet* net,
                 bool verbose,
                 bool report_if_no_violation,
@@ -172,6 +183,7 @@ class AntennaChecker
                 Violations& antenna_violations);
   void saveGates(odb::dbNet* db_net,
                  LayerToGraphNodes& node_by_layer_map,
+                 const LayerToNodeIndex& index_by_layer_map,
                  int node_count);
   void calculateAreas(const LayerToGraphNodes& node_by_layer_map,
                       GateToLayerToNodeInfo& gate_info);
@@ -183,7 +195,7 @@ class AntennaChecker
                             bool report,
                             std::ofstream& report_file);
   void reportNet(odb::dbNet* db_net,
-                 GateToLayerToNodeInfo& gate_info,
+                 const GateToLayerToNodeInfo& gate_info,
                  GateToViolationLayers& gates_with_violations,
                  bool verbose,
                  std::ofstream& report_file);
@@ -193,7 +205,7 @@ class AntennaChecker
                  std::ofstream& report_file,
                  odb::dbMTerm* diode_mterm,
                  float ratio_margin,
-                 GateToLayerToNodeInfo& gate_info,
+                 const GateToLayerToNodeInfo& gate_info,
                  Violations& antenna_violations);
   void calculateViaPar(odb::dbTechLayer* tech_layer, NodeInfo& info);
   void calculateWirePar(odb::dbTechLayer* tech_layer, NodeInfo& info);
@@ -228,8 +240,16 @@ class AntennaChecker
   std::string report_file_name_;
   odb::dbTechLayer* min_layer_;
   std::vector<odb::dbNet*> nets_;
+  // The wire graph analysis of each checked net, kept until a db callback
+  // reports a change to the net wire or connectivity.
+  std::unordered_map<odb::dbNet*, std::shared_ptr<const GateToLayerToNodeInfo>>
+      gate_info_cache_;
+  std::mutex cache_mutex_;
+  std::unique_ptr<AntennaDbCbk> db_cbk_;
   // consts
   static constexpr int max_diode_count_per_gate = 10;
+
+  friend class AntennaDbCbk;
 };
 
 }  // namespace ant
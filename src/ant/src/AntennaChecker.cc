@@ -46,6 +46,7 @@
 
 #include "Polygon.hh"
 #include "odb/db.h"
+#include "odb/dbBlockCallBackObj.h"
 #include "odb/dbShape.h"
 #include "odb/dbTypes.h"
 #include "utl/Logger.h"
@@ -84,6 +85,61 @@ extern "C" {
 extern int Ant_Init(Tcl_Interp* interp);
 }
 
+// Invalidates the cached results of nets whose wires or pins change.
+class AntennaDbCbk : public odb::dbBlockCallBackObj
+{
+ public:
+  AntennaDbCbk(AntennaChecker* checker) : checker_(checker) {}
+
+  void inDbPostMoveInst(odb::dbInst* inst) override { instNetsDirty(inst); }
+  void inDbInstSwapMasterAfter(odb::dbInst* inst) override
+  {
+    instNetsDirty(inst);
+  }
+  void inDbNetDestroy(odb::dbNet* net) override { netDirty(net); }
+  void inDbITermPreDisconnect(odb::dbITerm* iterm) override
+  {
+    netDirty(iterm->getNet());
+  }
+  void inDbITermPostConnect(odb::dbITerm* iterm) override
+  {
+    netDirty(iterm->getNet());
+  }
+  void inDbWireCreate(odb::dbWire* wire) override { wireDirty(wire); }
+  void inDbWireDestroy(odb::dbWire* wire) override { wireDirty(wire); }
+  void inDbWirePostModify(odb::dbWire* wire) override { wireDirty(wire); }
+  void inDbWirePostAttach(odb::dbWire* wire) override { wireDirty(wire); }
+  void inDbWirePostDetach(odb::dbWire* wire, odb::dbNet* net) override
+  {
+    netDirty(net);
+  }
+  void inDbWirePostAppend(odb::dbWire* src, odb::dbWire* dst) override
+  {
+    wireDirty(dst);
+  }
+  void inDbWirePostCopy(odb::dbWire* src, odb::dbWire* dst) override
+  {
+    wireDirty(dst);
+  }
+
+ private:
+  void netDirty(odb::dbNet* net)
+  {
+    if (net != nullptr) {
+      checker_->invalidateNet(net);
+    }
+  }
+  void wireDirty(odb::dbWire* wire) { netDirty(wire->getNet()); }
+  void instNetsDirty(odb::dbInst* inst)
+  {
+    for (odb::dbITerm* iterm : inst->getITerms()) {
+      netDirty(iterm->getNet());
+    }
+  }
+
+  AntennaChecker* checker_;
+};
+
 AntennaChecker::AntennaChecker() = default;
 AntennaChecker::~AntennaChecker() = default;
 
@@ -98,7 +154,13 @@ void AntennaChecker::init(odb::dbDatabase* db,
 
 void AntennaChecker::initAntennaRules()
 {
-  block_ = db_->getChip()->getBlock();
+  odb::dbBlock* block = db_->getChip()->getBlock();
+  if (block != block_ || db_cbk_ == nullptr) {
+    clearCache();
+    db_cbk_ = std::make_unique<AntennaDbCbk>(this);
+    db_cbk_->addOwner(block);
+  }
+  block_ = block;
   odb::dbTech* tech = db_->getTech();
   for (odb::dbTechLayer* tech_layer : tech->getLayers()) {
     double metal_factor = 1.0;
@@ -220,10 +282,25 @@ double AntennaChecker::getPwlFactor(
 
 void AntennaChecker::saveGates(odb::dbNet* db_net,
                                LayerToGraphNodes& node_by_layer_map,
+                               const LayerToNodeIndex& index_by_layer_map,
                                const int node_count)
 {
   std::unordered_map<PinType, std::vector<int>, PinTypeHash> pin_nbrs;
   std::vector<int> ids;
+  // add the ids of the nodes on layer that touch pin_pol to the pin
+  auto add_pin_nbrs = [&](odb::dbTechLayer* layer,
+                          const Polygon& pin_pol,
+                          std::vector<int>& nbrs) {
+    auto index_it = index_by_layer_map.find(layer);
+    if (index_it == index_by_layer_map.end()) {
+      return;
+    }
+    const GraphNodes& nodes = node_by_layer_map[layer];
+    findNodesWithIntersection(nodes, index_it->second, pin_pol, ids);
+    for (const int& index : ids) {
+      nbrs.push_back(nodes[index].id);
+    }
+  };
   // iterate all instance pins
   for (odb::dbITerm* iterm : db_net->getITerms()) {
     odb::dbMTerm* mterm = iterm->getMTerm();
@@ -248,26 +325,16 @@ void AntennaChecker::saveGates(odb::dbNet* db_net,
         transform.apply(pin_rect);
         // convert rect -> polygon
         Polygon pin_pol = rectToPolygon(pin_rect);
+        std::vector<int>& nbrs = pin_nbrs[pin];
         // if has wire on same layer connect to pin
-        ids = findNodesWithIntersection(node_by_layer_map[tech_layer], pin_pol);
-        for (const int& index : ids) {
-          pin_nbrs[pin].push_back(node_by_layer_map[tech_layer][index]->id);
-        }
+        add_pin_nbrs(tech_layer, pin_pol, nbrs);
         // if has via on upper layer connected to pin
         if (upper_layer) {
-          ids = findNodesWithIntersection(node_by_layer_map[upper_layer],
-                                          pin_pol);
-          for (const int& index : ids) {
-            pin_nbrs[pin].push_back(node_by_layer_map[upper_layer][index]->id);
-          }
+          add_pin_nbrs(upper_layer, pin_pol, nbrs);
         }
         // if has via on lower layer connected to pin
         if (lower_layer) {
-          ids = findNodesWithIntersection(node_by_layer_map[lower_layer],
-                                          pin_pol);
-          for (const int& index : ids) {
-            pin_nbrs[pin].push_back(node_by_layer_map[lower_layer][index]->id);
-          }
+          add_pin_nbrs(lower_layer, pin_pol, nbrs);
         }
       }
     }
@@ -287,13 +354,13 @@ void AntennaChecker::saveGates(odb::dbNet* db_net,
   while (iter) {
     // iterate each node of this layer to union set
     for (auto& node_it : node_by_layer_map[iter]) {
-      int id_u = node_it->id;
+      int id_u = node_it.id;
       // if has lower layer
       lower_layer = iter->getLowerLayer();
       if (lower_layer) {
         // get lower neighbors and union
-        for (const int& lower_it : node_it->low_adj) {
-          int id_v = node_by_layer_map[lower_layer][lower_it]->id;
+        for (const int& lower_it : node_it.low_adj) {
+          int id_v = node_by_layer_map[lower_layer][lower_it].id;
           // if they are on different sets then union
           if (dsu.find_set(id_u) != dsu.find_set(id_v)) {
             dsu.union_set(id_u, id_v);
@@ -302,12 +369,12 @@ void AntennaChecker::saveGates(odb::dbNet* db_net,
       }
     }
     for (auto& node_it : node_by_layer_map[iter]) {
-      int id_u = node_it->id;
+      int id_u = node_it.id;
       // check gates in same set (first Nodes x gates)
       for (const auto& gate_it : pin_nbrs) {
         for (const int& nbr_id : gate_it.second) {
           if (dsu.find_set(id_u) == dsu.find_set(nbr_id)) {
-            node_it->gates.insert(gate_it.first);
+            node_it.gates.insert(gate_it.first);
             break;
           }
         }
@@ -411,14 +478,14 @@ void AntennaChecker::calculateAreas(const LayerToGraphNodes& node_by_layer_map,
   for (const auto& it : node_by_layer_map) {
     for (const auto& node_it : it.second) {
       NodeInfo info;
-      double area = gtl::area(node_it->pol);
+      double area = gtl::area(node_it.pol);
       // convert from dbu^2 to microns^2
       area = block_->dbuToMicrons(area);
       area = block_->dbuToMicrons(area);
       info.area = area;
       int gates_count = 0;
       std::vector<odb::dbITerm*> iterms;
-      for (const auto& gate : node_it->gates) {
+      for (const auto& gate : node_it.gates) {
         if (!gate.isITerm) {
           continue;
         }
@@ -436,11 +503,11 @@ void AntennaChecker::calculateAreas(const LayerToGraphNodes& node_by_layer_map,
         uint wire_thickness_dbu = 0;
         it.first->getThickness(wire_thickness_dbu);
         double wire_thickness = block_->dbuToMicrons(wire_thickness_dbu);
-        info.side_area = block_->dbuToMicrons(gtl::perimeter(node_it->pol)
+        info.side_area = block_->dbuToMicrons(gtl::perimeter(node_it.pol)
                                               * wire_thickness);
       }
       // put values on struct
-      for (const auto& gate : node_it->gates) {
+      for (const auto& gate : node_it.gates) {
         if (!gate.isITerm) {
           continue;
         }
@@ -757,7 +824,7 @@ bool AntennaChecker::checkRatioViolations(odb::dbTechLayer* layer,
 }
 
 void AntennaChecker::reportNet(odb::dbNet* db_net,
-                               GateToLayerToNodeInfo& gate_info,
+                               const GateToLayerToNodeInfo& gate_info,
                                GateToViolationLayers& gates_with_violations,
                                bool verbose,
                                std::ofstream& report_file)
@@ -825,7 +892,7 @@ int AntennaChecker::checkGates(odb::dbNet* db_net,
                                std::ofstream& report_file,
                                odb::dbMTerm* diode_mterm,
                                float ratio_margin,
-                               GateToLayerToNodeInfo& gate_info,
+                               const GateToLayerToNodeInfo& gate_info,
                                Violations& antenna_violations)
 {
   ratio_margin_ = ratio_margin;
@@ -871,7 +938,7 @@ int AntennaChecker::checkGates(odb::dbNet* db_net,
           if (diode_mterm) {
             diode_diff_area = diffArea(diode_mterm);
           }
-          NodeInfo violation_info = gate_info[gate][layer];
+          NodeInfo violation_info = gate_info.at(gate).at(layer);
           std::vector<odb::dbITerm*> gates = violation_info.iterms;
           odb::dbTechLayer* violation_layer = layer;
           int diode_count_per_gate = 0;
@@ -940,11 +1007,9 @@ int AntennaChecker::checkGates(odb::dbNet* db_net,
 void AntennaChecker::buildLayerMaps(odb::dbNet* db_net,
                                     LayerToGraphNodes& node_by_layer_map)
 {
-  odb::dbWire* wires = db_net->getWire();
-
   std::unordered_map<odb::dbTechLayer*, PolygonSet> set_by_layer;
 
-  wiresToPolygonSetMap(wires, set_by_layer);
+  wiresToPolygonSetMap(db_net, set_by_layer);
   avoidPinIntersection(db_net, set_by_layer);
 
   // init struct (copy polygon set information on struct to save neighbors)
@@ -953,31 +1018,46 @@ void AntennaChecker::buildLayerMaps(odb::dbNet* db_net,
 
   int node_count = 0;
   for (const auto& layer_it : set_by_layer) {
+    bool isVia = layer_it.first->getRoutingLevel() == 0;
+    GraphNodes& nodes = node_by_layer_map[layer_it.first];
+    nodes.reserve(layer_it.second.size());
     for (const auto& pol_it : layer_it.second) {
-      bool isVia = layer_it.first->getRoutingLevel() == 0;
-      node_by_layer_map[layer_it.first].push_back(
-          new GraphNode(node_count, isVia, pol_it));
+      nodes.emplace_back(node_count, isVia, pol_it);
       node_count++;
     }
   }
 
+  LayerToNodeIndex index_by_layer_map;
+  for (const auto& [layer, nodes] : node_by_layer_map) {
+    index_by_layer_map.emplace(layer, NodeIndex(nodes));
+  }
+
   // set connections between Polygons ( wire -> via -> wire)
   std::vector<int> upper_index, lower_index;
+  // nodes that touch pol on layer
+  auto find_nodes = [&](odb::dbTechLayer* layer,
+                        const Polygon& pol,
+                        std::vector<int>& ids) {
+    ids.clear();
+    auto index_it = index_by_layer_map.find(layer);
+    if (index_it != index_by_layer_map.end()) {
+      findNodesWithIntersection(
+          node_by_layer_map[layer], index_it->second, pol, ids);
+    }
+  };
   for (const auto& layer_it : set_by_layer) {
     // iterate only via layers
     if (layer_it.first->getRoutingLevel() == 0) {
       int via_index = 0;
       for (const auto& via_it : layer_it.second) {
-        lower_index = findNodesWithIntersection(
-            node_by_layer_map[layer_it.first->getLowerLayer()], via_it);
-        upper_index = findNodesWithIntersection(
-            node_by_layer_map[layer_it.first->getUpperLayer()], via_it);
+        find_nodes(layer_it.first->getLowerLayer(), via_it, lower_index);
+        find_nodes(layer_it.first->getUpperLayer(), via_it, upper_index);
 
         if (upper_index.size() <= 2) {
           // connect upper -> via
           for (int& up_index : upper_index) {
             node_by_layer_map[layer_it.first->getUpperLayer()][up_index]
-                ->low_adj.push_back(via_index);
+                .low_adj.push_back(via_index);
           }
         } else if (upper_index.size() > 2) {
           std::string log_error = fmt::format(
@@ -991,7 +1071,7 @@ void AntennaChecker::buildLayerMaps(odb::dbNet* db_net,
         if (lower_index.size() == 1) {
           // connect via -> lower
           for (int& low_index : lower_index) {
-            node_by_layer_map[layer_it.first][via_index]->low_adj.push_back(
+            node_by_layer_map[layer_it.first][via_index].low_adj.push_back(
                 low_index);
           }
         } else if (lower_index.size() > 2) {
@@ -1007,7 +1087,49 @@ void AntennaChecker::buildLayerMaps(odb::dbNet* db_net,
       }
     }
   }
-  saveGates(db_net, node_by_layer_map, node_count);
+  saveGates(db_net, node_by_layer_map, index_by_layer_map, node_count);
+}
+
+GateToLayerToNodeInfo AntennaChecker::computeGateInfo(odb::dbNet* db_net)
+{
+  LayerToGraphNodes node_by_layer_map;
+  GateToLayerToNodeInfo gate_info;
+  buildLayerMaps(db_net, node_by_layer_map);
+
+  calculateAreas(node_by_layer_map, gate_info);
+
+  calculatePAR(gate_info);
+  calculateCAR(gate_info);
+  return gate_info;
+}
+
+std::shared_ptr<const GateToLayerToNodeInfo> AntennaChecker::getGateInfo(
+    odb::dbNet* db_net)
+{
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    auto it = gate_info_cache_.find(db_net);
+    if (it != gate_info_cache_.end()) {
+      return it->second;
+    }
+  }
+  auto gate_info
+      = std::make_shared<const GateToLayerToNodeInfo>(computeGateInfo(db_net));
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  gate_info_cache_[db_net] = gate_info;
+  return gate_info;
+}
+
+void AntennaChecker::invalidateNet(odb::dbNet* db_net)
+{
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  gate_info_cache_.erase(db_net);
+}
+
+void AntennaChecker::clearCache()
+{
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  gate_info_cache_.clear();
 }
 
 void AntennaChecker::checkNet(odb::dbNet* db_net,
@@ -1022,14 +1144,8 @@ void AntennaChecker::checkNet(odb::dbNet* db_net,
 {
   odb::dbWire* wire = db_net->getWire();
   if (wire) {
-    LayerToGraphNodes node_by_layer_map;
-    GateToLayerToNodeInfo gate_info;
-    buildLayerMaps(db_net, node_by_layer_map);
-
-    calculateAreas(node_by_layer_map, gate_info);
-
-    calculatePAR(gate_info);
-    calculateCAR(gate_info);
+    std::shared_ptr<const GateToLayerToNodeInfo> gate_info
+        = getGateInfo(db_net);
 
     int pin_violations = checkGates(db_net,
                                     verbose,
@@ -1037,7 +1153,7 @@ void AntennaChecker::checkNet(odb::dbNet* db_net,
                                     report_file,
                                     diode_mterm,
                                     ratio_margin,
-                                    gate_info,
+                                    *gate_info,
                                     antenna_violations);
 
     if (pin_violations > 0) {
@@ -1124,10 +1240,30 @@ int AntennaChecker::checkAntennas(odb::dbNet* net,
         nets_.push_back(net);
       }
     }
+    // Only the nets changed since the last check need their wire graph
+    // analyzed again.  Reporting is done in net order afterwards.
+    std::vector<odb::dbNet*> dirty_nets;
+    {
+      std::lock_guard<std::mutex> lock(cache_mutex_);
+      for (odb::dbNet* net : nets_) {
+        if (net->getWire() && gate_info_cache_.count(net) == 0) {
+          dirty_nets.push_back(net);
+        }
+      }
+    }
+    debugPrint(logger_,
+               ANT,
+               "check",
+               1,
+               "analyzing {} of {} nets",
+               dirty_nets.size(),
+               nets_.size());
     omp_set_num_threads(num_threads);
 #pragma omp parallel for schedule(dynamic)
-    for (int i = 0; i < nets_.size(); i++) {
-      odb::dbNet* net = nets_[i];
+    for (int i = 0; i < dirty_nets.size(); i++) {
+      getGateInfo(dirty_nets[i]);
+    }
+    for (odb::dbNet* net : nets_) {
       Violations antenna_violations;
       checkNet(net,
                verbose,
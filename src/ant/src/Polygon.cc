@@ -31,7 +31,10 @@
 
 #include "Polygon.hh"
 
+#include <algorithm>
+
 #include "odb/dbShape.h"
+#include "odb/dbWireShapeCache.h"
 
 namespace ant {
 
@@ -46,55 +49,83 @@ Polygon rectToPolygon(const odb::Rect& rect)
   return pol;
 }
 
+NodeIndex::NodeIndex(const GraphNodes& graph_nodes)
+{
+  std::vector<std::pair<BBox, int>> boxes;
+  boxes.reserve(graph_nodes.size());
+  for (int i = 0; i < graph_nodes.size(); i++) {
+    gtl::rectangle_data<int> rect;
+    gtl::extents(rect, graph_nodes[i].pol);
+    boxes.emplace_back(BBox(BPoint(gtl::xl(rect), gtl::yl(rect)),
+                            BPoint(gtl::xh(rect), gtl::yh(rect))),
+                       i);
+  }
+  // packing construction
+  rtree_ = RTree(boxes.begin(), boxes.end());
+}
+
+void NodeIndex::query(const gtl::rectangle_data<int>& rect,
+                      std::vector<int>& ids) const
+{
+  const BBox box(BPoint(gtl::xl(rect), gtl::yl(rect)),
+                 BPoint(gtl::xh(rect), gtl::yh(rect)));
+  for (auto it = rtree_.qbegin(boost::geometry::index::intersects(box));
+       it != rtree_.qend();
+       ++it) {
+    ids.push_back(it->second);
+  }
+}
+
 // used to find the indeces of the elements which intersect with the element pol
-std::vector<int> findNodesWithIntersection(const GraphNodes& graph_nodes,
-                                           const Polygon& pol)
+void findNodesWithIntersection(const GraphNodes& graph_nodes,
+                               const NodeIndex& index,
+                               const Polygon& pol,
+                               std::vector<int>& ids)
 {
+  ids.clear();
+  if (graph_nodes.empty()) {
+    return;
+  }
   // expand object by 1
   PolygonSet obj;
   obj += pol;
   obj += 1;
   Polygon& scaled_pol = obj[0];
-  int index = 0;
-  std::vector<int> ids;
-  for (const auto& node : graph_nodes) {
-    if (gtl::area(node->pol & scaled_pol) > 0) {
-      ids.push_back(index);
-    }
-    index++;
-  }
-  return ids;
+
+  gtl::rectangle_data<int> bbox;
+  gtl::extents(bbox, scaled_pol);
+  index.query(bbox, ids);
+  // keep the nodes that really overlap, in index order
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::remove_if(ids.begin(),
+                           ids.end(),
+                           [&](int id) {
+                             return gtl::area(graph_nodes[id].pol & scaled_pol)
+                                    <= 0;
+                           }),
+            ids.end());
 }
 
 void wiresToPolygonSetMap(
-    odb::dbWire* wires,
+    odb::dbNet* db_net,
     std::unordered_map<odb::dbTechLayer*, PolygonSet>& set_by_layer)
 {
-  odb::dbShape shape;
-  odb::dbWireShapeItr shapes_it;
+  odb::dbWireShapeCache* cache = db_net->getBlock()->getWireShapeCache();
   std::vector<odb::dbShape> via_boxes;
 
   // Add information on polygon sets
-  for (shapes_it.begin(wires); shapes_it.next(shape);) {
-    odb::dbTechLayer* layer;
-
-    // Get rect of the wire
-    odb::Rect wire_rect = shape.getBox();
+  for (const odb::dbShape& shape : cache->getSegments(db_net)) {
+    // polygon set is used to join polygon on same layer with intersection
+    Polygon wire_pol = rectToPolygon(shape.getBox());
+    set_by_layer[shape.getTechLayer()] += wire_pol;
+  }
 
-    if (shape.isVia()) {
-      // Get three polygon upper_cut - via - lower_cut
-      odb::dbShape::getViaBoxes(shape, via_boxes);
-      for (const odb::dbShape& box : via_boxes) {
-        layer = box.getTechLayer();
-        odb::Rect via_rect = box.getBox();
-        Polygon via_pol = rectToPolygon(via_rect);
-        set_by_layer[layer] += via_pol;
-      }
-    } else {
-      layer = shape.getTechLayer();
-      // polygon set is used to join polygon on same layer with intersection
-      Polygon wire_pol = rectToPolygon(wire_rect);
-      set_by_layer[layer] += wire_pol;
+  for (const odb::dbShape& shape : cache->getVias(db_net)) {
+    // Get three polygon upper_cut - via - lower_cut
+    odb::dbShape::getViaBoxes(shape, via_boxes);
+    for (const odb::dbShape& box : via_boxes) {
+      Polygon via_pol = rectToPolygon(box.getBox());
+      set_by_layer[box.getTechLayer()] += via_pol;
     }
   }
 }
@@ -32,6 +32,8 @@
 #pragma once
 
 #include <boost/functional/hash.hpp>
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
 #include <boost/polygon/polygon.hpp>
 
 #include "PinType.hh"
@@ -62,11 +64,38 @@ struct GraphNode
   }
 };
 
+// Bounding box index over the polygons of one layer of a net so that
+// finding the nodes touching a shape doesn't scan every node of the layer.
+class NodeIndex
+{
+ public:
+  NodeIndex() = default;
+  explicit NodeIndex(const GraphNodes& graph_nodes);
+
+  // Appends the indices of the nodes whose bounding box touches rect.
+  void query(const gtl::rectangle_data<int>& rect,
+             std::vector<int>& ids) const;
+
+ private:
+  using BPoint = boost::geometry::model::
+      point<int, 2, boost::geometry::cs::cartesian>;
+  using BBox = boost::geometry::model::box<BPoint>;
+  using RTree
+      = boost::geometry::index::rtree<std::pair<BBox, int>,
+                                      boost::geometry::index::quadratic<16>>;
+
+  RTree rtree_;
+};
+
 Polygon rectToPolygon(const odb::Rect& rect);
-std::vector<int> findNodesWithIntersection(const GraphNodes& graph_nodes,
-                                           const Polygon& pol);
+// Fills ids with the indices (ascending) of the nodes that overlap pol
+// expanded by 1.
+void findNodesWithIntersection(const GraphNodes& graph_nodes,
+                               const NodeIndex& index,
+                               const Polygon& pol,
+                               std::vector<int>& ids);
 void wiresToPolygonSetMap(
-    odb::dbWire* wires,
+    odb::dbNet* db_net,
     std::unordered_map<odb::dbTechLayer*, PolygonSet>& set_by_layer);
 void avoidPinIntersection(
     odb::dbNet* db_net,
@@ -36,11 +36,13 @@
 #include "db_sta/dbReadVerilog.hh"
 
 #include <map>
+#include <memory>
 #include <string>
 
 #include "db_sta/dbNetwork.hh"
 #include "db_sta/dbSta.hh"
 #include "odb/db.h"
+#include "odb/dbNetlistBuilder.h"
 #include "ord/OpenRoad.hh"
 #include "sta/ConcreteNetwork.hh"
 #include "sta/NetworkCmp.hh"
@@ -66,6 +68,7 @@ using odb::dbModNet;
 using odb::dbModule;
 using odb::dbMTerm;
 using odb::dbNet;
+using odb::dbNetlistBuilder;
 using odb::dbTech;
 using utl::ORD;
 
@@ -189,6 +192,9 @@ class Verilog2db
   // for each instance
   std::map<std::string, int> src_file_id_;
   bool hierarchy_ = false;
+  // Makes the instances, nets and their connections while the flat
+  // netlist is built.
+  std::unique_ptr<dbNetlistBuilder> netlist_builder_;
 };
 
 void dbLinkDesign(const char* top_cell_name,
@@ -256,8 +262,14 @@ void Verilog2db::makeDbNetlist()
 {
   std::vector<std::pair<const Instance*, dbModule*>> inst_module_vec;
   recordBusPortsOrder();
+  netlist_builder_ = std::make_unique<dbNetlistBuilder>(block_);
+  netlist_builder_->reserve(network_->instanceCount(),
+                            network_->netCount(),
+                            network_->pinCount());
   makeDbModule(network_->topInstance(), /* parent */ nullptr, inst_module_vec);
   makeDbNets(network_->topInstance());
+  netlist_builder_->commit();
+  netlist_builder_.reset();
   if (hierarchy_) {
     makeVModNets(inst_module_vec);
   }
@@ -442,7 +454,8 @@ void Verilog2db::makeDbModule(
                       network_->name(cell));
         continue;
       }
-      auto db_inst = dbInst::create(block_, master, child_name, false, module);
+      auto db_inst = netlist_builder_->createInst(
+          master, child_name, /* region */ nullptr, module);
 
       // Yosys writes a src attribute on sequential instances to give the
       // Verilog source info.
@@ -585,7 +598,7 @@ void Verilog2db::makeDbNets(const Instance* inst)
     Net* net = net_iter->next();
     const char* net_name = network_->pathName(net);
     if (is_top || !hasTerminals(net)) {
-      dbNet* db_net = dbNet::create(block_, net_name);
+      dbNet* db_net = netlist_builder_->createNet(net_name);
 
       if (network_->isPower(net)) {
         db_net->setSigType(odb::dbSigType::POWER);
@@ -621,7 +634,7 @@ void Verilog2db::makeDbNets(const Instance* inst)
             dbMaster* master = db_inst->getMaster();
             dbMTerm* mterm = master->findMTerm(block_, port_name);
             if (mterm) {
-              db_inst->getITerm(mterm)->connect(db_net);
+              netlist_builder_->connect(db_inst->getITerm(mterm), db_net);
             }
           }
         }
@@ -32,7 +32,10 @@
 
 #include "ScanArchitectHeuristic.hh"
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <numeric>
 #include <sstream>
 
 #include "ClockDomain.hh"
@@ -40,6 +43,125 @@
 
 namespace dft {
 
+namespace {
+
+// Resolution of the grid the Hilbert curve is laid over
+constexpr int kHilbertOrder = 16;
+// How far apart (in positions of the chain) two cells can be to be
+// considered for a 2-opt move. Keeps the ordering linear in the chain size.
+constexpr int kTwoOptWindow = 32;
+constexpr int kTwoOptMaxPasses = 8;
+
+// Distance along a Hilbert curve of order kHilbertOrder to the point (x, y)
+uint64_t HilbertIndex(uint32_t x, uint32_t y)
+{
+  const uint32_t n = 1u << kHilbertOrder;
+  uint64_t index = 0;
+  for (uint32_t s = n / 2; s > 0; s /= 2) {
+    const uint32_t rx = (x & s) ? 1 : 0;
+    const uint32_t ry = (y & s) ? 1 : 0;
+    index += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+    // Rotate the quadrant so the curve stays continuous
+    if (ry == 0) {
+      if (rx == 1) {
+        x = n - 1 - x;
+        y = n - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return index;
+}
+
+// Sorts the scan cells along a Hilbert curve laid over their bounding box.
+// Consecutive cells in the result are close to each other on the die, so
+// cutting the result in consecutive pieces gives spatially clustered chains.
+void SortAlongHilbertCurve(std::vector<std::unique_ptr<ScanCell>>& scan_cells)
+{
+  if (scan_cells.size() < 2) {
+    return;
+  }
+
+  odb::Rect bbox;
+  bbox.mergeInit();
+  std::vector<odb::Point> origins;
+  origins.reserve(scan_cells.size());
+  for (const auto& scan_cell : scan_cells) {
+    origins.push_back(scan_cell->getOrigin());
+    bbox.merge(odb::Rect(origins.back(), origins.back()));
+  }
+
+  const int64_t grid_max = (1 << kHilbertOrder) - 1;
+  const int64_t extent = std::max({bbox.dx(), bbox.dy(), 1});
+  std::vector<uint64_t> keys;
+  keys.reserve(origins.size());
+  for (const odb::Point& origin : origins) {
+    const int64_t x = (origin.x() - bbox.xMin()) * grid_max / extent;
+    const int64_t y = (origin.y() - bbox.yMin()) * grid_max / extent;
+    keys.push_back(HilbertIndex(x, y));
+  }
+
+  std::vector<size_t> order(scan_cells.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&keys](size_t a, size_t b) {
+    return keys[a] < keys[b];
+  });
+
+  std::vector<std::unique_ptr<ScanCell>> sorted;
+  sorted.reserve(scan_cells.size());
+  for (size_t index : order) {
+    sorted.push_back(std::move(scan_cells[index]));
+  }
+  scan_cells = std::move(sorted);
+}
+
+// Shortens the open path through the scan cells with 2-opt moves: a piece
+// of the path is reversed whenever that reduces the manhattan length.
+void ImproveWithTwoOpt(std::vector<std::unique_ptr<ScanCell>>& scan_cells)
+{
+  const int size = scan_cells.size();
+  if (size < 3) {
+    return;
+  }
+
+  std::vector<odb::Point> origins;
+  origins.reserve(size);
+  for (const auto& scan_cell : scan_cells) {
+    origins.push_back(scan_cell->getOrigin());
+  }
+  auto distance = [&origins](int a, int b) {
+    return odb::Point::manhattanDistance(origins[a], origins[b]);
+  };
+
+  for (int pass = 0; pass < kTwoOptMaxPasses; ++pass) {
+    bool improved = false;
+    for (int i = 0; i < size - 1; ++i) {
+      const int last = std::min(size - 1, i + kTwoOptWindow);
+      for (int j = i + 1; j <= last; ++j) {
+        // Reversing [i, j] replaces the edges (i-1, i) and (j, j+1) by
+        // (i-1, j) and (i, j+1). The ends of the path have no outer edge.
+        int64_t delta = 0;
+        if (i > 0) {
+          delta += distance(i - 1, j) - distance(i - 1, i);
+        }
+        if (j < size - 1) {
+          delta += distance(i, j + 1) - distance(j, j + 1);
+        }
+        if (delta < 0) {
+          std::reverse(origins.begin() + i, origins.begin() + j + 1);
+          std::reverse(scan_cells.begin() + i, scan_cells.begin() + j + 1);
+          improved = true;
+        }
+      }
+    }
+    if (!improved) {
+      break;
+    }
+  }
+}
+
+}  // namespace
+
 ScanArchitectHeuristic::ScanArchitectHeuristic(
     const ScanArchitectConfig& config,
     std::unique_ptr<ScanCellsBucket> scan_cells_bucket)
@@ -51,21 +173,62 @@ void ScanArchitectHeuristic::architect()
 {
   // For each hash_domain, lets distribute the scan cells over the scan chains
   for (auto& [hash_domain, scan_chains] : hash_domain_scan_chains_) {
+    std::vector<std::unique_ptr<ScanCell>> scan_cells;
+    scan_cells.reserve(scan_cells_bucket_->numberOfCells(hash_domain));
+    while (scan_cells_bucket_->numberOfCells(hash_domain)) {
+      scan_cells.push_back(scan_cells_bucket_->pop(hash_domain));
+    }
+
+    // When the design is placed we cluster the cells by location so every
+    // chain covers a compact region and then order each chain to reduce the
+    // wirelength of the stitching. Otherwise we keep the bucket order.
+    const bool placed
+        = std::all_of(scan_cells.begin(),
+                      scan_cells.end(),
+                      [](const std::unique_ptr<ScanCell>& scan_cell) {
+                        return scan_cell->isPlaced();
+                      });
+    if (placed) {
+      SortAlongHilbertCurve(scan_cells);
+    }
+
+    // Cut the sequence in pieces of the same number of bits. The last chain
+    // takes whatever is left so no cell is dropped.
+    uint64_t total_bits = 0;
+    for (const auto& scan_cell : scan_cells) {
+      total_bits += scan_cell->getBits();
+    }
+    const uint64_t num_chains = std::max<uint64_t>(scan_chains.size(), 1);
+    const uint64_t piece_bits = (total_bits + num_chains - 1) / num_chains;
+
+    auto next_scan_cell = scan_cells.begin();
     for (auto& current_chain : scan_chains) {
-      const uint64_t max_length
-          = hash_domain_to_limits_.find(hash_domain)->second.max_length;
-      while (current_chain->getBits() < max_length
-             && scan_cells_bucket_->numberOfCells(hash_domain)) {
-        std::unique_ptr<ScanCell> scan_cell
-            = scan_cells_bucket_->pop(hash_domain);
-        current_chain->add(std::move(scan_cell));
+      const bool last_chain = &current_chain == &scan_chains.back();
+      while ((last_chain || current_chain->getBits() < piece_bits)
+             && next_scan_cell != scan_cells.end()) {
+        current_chain->add(std::move(*next_scan_cell));
+        ++next_scan_cell;
       }
 
-      // TODO: Perform an actual sorting to reduce the wire length
       current_chain->sortScanCells(
-          [](std::vector<std::unique_ptr<ScanCell>>& falling,
-             std::vector<std::unique_ptr<ScanCell>>& rising,
-             std::vector<std::unique_ptr<ScanCell>>& sorted) {
+          [placed](std::vector<std::unique_ptr<ScanCell>>& falling,
+                   std::vector<std::unique_ptr<ScanCell>>& rising,
+                   std::vector<std::unique_ptr<ScanCell>>& sorted) {
+            if (placed) {
+              ImproveWithTwoOpt(falling);
+              ImproveWithTwoOpt(rising);
+              // Enter the rising edge cells from the end closest to the last
+              // falling edge cell
+              if (!falling.empty() && rising.size() > 1) {
+                const odb::Point last = falling.back()->getOrigin();
+                if (odb::Point::manhattanDistance(last,
+                                                  rising.back()->getOrigin())
+                    < odb::Point::manhattanDistance(
+                        last, rising.front()->getOrigin())) {
+                  std::reverse(rising.begin(), rising.end());
+                }
+              }
+            }
             sorted.reserve(falling.size() + rising.size());
             // Falling edge first
             std::move(
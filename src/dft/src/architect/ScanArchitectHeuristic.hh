@@ -38,6 +38,11 @@ namespace dft {
 // An heuristic algorithm to solve the bin packing problem for the creation of
 // scan chains. The idea is to sort the scan cells from the biggest (bits) to
 // the smallest and start adding the biggest cells to each scan chain.
+//
+// If all the scan cells are placed, they are instead sorted along a
+// space-filling curve and cut into consecutive pieces so each chain covers a
+// compact region of the die. Each chain is then ordered with 2-opt to reduce
+// the wirelength of the stitching.
 class ScanArchitectHeuristic : public ScanArchitect
 {
  public:
@@ -82,6 +82,17 @@ ScanDriver OneBitScanCell::getScanOut() const
   return ScanDriver(findITerm(test_cell_->scanOut()));
 }
 
+bool OneBitScanCell::isPlaced() const
+{
+  return inst_->isPlaced();
+}
+
+odb::Point OneBitScanCell::getOrigin() const
+{
+  const odb::Rect bbox = inst_->getBBox()->getBox();
+  return odb::Point(bbox.xCenter(), bbox.yCenter());
+}
+
 odb::dbITerm* OneBitScanCell::findITerm(sta::LibertyPort* liberty_port) const
 {
   odb::dbMTerm* mterm = db_network_->staToDb(liberty_port);
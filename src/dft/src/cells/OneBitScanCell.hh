@@ -58,6 +58,8 @@ class OneBitScanCell : public ScanCell
   void connectScanIn(const ScanDriver& driver) const override;
   void connectScanOut(const ScanLoad& load) const override;
   ScanDriver getScanOut() const override;
+  bool isPlaced() const override;
+  odb::Point getOrigin() const override;
 
  private:
   odb::dbITerm* findITerm(sta::LibertyPort* liberty_port) const;
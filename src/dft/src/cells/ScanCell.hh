@@ -66,6 +66,11 @@ class ScanCell
   virtual void connectScanOut(const ScanLoad& load) const = 0;
   virtual ScanDriver getScanOut() const = 0;
 
+  // Placement of the cell, used to order the chains to reduce wirelength.
+  // getOrigin is only meaningful when isPlaced returns true.
+  virtual bool isPlaced() const = 0;
+  virtual odb::Point getOrigin() const = 0;
+
   const ClockDomain& getClockDomain() const;
   std::string_view getName() const;
 
@@ -12,6 +12,14 @@ ScanCellMock::ScanCellMock(const std::string& name,
 {
 }
 
+ScanCellMock::ScanCellMock(const std::string& name,
+                           std::unique_ptr<ClockDomain> clock_domain,
+                           const odb::Point& origin,
+                           utl::Logger* logger)
+    : ScanCell(name, std::move(clock_domain), logger), origin_(origin)
+{
+}
+
 uint64_t ScanCellMock::getBits() const
 {
   return 1;
@@ -34,5 +42,15 @@ ScanDriver ScanCellMock::getScanOut() const
   return ScanDriver(static_cast<odb::dbBTerm*>(nullptr));
 }
 
+bool ScanCellMock::isPlaced() const
+{
+  return origin_.has_value();
+}
+
+odb::Point ScanCellMock::getOrigin() const
+{
+  return origin_.value_or(odb::Point());
+}
+
 }  // namespace test
 }  // namespace dft
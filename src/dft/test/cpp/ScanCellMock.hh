@@ -1,6 +1,9 @@
-#include "ScanCell.hh"
 #pragma once
 
+#include <optional>
+
+#include "ScanCell.hh"
+
 namespace dft {
 namespace test {
 
@@ -10,6 +13,11 @@ class ScanCellMock : public ScanCell
   ScanCellMock(const std::string& name,
                std::unique_ptr<ClockDomain> clock_domain,
                utl::Logger* logger);
+  // A placed mock cell at the given location
+  ScanCellMock(const std::string& name,
+               std::unique_ptr<ClockDomain> clock_domain,
+               const odb::Point& origin,
+               utl::Logger* logger);
   ~ScanCellMock() override = default;
 
   uint64_t getBits() const override;
@@ -17,6 +25,11 @@ class ScanCellMock : public ScanCell
   void connectScanIn(const ScanDriver& pin) const override;
   void connectScanOut(const ScanLoad& pin) const override;
   ScanDriver getScanOut() const override;
+  bool isPlaced() const override;
+  odb::Point getOrigin() const override;
+
+ private:
+  std::optional<odb::Point> origin_;
 };
 
 }  // namespace test
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <random>
 #include <sstream>
 #include <unordered_set>
 
@@ -184,5 +186,104 @@ TEST(TestScanArchitectHeuristic, ArchitectWithTwoEdgesNoMix)
   EXPECT_EQ(total_bits_falling, 15);
 }
 
+TEST(TestScanArchitectHeuristic, ArchitectPlacedCellsByLocation)
+{
+  utl::Logger* logger = new utl::Logger();
+
+  ScanArchitectConfig config;
+  config.setClockMixing(ScanArchitectConfig::ClockMixing::NoMix);
+  config.setMaxLength(10);
+  std::vector<std::unique_ptr<ScanCell>> scan_cells;
+
+  // Two clusters of 10 cells far apart from each other, shuffled
+  std::vector<odb::Point> origins;
+  for (int i = 0; i < 10; ++i) {
+    origins.emplace_back(i * 100, (i % 2) * 100);
+    origins.emplace_back(100000 + i * 100, 100000 + (i % 2) * 100);
+  }
+  std::mt19937 rng(1);
+  std::shuffle(origins.begin(), origins.end(), rng);
+
+  for (uint64_t i = 0; i < origins.size(); ++i) {
+    std::stringstream ss;
+    ss << "scan_cell" << i;
+    scan_cells.push_back(std::make_unique<ScanCellMock>(
+        ss.str(),
+        std::make_unique<ClockDomain>("clk1", ClockEdge::Rising),
+        origins[i],
+        logger));
+  }
+
+  std::unique_ptr<ScanCellsBucket> scan_cells_bucket
+      = std::make_unique<ScanCellsBucket>(logger);
+  scan_cells_bucket->init(config, scan_cells);
+
+  std::unique_ptr<ScanArchitect> scan_architect
+      = ScanArchitect::ConstructScanScanArchitect(config,
+                                                  std::move(scan_cells_bucket));
+  scan_architect->init();
+  scan_architect->architect();
+  std::vector<std::unique_ptr<ScanChain>> scan_chains
+      = scan_architect->getScanChains();
+
+  EXPECT_EQ(scan_chains.size(), 2);
+
+  for (const auto& scan_chain : scan_chains) {
+    const auto& chain_cells = scan_chain->getScanCells();
+    EXPECT_EQ(chain_cells.size(), 10);
+
+    // Each chain should cover only one of the clusters and visit its cells
+    // without going back and forth: 9 steps of 100 in x plus at most one
+    // step of 100 in y per step.
+    int64_t length = 0;
+    for (size_t i = 1; i < chain_cells.size(); ++i) {
+      length += odb::Point::manhattanDistance(chain_cells[i - 1]->getOrigin(),
+                                              chain_cells[i]->getOrigin());
+    }
+    EXPECT_LE(length, 9 * 200);
+  }
+}
+
+TEST(TestScanArchitectHeuristic, ArchitectPlacedCellsBalanced)
+{
+  utl::Logger* logger = new utl::Logger();
+
+  ScanArchitectConfig config;
+  config.setClockMixing(ScanArchitectConfig::ClockMixing::NoMix);
+  config.setMaxLength(10);
+  std::vector<std::unique_ptr<ScanCell>> scan_cells;
+
+  // 25 cells on a line: 3 chains cut in pieces of ceil(25 / 3) = 9 bits
+  for (uint64_t i = 0; i < 25; ++i) {
+    std::stringstream ss;
+    ss << "scan_cell" << i;
+    scan_cells.push_back(std::make_unique<ScanCellMock>(
+        ss.str(),
+        std::make_unique<ClockDomain>("clk1", ClockEdge::Rising),
+        odb::Point(i * 100, 0),
+        logger));
+  }
+
+  std::unique_ptr<ScanCellsBucket> scan_cells_bucket
+      = std::make_unique<ScanCellsBucket>(logger);
+  scan_cells_bucket->init(config, scan_cells);
+
+  std::unique_ptr<ScanArchitect> scan_architect
+      = ScanArchitect::ConstructScanScanArchitect(config,
+                                                  std::move(scan_cells_bucket));
+  scan_architect->init();
+  scan_architect->architect();
+  std::vector<std::unique_ptr<ScanChain>> scan_chains
+      = scan_architect->getScanChains();
+
+  ASSERT_EQ(scan_chains.size(), 3);
+  std::vector<uint64_t> bits;
+  for (const auto& scan_chain : scan_chains) {
+    bits.push_back(scan_chain->getBits());
+  }
+  std::sort(bits.begin(), bits.end());
+  EXPECT_EQ(bits, (std::vector<uint64_t>{7, 9, 9}));
+}
+
 }  // namespace
 }  // namespace dft::test
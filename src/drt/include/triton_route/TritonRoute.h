@@ -99,6 +99,8 @@ struct ParamStruct
   int minAccessPoints = -1;
   bool saveGuideUpdates = false;
   std::string repairPDNLayerName;
+  bool adaptiveSchedule = false;
+  std::string checkpointFile;
 };
 
 class TritonRoute
@@ -1330,6 +1330,8 @@ void TritonRoute::setParams(const ParamStruct& params)
   }
   SAVE_GUIDE_UPDATES = params.saveGuideUpdates;
   REPAIR_PDN_LAYER_NAME = params.repairPDNLayerName;
+  ADAPTIVE_DR_SCHEDULE = params.adaptiveSchedule;
+  DR_CHECKPOINT_FILE = params.checkpointFile;
 }
 
 void TritonRoute::addWorkerResults(
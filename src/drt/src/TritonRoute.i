@@ -95,7 +95,9 @@ void detailed_route_cmd(const char* outputMazeFile,
                         int minAccessPoints,
                         bool saveGuideUpdates,
                         const char* repairPDNLayerName,
-                        int drcReportIterStep)
+                        int drcReportIterStep,
+                        bool adaptiveSchedule,
+                        const char* checkpointFile)
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
   std::optional<int> drcReportIterStepOpt;
@@ -122,7 +124,9 @@ void detailed_route_cmd(const char* outputMazeFile,
                     singleStepDR,
                     minAccessPoints,
                     saveGuideUpdates,
-                    repairPDNLayerName});
+                    repairPDNLayerName,
+                    adaptiveSchedule,
+                    checkpointFile});
   router->main();
   router->setDistributed(false);
 }
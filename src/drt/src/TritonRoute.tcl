@@ -60,6 +60,8 @@ sta::define_cmd_args "detailed_route" {
     [-save_guide_updates]
     [-repair_pdn_vias layer]
     [-single_step_dr]
+    [-adaptive_schedule]
+    [-checkpoint_file filename]
 }
 
 proc detailed_route { args } {
@@ -68,9 +70,10 @@ proc detailed_route { args } {
       -db_process_node -droute_end_iter -via_in_pin_bottom_layer \
       -via_in_pin_top_layer -or_seed -or_k -bottom_routing_layer \
       -top_routing_layer -verbose -remote_host -remote_port -shared_volume \
-      -cloud_size -min_access_points -repair_pdn_vias -drc_report_iter_step} \
+      -cloud_size -min_access_points -repair_pdn_vias -drc_report_iter_step \
+      -checkpoint_file} \
     flags {-disable_via_gen -distributed -clean_patches -no_pin_access \
-           -single_step_dr -save_guide_updates}
+           -single_step_dr -save_guide_updates -adaptive_schedule}
   sta::check_argc_eq0 "detailed_route" $args
 
   set enable_via_gen [expr ![info exists flags(-disable_via_gen)]]
@@ -80,12 +83,21 @@ proc detailed_route { args } {
   # development.  It is not listed in the help string intentionally.
   set single_step_dr [expr [info exists flags(-single_step_dr)]]
   set save_guide_updates [expr [info exists flags(-save_guide_updates)]]
+  set adaptive_schedule [expr [info exists flags(-adaptive_schedule)]]
 
   if { [info exists keys(-repair_pdn_vias)] } {
     set repair_pdn_vias $keys(-repair_pdn_vias)
   } else {
     set repair_pdn_vias ""
   }
+  # Writing a checkpoint rebuilds the region query so that a resumed run
+  # matches the run that wrote it; the results can therefore differ from a
+  # run without -checkpoint_file.  The file is removed when routing ends.
+  if { [info exists keys(-checkpoint_file)] } {
+    set checkpoint_file $keys(-checkpoint_file)
+  } else {
+    set checkpoint_file ""
+  }
   if { [info exists keys(-output_maze)] } {
     set output_maze $keys(-output_maze)
   } else {
@@ -197,7 +209,8 @@ proc detailed_route { args } {
     $via_in_pin_bottom_layer $via_in_pin_top_layer \
     $or_seed $or_k $bottom_routing_layer $top_routing_layer $verbose \
     $clean_patches $no_pin_access $single_step_dr $min_access_points \
-    $save_guide_updates $repair_pdn_vias $drc_report_iter_step
+    $save_guide_updates $repair_pdn_vias $drc_report_iter_step \
+    $adaptive_schedule $checkpoint_file
 }
 
 proc detailed_route_num_drvs { args } {
@@ -35,10 +35,13 @@
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/io/ios_state.hpp>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <numeric>
+#include <set>
 #include <sstream>
 
 #include "db/infra/frTime.h"
@@ -46,6 +49,7 @@
 #include "distributed/frArchive.h"
 #include "dr/FlexDR_conn.h"
 #include "dr/FlexDR_graphics.h"
+#include "dr/FlexDR_schedule.h"
 #include "dst/BalancerJobDescription.h"
 #include "dst/Distributed.h"
 #include "frProfileTask.h"
@@ -602,8 +606,7 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
   auto& xgp = gCellPatterns.at(0);
   auto& ygp = gCellPatterns.at(1);
   int cnt = 0;
-  int tot = (((int) xgp.getCount() - 1 - offset) / size + 1)
-            * (((int) ygp.getCount() - 1 - offset) / size + 1);
+  int tot = 0;
   int prev_perc = 0;
   bool isExceed = false;
 
@@ -618,8 +621,6 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
   int xIdx = 0, yIdx = 0;
   for (int i = offset; i < (int) xgp.getCount(); i += size) {
     for (int j = offset; j < (int) ygp.getCount(); j += size) {
-      auto worker
-          = std::make_unique<FlexDRWorker>(&via_data_, design_, logger_);
       Rect routeBox1 = getDesign()->getTopBlock()->getGCellBox(Point(i, j));
       const int max_i = std::min((int) xgp.getCount() - 1, i + size - 1);
       const int max_j = std::min((int) ygp.getCount(), j + size - 1);
@@ -633,6 +634,16 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
       Rect drcBox;
       routeBox.bloat(MTSAFEDIST, extBox);
       routeBox.bloat(DRCSAFEDIST, drcBox);
+      if (args.hotspotsOnly) {
+        std::vector<frMarker*> markers;
+        getRegionQuery()->queryMarker(drcBox, markers);
+        if (markers.empty()) {
+          yIdx++;
+          continue;
+        }
+      }
+      auto worker
+          = std::make_unique<FlexDRWorker>(&via_data_, design_, logger_);
       worker->setRouteBox(routeBox);
       worker->setExtBox(extBox);
       worker->setDrcBox(drcBox);
@@ -668,6 +679,7 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
             std::vector<std::unique_ptr<FlexDRWorker>>());
       }
       workers[batchIdx].back().push_back(std::move(worker));
+      tot++;
 
       yIdx++;
     }
@@ -736,21 +748,9 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
           }
           exception.rethrow();
           if (dist_on_) {
-            int j = 0;
-            std::vector<std::vector<std::pair<int, FlexDRWorker*>>>
-                distWorkerBatches(router_->getCloudSize());
-            for (int i = 0; i < workersInBatch.size(); i++) {
-              auto worker = workersInBatch.at(i).get();
-              if (!worker->isSkipRouting()) {
-                distWorkerBatches[j].push_back({i, worker});
-                j = (j + 1) % router_->getCloudSize();
-              }
-            }
             {
               ProfileTask task("DIST: SERIALIZE+SEND");
-#pragma omp parallel for schedule(dynamic)
-              for (int i = 0; i < distWorkerBatches.size(); i++)  // NOLINT
-                sendWorkers(distWorkerBatches.at(i), workersInBatch);
+              sendWorkers(workersInBatch);
             }
             logger_->report("    Received Batches:{}.", t);
             std::vector<std::pair<int, std::string>> workers;
@@ -1245,7 +1245,38 @@ int FlexDR::main()
       break;
     }
   }
-  for (auto& args : strategy()) {
+  const std::vector<SearchRepairArgs> fixedSchedule = strategy();
+  std::unique_ptr<FlexDRAdaptiveSchedule> adaptiveSchedule;
+  if (ADAPTIVE_DR_SCHEDULE) {
+    adaptiveSchedule = std::make_unique<FlexDRAdaptiveSchedule>(
+        std::vector<SearchRepairArgs>(fixedSchedule.begin(),
+                                      fixedSchedule.begin() + 3),
+        logger_);
+  }
+  auto searchRepairDone = [this] {
+    return getDesign()->getTopBlock()->getNumMarkers() == 0
+           || iter_ > END_ITERATION;
+  };
+  int step = 0;
+  bool done = false;
+  if (!DR_CHECKPOINT_FILE.empty()
+      && readCheckpoint(DR_CHECKPOINT_FILE, step, adaptiveSchedule.get())) {
+    done = searchRepairDone();
+  }
+  for (int i = step; !done; i++) {
+    SearchRepairArgs args;
+    if (adaptiveSchedule) {
+      auto next = adaptiveSchedule->next(i, numViols_);
+      if (!next) {
+        break;
+      }
+      args = *next;
+    } else {
+      if (i >= (int) fixedSchedule.size()) {
+        break;
+      }
+      args = fixedSchedule[i];
+    }
     int clipSize = args.size;
     if (args.ripupMode != RipUpMode::ALL) {
       if (increaseClipsize_) {
@@ -1262,13 +1293,11 @@ int FlexDR::main()
       }
     }
     searchRepair(args);
-    if (getDesign()->getTopBlock()->getNumMarkers() == 0) {
-      break;
+    done = searchRepairDone();
+    if (!done && !DR_CHECKPOINT_FILE.empty()) {
+      writeCheckpoint(DR_CHECKPOINT_FILE, i + 1, adaptiveSchedule.get());
     }
-    if (iter_ > END_ITERATION) {
-      break;
-    }
-    if (logger_->debugCheck(DRT, "snapshot", 1)) {
+    if (!done && logger_->debugCheck(DRT, "snapshot", 1)) {
       io::Writer writer(router_, logger_);
       writer.updateDb(db_, false, true);
       // insert the stack of vias for bterms above max layer again.
@@ -1279,6 +1308,10 @@ int FlexDR::main()
           fmt::format("drt_iter{}.odb", iter_ - 1).c_str());
     }
   }
+  if (!DR_CHECKPOINT_FILE.empty()) {
+    // The run is complete, a later run must not resume from it.
+    std::remove(DR_CHECKPOINT_FILE.c_str());
+  }
 
   end(/* done */ true);
   if (!GUIDE_REPORT_FILE.empty()) {
@@ -1291,27 +1324,122 @@ int FlexDR::main()
   return 0;
 }
 
-void FlexDR::sendWorkers(
-    const std::vector<std::pair<int, FlexDRWorker*>>& remote_batch,
-    std::vector<std::unique_ptr<FlexDRWorker>>& batch)
+void FlexDR::sendWorkers(std::vector<std::unique_ptr<FlexDRWorker>>& batch)
 {
-  if (remote_batch.empty()) {
+  struct RemoteJob
+  {
+    int idx;
+    std::string worker;
+    int attempts;
+  };
+  std::vector<RemoteJob> jobs;
+  for (int i = 0; i < batch.size(); i++) {
+    if (!batch[i]->isSkipRouting()) {
+      jobs.push_back({i, "", 0});
+    }
+  }
+  if (jobs.empty()) {
     return;
   }
-  std::vector<std::pair<int, std::string>> workers;
   {
     ProfileTask task("DIST: SERIALIZE_BATCH");
-    for (auto& [idx, worker] : remote_batch) {
-      std::string workerStr;
-      serializeWorker(worker, workerStr);
-      workers.emplace_back(idx, workerStr);
+#pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < jobs.size(); i++) {  // NOLINT
+      serializeWorker(batch[jobs[i].idx].get(), jobs[i].worker);
     }
   }
+  // The serialized size of a worker is used as the estimate of its routing
+  // cost. Expensive workers are sent first so they don't end up running
+  // alone at the end of the batch.
+  std::stable_sort(
+      jobs.begin(), jobs.end(), [](const RemoteJob& a, const RemoteJob& b) {
+        return a.worker.size() > b.worker.size();
+      });
+  uint64_t total_cost = 0;
+  for (const auto& job : jobs) {
+    total_cost += job.worker.size();
+  }
+
+  // Every remote slot pulls several workers per round trip from a shared
+  // queue until it is empty, so slots on faster hosts take over the work
+  // that would otherwise wait on slower ones. Workers whose results don't
+  // come back are put back in the queue for another slot.
+  const int cloud_size = std::max(1u, router_->getCloudSize());
+  const uint64_t chunk_cost = std::max<uint64_t>(
+      1, total_cost / (cloud_size * DIST_CHUNKS_PER_SLOT));
+  std::deque<RemoteJob> queue(std::make_move_iterator(jobs.begin()),
+                              std::make_move_iterator(jobs.end()));
+  std::mutex queue_mutex;
+  std::condition_variable queue_cv;
+  int in_flight = 0;
+  ThreadException exception;
+#pragma omp parallel for schedule(static, 1) num_threads(cloud_size)
+  for (int slot = 0; slot < cloud_size; slot++) {
+    try {
+      while (true) {
+        std::vector<RemoteJob> chunk;
+        uint64_t cost = 0;
+        {
+          std::unique_lock<std::mutex> lock(queue_mutex);
+          queue_cv.wait(lock, [&] { return !queue.empty() || in_flight == 0; });
+          if (queue.empty()) {
+            break;
+          }
+          while (!queue.empty() && (chunk.empty() || cost < chunk_cost)) {
+            cost += queue.front().worker.size();
+            chunk.push_back(std::move(queue.front()));
+            queue.pop_front();
+          }
+          in_flight++;
+        }
+        std::vector<std::pair<int, std::string>> workers;
+        workers.reserve(chunk.size());
+        for (const auto& job : chunk) {
+          workers.emplace_back(job.idx, job.worker);
+        }
+        std::set<int> received = sendWorkerChunk(workers, cost);
+        {
+          std::unique_lock<std::mutex> lock(queue_mutex);
+          for (auto& job : chunk) {
+            if (received.find(job.idx) != received.end()) {
+              continue;
+            }
+            if (++job.attempts > DIST_MAX_RETRIES) {
+              in_flight--;
+              queue_cv.notify_all();
+              logger_->error(utl::DRT,
+                             500,
+                             "Sending worker {} failed after {} attempts.",
+                             job.idx,
+                             job.attempts);
+            }
+            queue.push_back(std::move(job));
+          }
+          in_flight--;
+        }
+        queue_cv.notify_all();
+      }
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
+}
+
+std::set<int> FlexDR::sendWorkerChunk(
+    const std::vector<std::pair<int, std::string>>& workers,
+    uint64_t cost)
+{
+  std::set<int> received;
   std::string remote_ip = dist_ip_;
   uint16_t remote_port = dist_port_;
+  bool assigned = false;
   if (router_->getCloudSize() > 1) {
     dst::JobMessage msg(dst::JobMessage::BALANCER),
         result(dst::JobMessage::NONE);
+    auto request = std::make_unique<dst::BalancerJobDescription>();
+    request->setCost(cost);
+    msg.setJobDescription(std::move(request));
     bool ok = dist_->sendJob(msg, dist_ip_.c_str(), dist_port_, result);
     if (!ok) {
       logger_->error(utl::DRT, 7461, "Balancer failed");
@@ -1321,31 +1449,59 @@ void FlexDR::sendWorkers(
               result.getJobDescription());
       remote_ip = desc->getWorkerIP();
       remote_port = desc->getWorkerPort();
+      assigned = true;
     }
   }
-  {
-    dst::JobMessage msg(dst::JobMessage::ROUTING),
-        result(dst::JobMessage::NONE);
-    std::unique_ptr<dst::JobDescription> desc
-        = std::make_unique<RoutingJobDescription>();
-    RoutingJobDescription* rjd
-        = static_cast<RoutingJobDescription*>(desc.get());
-    rjd->setWorkers(workers);
-    rjd->setSharedDir(dist_dir_);
-    rjd->setSendEvery(20);
-    msg.setJobDescription(std::move(desc));
-    ProfileTask task("DIST: SENDJOB");
-    bool ok = dist_->sendJobMultiResult(
-        msg, remote_ip.c_str(), remote_port, result);
-    if (!ok) {
-      logger_->error(utl::DRT, 500, "Sending worker {} failed");
-    }
-    for (const auto& one_desc : result.getAllJobDescriptions()) {
-      RoutingJobDescription* result_desc
-          = static_cast<RoutingJobDescription*>(one_desc.get());
-      router_->addWorkerResults(result_desc->getWorkers());
+  dst::JobMessage msg(dst::JobMessage::ROUTING), result(dst::JobMessage::NONE);
+  std::unique_ptr<dst::JobDescription> desc
+      = std::make_unique<RoutingJobDescription>();
+  RoutingJobDescription* rjd = static_cast<RoutingJobDescription*>(desc.get());
+  rjd->setWorkers(workers);
+  rjd->setSharedDir(dist_dir_);
+  rjd->setSendEvery(20);
+  msg.setJobDescription(std::move(desc));
+  ProfileTask task("DIST: SENDJOB");
+  bool ok
+      = dist_->sendJobMultiResult(msg, remote_ip.c_str(), remote_port, result);
+  if (assigned) {
+    // The balancer charged the chunk to the worker; release it.
+    dst::JobMessage release(dst::JobMessage::BALANCER),
+        reply(dst::JobMessage::NONE);
+    auto report = std::make_unique<dst::BalancerJobDescription>();
+    report->setWorkerIP(remote_ip);
+    report->setWorkerPort(remote_port);
+    report->setCost(cost);
+    report->setAction(ok ? dst::BalancerJobDescription::RELEASE
+                         : dst::BalancerJobDescription::FAIL);
+    release.setJobDescription(std::move(report));
+    dist_->sendJob(release, dist_ip_.c_str(), dist_port_, reply);
+  }
+  if (!ok) {
+    logger_->warn(utl::DRT,
+                  501,
+                  "Sending {} workers to {}:{} failed, they will be retried.",
+                  workers.size(),
+                  remote_ip,
+                  remote_port);
+    return received;
+  }
+  std::set<int> sent;
+  for (const auto& [idx, worker] : workers) {
+    sent.insert(idx);
+  }
+  for (const auto& one_desc : result.getAllJobDescriptions()) {
+    RoutingJobDescription* result_desc
+        = static_cast<RoutingJobDescription*>(one_desc.get());
+    std::vector<std::pair<int, std::string>> results;
+    for (const auto& worker_result : result_desc->getWorkers()) {
+      if (sent.find(worker_result.first) != sent.end()
+          && received.insert(worker_result.first).second) {
+        results.push_back(worker_result);
+      }
     }
+    router_->addWorkerResults(results);
   }
+  return received;
 }
 
 template <class Archive>
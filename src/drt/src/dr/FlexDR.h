@@ -59,6 +59,7 @@ namespace drt {
 
 class frConstraint;
 struct SearchRepairArgs;
+class FlexDRAdaptiveSchedule;
 
 struct FlexDRViaData
 {
@@ -88,6 +89,8 @@ class FlexDR
     float workerMarkerDecay;
     RipUpMode ripupMode;
     bool followGuide;
+    // only route the clips that contain a marker
+    bool hotspotsOnly = false;
   };
 
   // constructors
@@ -103,6 +106,18 @@ class FlexDR
   // others
   void init();
   int main();
+  // Saves the routing, the markers and the search and repair state after an
+  // iteration; step is the schedule position of the next iteration.  The
+  // design and its region query are left untouched.
+  void writeCheckpoint(const std::string& file_name,
+                       int step,
+                       const FlexDRAdaptiveSchedule* schedule);
+  // Restores a checkpoint written for this design and routing options,
+  // returning false if there is none.  The routing and markers come back in
+  // the order they were saved and the region query is rebuilt from them.
+  bool readCheckpoint(const std::string& file_name,
+                      int& step,
+                      FlexDRAdaptiveSchedule* schedule);
   void searchRepair(const SearchRepairArgs& args);
   void end(bool done = false);
 
@@ -125,9 +140,9 @@ class FlexDR
     dist_port_ = remote_port;
     dist_dir_ = dir;
   }
-  void sendWorkers(
-      const std::vector<std::pair<int, FlexDRWorker*>>& remote_batch,
-      std::vector<std::unique_ptr<FlexDRWorker>>& batch);
+  // Routes the workers of a batch on the remote workers, retrying the
+  // ones whose results are lost on another remote worker.
+  void sendWorkers(std::vector<std::unique_ptr<FlexDRWorker>>& batch);
 
   void reportGuideCoverage();
   void setIter(int iterNum) { iter_ = iterNum; }
@@ -155,6 +170,10 @@ class FlexDR
   uint16_t dist_port_;
   std::string dist_dir_;
   std::string globals_path_;
+  // Number of chunks each remote slot's share of a batch is split into.
+  static constexpr int DIST_CHUNKS_PER_SLOT = 4;
+  // Times a remote worker is resent before giving up.
+  static constexpr int DIST_MAX_RETRIES = 3;
   bool increaseClipsize_;
   float clipSizeInc_;
   int iter_;
@@ -167,11 +186,17 @@ class FlexDR
   void init_halfViaEncArea();
 
   void removeGCell2BoundaryPin();
+
   std::map<frNet*, std::set<std::pair<Point, frLayerNum>>, frBlockObjectComp>
   initDR_mergeBoundaryPin(int startX,
                           int startY,
                           int size,
                           const Rect& routeBox);
+  // Sends one chunk of serialized workers to a remote worker and returns
+  // the indices of the workers whose results came back.
+  std::set<int> sendWorkerChunk(
+      const std::vector<std::pair<int, std::string>>& workers,
+      uint64_t cost);
 };
 
 class FlexDRWorker;
@@ -0,0 +1,311 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <boost/serialization/string.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "distributed/drUpdate.h"
+#include "distributed/frArchive.h"
+#include "dr/FlexDR.h"
+#include "dr/FlexDR_schedule.h"
+#include "frProfileTask.h"
+#include "frRegionQuery.h"
+#include "serialization.h"
+
+namespace drt {
+
+namespace {
+
+constexpr int kCheckpointVersion = 2;
+
+// 64-bit FNV-1a over the values added to it.
+class Fingerprint
+{
+ public:
+  void add(const int64_t value) { mix(&value, sizeof(value)); }
+  void add(const std::string& value)
+  {
+    add(static_cast<int64_t>(value.size()));
+    mix(value.data(), value.size());
+  }
+  void add(const Point& point)
+  {
+    add(point.x());
+    add(point.y());
+  }
+  uint64_t value() const { return hash_; }
+
+ private:
+  void mix(const void* data, const size_t size)
+  {
+    const auto bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash_ ^= bytes[i];
+      hash_ *= 0x100000001b3ULL;
+    }
+  }
+
+  uint64_t hash_ = 0xcbf29ce484222325ULL;
+};
+
+// Identifies what a checkpoint's routing is valid for: the placement, the
+// connectivity and guides of the nets and the options that change the
+// routing.  END_ITERATION is left out so a run can be resumed with more
+// iterations.
+uint64_t designFingerprint(frDesign* design)
+{
+  Fingerprint fingerprint;
+  frBlock* block = design->getTopBlock();
+  fingerprint.add(block->getName());
+  for (const auto& inst : block->getInsts()) {
+    fingerprint.add(inst->getName());
+    fingerprint.add(inst->getMaster()->getName());
+    fingerprint.add(inst->getOrigin());
+    fingerprint.add(inst->getOrient().getValue());
+  }
+  for (const auto& net : block->getNets()) {
+    fingerprint.add(net->getName());
+    for (frInstTerm* term : net->getInstTerms()) {
+      fingerprint.add(term->getName());
+    }
+    for (frBTerm* term : net->getBTerms()) {
+      fingerprint.add(term->getName());
+    }
+    for (const auto& guide : net->getGuides()) {
+      fingerprint.add(guide->getBeginPoint());
+      fingerprint.add(guide->getEndPoint());
+      fingerprint.add(guide->getBeginLayerNum());
+      fingerprint.add(guide->getEndLayerNum());
+    }
+  }
+  fingerprint.add(DBPROCESSNODE);
+  fingerprint.add(OR_SEED);
+  fingerprint.add(fmt::format("{}", OR_K));
+  fingerprint.add(BOTTOM_ROUTING_LAYER);
+  fingerprint.add(TOP_ROUTING_LAYER);
+  fingerprint.add(VIAINPIN_BOTTOMLAYERNUM);
+  fingerprint.add(VIAINPIN_TOPLAYERNUM);
+  fingerprint.add(ENABLE_VIA_GEN);
+  fingerprint.add(CLEAN_PATCHES);
+  fingerprint.add(MAX_CLIPSIZE_INCREASE);
+  return fingerprint.value();
+}
+
+}  // namespace
+
+void FlexDR::writeCheckpoint(const std::string& file_name,
+                             const int step,
+                             const FlexDRAdaptiveSchedule* schedule)
+{
+  ProfileTask profile("DR:writeCheckpoint");
+  frBlock* topBlock = getDesign()->getTopBlock();
+  // The routing of each net in order followed by the markers, as in the
+  // updates of a dumped worker.
+  std::vector<drUpdate> updates;
+  for (const auto& net : topBlock->getNets()) {
+    for (const auto& shape : net->getShapes()) {
+      drUpdate update;
+      update.setPathSeg(*static_cast<frPathSeg*>(shape.get()));
+      update.setNet(net.get());
+      updates.push_back(update);
+    }
+    for (const auto& via : net->getVias()) {
+      drUpdate update;
+      update.setVia(*via);
+      update.setNet(net.get());
+      updates.push_back(update);
+    }
+    for (const auto& pwire : net->getPatchWires()) {
+      drUpdate update;
+      update.setPatchWire(*static_cast<frPatchWire*>(pwire.get()));
+      update.setNet(net.get());
+      updates.push_back(update);
+    }
+  }
+  for (const auto& marker : topBlock->getMarkers()) {
+    drUpdate update;
+    update.setMarker(*marker);
+    updates.push_back(update);
+  }
+
+  // Write to a temporary file first so an interrupted write never replaces
+  // the last good checkpoint.
+  const std::string tmp_name = file_name + ".tmp";
+  std::ofstream file(tmp_name, std::ios::binary);
+  if (!file.good()) {
+    logger_->warn(DRT, 208, "Cannot write checkpoint {}.", file_name);
+    return;
+  }
+  {
+    frOArchive ar(file);
+    registerTypes(ar);
+    const uint64_t fingerprint = designFingerprint(getDesign());
+    const bool adaptive = schedule != nullptr;
+    ar << kCheckpointVersion;
+    ar << fingerprint;
+    ar << adaptive;
+    ar << step;
+    ar << iter_;
+    ar << increaseClipsize_;
+    ar << clipSizeInc_;
+    ar << numViols_;
+    if (schedule != nullptr) {
+      ar << *schedule;
+    }
+    ar << updates;
+  }
+  file.close();
+  if (file.fail()) {
+    logger_->warn(DRT, 208, "Cannot write checkpoint {}.", file_name);
+    return;
+  }
+  if (std::rename(tmp_name.c_str(), file_name.c_str()) != 0) {
+    logger_->warn(DRT,
+                  213,
+                  "Cannot replace checkpoint {} with {}.",
+                  file_name,
+                  tmp_name);
+  }
+}
+
+bool FlexDR::readCheckpoint(const std::string& file_name,
+                            int& step,
+                            FlexDRAdaptiveSchedule* schedule)
+{
+  std::ifstream file(file_name, std::ios::binary);
+  if (!file.good()) {
+    return false;
+  }
+  if (dist_on_) {
+    logger_->error(DRT,
+                   209,
+                   "Resuming from a checkpoint is not supported with "
+                   "distributed routing.");
+  }
+
+  ProfileTask profile("DR:readCheckpoint");
+  frBlock* topBlock = getDesign()->getTopBlock();
+  std::vector<drUpdate> updates;
+  try {
+    frIArchive ar(file);
+    ar.setDesign(getDesign());
+    registerTypes(ar);
+    int version = 0;
+    ar >> version;
+    if (version != kCheckpointVersion) {
+      logger_->error(DRT,
+                     211,
+                     "Checkpoint {} has unsupported version {}.",
+                     file_name,
+                     version);
+    }
+    uint64_t fingerprint = 0;
+    ar >> fingerprint;
+    if (fingerprint != designFingerprint(getDesign())) {
+      logger_->error(DRT,
+                     200,
+                     "Checkpoint {} was written for a different design or "
+                     "routing options.",
+                     file_name);
+    }
+    bool adaptive = false;
+    ar >> adaptive;
+    if (adaptive != (schedule != nullptr)) {
+      logger_->error(DRT,
+                     205,
+                     "Checkpoint {} was written with a different search and "
+                     "repair schedule.",
+                     file_name);
+    }
+    ar >> step;
+    ar >> iter_;
+    ar >> increaseClipsize_;
+    ar >> clipSizeInc_;
+    ar >> numViols_;
+    if (schedule != nullptr) {
+      ar >> *schedule;
+    }
+    ar >> updates;
+  } catch (const boost::archive::archive_exception& e) {
+    logger_->error(
+        DRT, 212, "Cannot read checkpoint {}: {}.", file_name, e.what());
+  }
+
+  for (const auto& net : topBlock->getNets()) {
+    net->clearRoutes();
+  }
+  std::vector<frMarker*> markers;
+  for (const auto& marker : topBlock->getMarkers()) {
+    markers.push_back(marker.get());
+  }
+  for (frMarker* marker : markers) {
+    getRegionQuery()->removeMarker(marker);
+    topBlock->removeMarker(marker);
+  }
+  for (const drUpdate& update : updates) {
+    switch (update.getObjTypeId()) {
+      case frcPathSeg:
+        update.getNet()->addShape(
+            std::make_unique<frPathSeg>(update.getPathSeg()));
+        break;
+      case frcPatchWire:
+        update.getNet()->addPatchWire(
+            std::make_unique<frPatchWire>(update.getPatchWire()));
+        break;
+      case frcVia:
+        update.getNet()->addVia(std::make_unique<frVia>(update.getVia()));
+        break;
+      default: {
+        auto marker = std::make_unique<frMarker>(update.getMarker());
+        getRegionQuery()->addMarker(marker.get());
+        topBlock->addMarker(std::move(marker));
+        break;
+      }
+    }
+  }
+  // Build the query from the restored routing in net order, as routing
+  // does when it starts.
+  getRegionQuery()->initDRObj();
+
+  logger_->info(DRT,
+                197,
+                "Resuming from checkpoint {} at iteration {}.",
+                file_name,
+                iter_);
+  return true;
+}
+
+}  // namespace drt
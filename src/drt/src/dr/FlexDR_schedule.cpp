@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dr/FlexDR_schedule.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "global.h"
+#include "utl/Logger.h"
+
+namespace drt {
+
+namespace {
+
+// The cost levels of the fixed strategy table, cheapest first.
+struct CostLevel
+{
+  int mazeEndIter;
+  frUInt4 drcCost;
+  frUInt4 markerCost;
+  frUInt4 fixedShapeCost;
+  float markerDecay;
+};
+
+// clang-format off
+constexpr CostLevel kCostLevels[] = {
+  { 8,  1,  1,   2, 0.950},
+  { 8,  2,  1,   3, 0.950},
+  { 8,  4,  1,  10, 0.950},
+  { 8,  8,  2,  10, 0.950},
+  { 8, 16,  4,  50, 0.950},
+  {16, 16,  4, 100, 0.990},
+  {32, 32,  8, 100, 0.999},
+  {64, 64, 16, 100, 0.999}
+};
+// clang-format on
+
+constexpr int kNumCostLevels = sizeof(kCostLevels) / sizeof(kCostLevels[0]);
+
+// An iteration that removes less than this fraction of the markers stalls.
+constexpr double kMinProgress = 0.05;
+// Consecutive stalled iterations before the costs are raised.
+constexpr int kStallsPerLevel = 2;
+// Iterations without a new best marker count before routing stops (16);
+// enough to stall through every cost level.
+constexpr int kStallLimit = kStallsPerLevel * kNumCostLevels;
+
+}  // namespace
+
+FlexDRAdaptiveSchedule::FlexDRAdaptiveSchedule(
+    std::vector<SearchRepairArgs> initial,
+    Logger* logger)
+    : initial_(std::move(initial)), logger_(logger)
+{
+}
+
+std::optional<FlexDR::SearchRepairArgs> FlexDRAdaptiveSchedule::next(
+    const int iter,
+    const std::vector<int>& num_viols)
+{
+  if (iter < (int) initial_.size()) {
+    return initial_[iter];
+  }
+  if (num_viols.size() < 2) {
+    return repairArgs();
+  }
+
+  const int markers = num_viols.back();
+  const int prev_markers = num_viols[num_viols.size() - 2];
+  if (markers < best_) {
+    best_ = markers;
+    since_best_ = 0;
+  } else if (++since_best_ >= kStallLimit) {
+    logger_->info(DRT,
+                  196,
+                  "Stopping after {} iterations without fewer than {} "
+                  "violations.",
+                  since_best_,
+                  best_);
+    return std::nullopt;
+  }
+
+  if (markers > prev_markers * (1 - kMinProgress)) {
+    if (++stalled_ >= kStallsPerLevel) {
+      stalled_ = 0;
+      level_ = std::min(level_ + 1, kNumCostLevels - 1);
+      perturb_ = true;
+    }
+  } else {
+    stalled_ = 0;
+  }
+
+  debugPrint(logger_,
+             DRT,
+             "schedule",
+             1,
+             "Iteration {}: {} violations, cost level {}, {} stalled.",
+             iter,
+             markers,
+             level_,
+             stalled_);
+
+  if (perturb_) {
+    perturb_ = false;
+    return perturbArgs();
+  }
+  return repairArgs();
+}
+
+// Rip up and reroute around the markers at the current cost level, stepping
+// the clip offset so the clip boundaries move between iterations.
+FlexDR::SearchRepairArgs FlexDRAdaptiveSchedule::repairArgs()
+{
+  const CostLevel& level = kCostLevels[level_];
+  const frUInt4 shapeCost = ROUTESHAPECOST;
+  SearchRepairArgs args{7,
+                        -offset_,
+                        level.mazeEndIter,
+                        level.drcCost * shapeCost,
+                        level.markerCost * MARKERCOST,
+                        level.fixedShapeCost * shapeCost,
+                        level.markerDecay,
+                        RipUpMode::DRC,
+                        false};
+  offset_ = (offset_ + 1) % 7;
+  return args;
+}
+
+// After the costs are raised, shake up the routing near the markers with
+// cheap costs: alternately the nets near markers and every net in a small
+// clip around them.
+FlexDR::SearchRepairArgs FlexDRAdaptiveSchedule::perturbArgs()
+{
+  const CostLevel& level = kCostLevels[level_];
+  const frUInt4 shapeCost = ROUTESHAPECOST;
+  if (num_perturbs_++ % 2 == 0) {
+    return {7,
+            -offset_,
+            level.mazeEndIter,
+            shapeCost,
+            MARKERCOST,
+            level.fixedShapeCost * shapeCost,
+            level.markerDecay,
+            RipUpMode::NEARDRC,
+            false};
+  }
+  SearchRepairArgs args{3,
+                        -(num_perturbs_ % 3),
+                        8,
+                        shapeCost,
+                        MARKERCOST,
+                        level.fixedShapeCost * shapeCost,
+                        level.markerDecay,
+                        RipUpMode::ALL,
+                        false};
+  args.hotspotsOnly = true;
+  return args;
+}
+
+}  // namespace drt
@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "dr/FlexDR.h"
+
+namespace drt {
+
+// Picks the search and repair arguments of each detailed routing iteration
+// from the trend of the marker count instead of walking the fixed strategy
+// table.  Costs escalate only while the marker count stalls, the iteration
+// after each escalation rips up around the markers only, and routing stops
+// once the best marker count has not improved for 16 iterations.  The choices
+// depend on the marker counts alone, so a run is reproducible.
+class FlexDRAdaptiveSchedule
+{
+ public:
+  using SearchRepairArgs = FlexDR::SearchRepairArgs;
+
+  // The initial iterations are run as given before adapting.
+  FlexDRAdaptiveSchedule(std::vector<SearchRepairArgs> initial,
+                         Logger* logger);
+
+  // Returns the arguments of iteration iter given the marker count after
+  // each of the previous iterations, or nothing once routing should stop.
+  std::optional<SearchRepairArgs> next(int iter,
+                                       const std::vector<int>& num_viols);
+
+ private:
+  SearchRepairArgs repairArgs();
+  SearchRepairArgs perturbArgs();
+
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int version)
+  {
+    (ar) & level_;
+    (ar) & offset_;
+    (ar) & stalled_;
+    (ar) & best_;
+    (ar) & since_best_;
+    (ar) & num_perturbs_;
+    (ar) & perturb_;
+  }
+
+  std::vector<SearchRepairArgs> initial_;
+  Logger* logger_;
+  int level_ = 0;
+  int offset_ = 0;
+  int stalled_ = 0;
+  int best_ = std::numeric_limits<int>::max();
+  int since_best_ = 0;
+  int num_perturbs_ = 0;
+  bool perturb_ = false;
+
+  friend class boost::serialization::access;
+};
+
+}  // namespace drt
@@ -70,6 +70,8 @@ bool CLEAN_PATCHES = false;
 bool DO_PA = true;
 bool SINGLE_STEP_DR = false;
 bool SAVE_GUIDE_UPDATES = false;
+bool ADAPTIVE_DR_SCHEDULE = false;
+std::string DR_CHECKPOINT_FILE;
 
 std::string VIAINPIN_BOTTOMLAYER_NAME;
 std::string VIAINPIN_TOPLAYER_NAME;
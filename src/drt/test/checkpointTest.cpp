@@ -0,0 +1,207 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifdef HAS_BOOST_UNIT_TEST_LIBRARY
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "dr/FlexDR.h"
+#include "fixture.h"
+#include "frDesign.h"
+
+namespace drt {
+
+namespace {
+
+// The routing and markers of the design, one line per object.
+std::vector<std::string> snapshot(frDesign* design)
+{
+  std::vector<std::string> lines;
+  frBlock* block = design->getTopBlock();
+  for (const auto& net : block->getNets()) {
+    for (const auto& shape : net->getShapes()) {
+      auto [begin, end] = static_cast<frPathSeg*>(shape.get())->getPoints();
+      lines.push_back(fmt::format("{} seg {} ({} {}) ({} {})",
+                                  net->getName(),
+                                  shape->getLayerNum(),
+                                  begin.x(),
+                                  begin.y(),
+                                  end.x(),
+                                  end.y()));
+    }
+    for (const auto& via : net->getVias()) {
+      lines.push_back(fmt::format("{} via {} ({} {})",
+                                  net->getName(),
+                                  via->getViaDef()->getName(),
+                                  via->getOrigin().x(),
+                                  via->getOrigin().y()));
+    }
+  }
+  for (const auto& marker : block->getMarkers()) {
+    const Rect box = marker->getBBox();
+    lines.push_back(fmt::format("marker {} ({} {}) ({} {}) {}",
+                                marker->getLayerNum(),
+                                box.xMin(),
+                                box.yMin(),
+                                box.xMax(),
+                                box.yMax(),
+                                marker->getSrcs().size()));
+  }
+  return lines;
+}
+
+}  // namespace
+
+struct CheckpointFixture : public Fixture
+{
+  CheckpointFixture()
+      : file((std::filesystem::temp_directory_path() / "drt_checkpoint_test")
+                 .string())
+  {
+    addLayer(design->getTech(), "v2", dbTechLayerType::CUT);
+    addLayer(design->getTech(), "m2", dbTechLayerType::ROUTING);
+    frMaster* master = makeMacro("m", 0, 0, 1000, 1000);
+    inst = makeInst("i1", master, 0, 0);
+
+    frNet* n1 = makeNet("n1");
+    frNet* n2 = makeNet("n2");
+    makePathseg(n1, 2, {0, 100}, {1000, 100});
+    makeVia(makeViaDef("v1", 3, {0, 0}, {100, 100}), n1, {1000, 50});
+    makePathseg(n2, 2, {0, 300}, {600, 300});
+
+    auto marker = std::make_unique<frMarker>();
+    marker->setBBox({500, 150, 600, 250});
+    marker->setLayerNum(2);
+    marker->addSrc(n1);
+    marker->addSrc(n2);
+    design->getTopBlock()->addMarker(std::move(marker));
+
+    initRegionQuery();
+  }
+
+  ~CheckpointFixture() override { std::remove(file.c_str()); }
+
+  const std::string file;
+  frInst* inst;
+};
+
+BOOST_FIXTURE_TEST_SUITE(checkpoint, CheckpointFixture);
+
+BOOST_AUTO_TEST_CASE(restores_routing_and_markers)
+{
+  const std::vector<std::string> routed = snapshot(design.get());
+  FlexDR(nullptr, design.get(), logger.get(), nullptr)
+      .writeCheckpoint(file, 3, nullptr);
+
+  // Route further so the restore has something to undo
+  makePathseg(design->getTopBlock()->findNet("n2"), 2, {0, 500}, {900, 500});
+  frMarker* marker = design->getTopBlock()->getMarkers().front().get();
+  design->getRegionQuery()->removeMarker(marker);
+  design->getTopBlock()->removeMarker(marker);
+  BOOST_TEST((snapshot(design.get()) != routed));
+
+  FlexDR resumed(nullptr, design.get(), logger.get(), nullptr);
+  int step = 0;
+  BOOST_TEST(resumed.readCheckpoint(file, step, nullptr));
+  BOOST_TEST(step == 3);
+  BOOST_TEST(snapshot(design.get()) == routed,
+             boost::test_tools::per_element());
+
+  // The region query holds the restored objects
+  const Rect die(0, 0, 1000, 1000);
+  std::vector<frBlockObject*> objs;
+  design->getRegionQuery()->queryDRObj(die, 2, objs);
+  BOOST_TEST(objs.size() == 2);
+  std::vector<frMarker*> markers;
+  design->getRegionQuery()->queryMarker(die, markers);
+  BOOST_TEST(markers.size() == 1);
+  BOOST_TEST(markers[0] == design->getTopBlock()->getMarkers().front().get());
+}
+
+BOOST_AUTO_TEST_CASE(write_leaves_region_query_alone)
+{
+  // Routing updates the query one object at a time, not in net order
+  frNet* nets[] = {design->getTopBlock()->findNet("n2"),
+                   design->getTopBlock()->findNet("n1")};
+  for (int i = 0; i < 20; i++) {
+    frNet* net = nets[i % 2];
+    makePathseg(net, 2, {0, 950 - 40 * i}, {50 * i, 950 - 40 * i});
+    design->getRegionQuery()->addDRObj(net->getShapes().back().get());
+  }
+  frMarker* marker = design->getTopBlock()->getMarkers().front().get();
+  design->getRegionQuery()->addMarker(marker);
+  const Rect die(0, 0, 1000, 1000);
+  std::vector<frBlockObject*> objs;
+  design->getRegionQuery()->queryDRObj(die, objs);
+  std::vector<frMarker*> markers;
+  design->getRegionQuery()->queryMarker(die, markers);
+
+  FlexDR(nullptr, design.get(), logger.get(), nullptr)
+      .writeCheckpoint(file, 1, nullptr);
+
+  std::vector<frBlockObject*> objs_after;
+  design->getRegionQuery()->queryDRObj(die, objs_after);
+  BOOST_TEST(objs_after == objs, boost::test_tools::per_element());
+  std::vector<frMarker*> markers_after;
+  design->getRegionQuery()->queryMarker(die, markers_after);
+  BOOST_TEST(markers_after == markers, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(rejects_changed_placement)
+{
+  FlexDR(nullptr, design.get(), logger.get(), nullptr)
+      .writeCheckpoint(file, 1, nullptr);
+  inst->setOrigin({200, 0});
+
+  FlexDR resumed(nullptr, design.get(), logger.get(), nullptr);
+  int step = 0;
+  BOOST_CHECK_THROW(resumed.readCheckpoint(file, step, nullptr),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(missing_file)
+{
+  FlexDR resumed(nullptr, design.get(), logger.get(), nullptr);
+  int step = 0;
+  BOOST_TEST(!resumed.readCheckpoint(file, step, nullptr));
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace drt
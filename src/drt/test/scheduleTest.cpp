@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifdef HAS_BOOST_UNIT_TEST_LIBRARY
+#define BOOST_TEST_DYN_LINK
+#endif
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <optional>
+#include <vector>
+
+#include "dr/FlexDR_schedule.h"
+#include "fixture.h"
+#include "utl/Logger.h"
+
+namespace drt {
+
+using Args = FlexDRAdaptiveSchedule::SearchRepairArgs;
+
+namespace {
+
+Args initialArgs()
+{
+  return {7, 0, 3, 0, 0, 0, 0.95, RipUpMode::ALL, true};
+}
+
+// Runs the schedule on the marker counts produced by markers(iter) and
+// returns the arguments of every iteration until it stops or max_iters.
+template <class MarkerFn>
+std::vector<Args> runSchedule(MarkerFn markers, int max_iters)
+{
+  utl::Logger logger;
+  FlexDRAdaptiveSchedule schedule({initialArgs()}, &logger);
+  std::vector<Args> result;
+  std::vector<int> num_viols;
+  for (int iter = 0; iter < max_iters; iter++) {
+    std::optional<Args> args = schedule.next(iter, num_viols);
+    if (!args) {
+      break;
+    }
+    result.push_back(*args);
+    num_viols.push_back(markers(iter));
+  }
+  return result;
+}
+
+bool sameArgs(const Args& a, const Args& b)
+{
+  return a.size == b.size && a.offset == b.offset
+         && a.mazeEndIter == b.mazeEndIter
+         && a.workerDRCCost == b.workerDRCCost
+         && a.workerMarkerCost == b.workerMarkerCost
+         && a.workerFixedShapeCost == b.workerFixedShapeCost
+         && a.workerMarkerDecay == b.workerMarkerDecay
+         && a.ripupMode == b.ripupMode && a.followGuide == b.followGuide
+         && a.hotspotsOnly == b.hotspotsOnly;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(adaptive_schedule);
+
+// The initial iterations are used as given
+BOOST_AUTO_TEST_CASE(initial_iterations)
+{
+  const auto args = runSchedule([](int) { return 1000; }, 1);
+  BOOST_TEST(args.size() == 1);
+  BOOST_TEST(sameArgs(args[0], initialArgs()));
+}
+
+// While the markers go down steadily the cheapest costs are kept and the
+// clip offset steps through the clip size.
+BOOST_AUTO_TEST_CASE(keeps_costs_while_progressing)
+{
+  const auto args
+      = runSchedule([](int iter) { return 100000 >> (iter / 2); }, 30);
+  BOOST_TEST(args.size() == 30);
+  for (int iter = 1; iter < (int) args.size(); iter++) {
+    BOOST_TEST(args[iter].size == 7);
+    BOOST_TEST(args[iter].offset == -((iter - 1) % 7));
+    BOOST_TEST(args[iter].mazeEndIter == 8);
+    BOOST_TEST(args[iter].workerDRCCost == ROUTESHAPECOST);
+    TEST_ENUM_EQUAL(args[iter].ripupMode, RipUpMode::DRC);
+    BOOST_TEST(!args[iter].hotspotsOnly);
+  }
+}
+
+// A stalled marker count raises the costs, each raise is followed by a
+// perturbation, and routing stops 16 iterations after the best count was
+// first seen, the count of iteration 1.
+BOOST_AUTO_TEST_CASE(escalates_and_stops_on_stall)
+{
+  const auto args = runSchedule([](int) { return 50; }, 100);
+  BOOST_TEST(args.size() == 2 + 16);
+
+  int num_near_drc = 0;
+  int num_hotspots = 0;
+  frUInt4 prev_fixed_cost = 0;
+  int max_maze_end_iter = 0;
+  for (int iter = 1; iter < (int) args.size(); iter++) {
+    const Args& a = args[iter];
+    if (a.hotspotsOnly) {
+      num_hotspots++;
+      BOOST_TEST(a.size == 3);
+      TEST_ENUM_EQUAL(a.ripupMode, RipUpMode::ALL);
+    } else if (a.ripupMode == RipUpMode::NEARDRC) {
+      num_near_drc++;
+    } else {
+      TEST_ENUM_EQUAL(a.ripupMode, RipUpMode::DRC);
+    }
+    // Costs never go down
+    BOOST_TEST(a.workerFixedShapeCost >= prev_fixed_cost);
+    prev_fixed_cost = a.workerFixedShapeCost;
+    max_maze_end_iter = std::max(max_maze_end_iter, a.mazeEndIter);
+  }
+  // Perturbations alternate between the two kinds
+  BOOST_TEST(num_near_drc > 0);
+  BOOST_TEST(num_near_drc - num_hotspots >= 0);
+  BOOST_TEST(num_near_drc - num_hotspots <= 1);
+  // Every cost level is tried before stopping
+  BOOST_TEST(max_maze_end_iter == 64);
+}
+
+// A new best marker count restarts the stall limit
+BOOST_AUTO_TEST_CASE(improvement_restarts_stall_limit)
+{
+  const auto args
+      = runSchedule([](int iter) { return iter < 15 ? 50 : 40; }, 100);
+  BOOST_TEST(args.size() == 16 + 16);
+}
+
+// The schedule depends on the marker counts only
+BOOST_AUTO_TEST_CASE(reproducible)
+{
+  auto markers = [](int iter) { return 1000 - 3 * iter + (iter % 4) * 20; };
+  const auto a = runSchedule(markers, 200);
+  const auto b = runSchedule(markers, 200);
+  BOOST_TEST(a.size() == b.size());
+  for (size_t i = 0; i < std::min(a.size(), b.size()); i++) {
+    BOOST_TEST(sameArgs(a[i], b[i]));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace drt
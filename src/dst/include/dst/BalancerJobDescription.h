@@ -28,6 +28,7 @@
 
 #pragma once
 #include <boost/serialization/base_object.hpp>
+#include <cstdint>
 #include <string>
 
 #include "dst/JobMessage.h"
@@ -39,15 +40,31 @@ namespace dst {
 class BalancerJobDescription : public JobDescription
 {
  public:
-  BalancerJobDescription() : worker_port_(0) {}
+  // ASSIGN asks the balancer for a worker.  The leader talks to that worker
+  // directly, so it reports back with RELEASE once the job is done or FAIL
+  // if it was lost, and the balancer releases the job's cost.
+  enum Action : uint8_t
+  {
+    ASSIGN,
+    RELEASE,
+    FAIL
+  };
+  BalancerJobDescription() : worker_port_(0), cost_(1), action_(ASSIGN) {}
   void setWorkerIP(const std::string& ip) { worker_ip_ = ip; }
   void setWorkerPort(unsigned short port) { worker_port_ = port; }
+  // Estimated cost of the job a worker is requested for.
+  void setCost(uint64_t cost) { cost_ = cost; }
+  void setAction(Action action) { action_ = action; }
   std::string getWorkerIP() const { return worker_ip_; }
   unsigned short getWorkerPort() const { return worker_port_; }
+  uint64_t getCost() const { return cost_; }
+  Action getAction() const { return action_; }
 
  private:
   std::string worker_ip_;
   unsigned short worker_port_;
+  uint64_t cost_;
+  Action action_;
 
   template <class Archive>
   void serialize(Archive& ar, const unsigned int version)
@@ -55,6 +72,8 @@ class BalancerJobDescription : public JobDescription
     (ar) & boost::serialization::base_object<dst::JobDescription>(*this);
     (ar) & worker_ip_;
     (ar) & worker_port_;
+    (ar) & cost_;
+    (ar) & action_;
   }
   friend class boost::serialization::access;
 };
@@ -27,6 +27,8 @@
  */
 
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -72,6 +74,13 @@ class JobMessage
     UNICAST,
     BROADCAST
   };
+  // Archive used for the payload of outgoing messages. Incoming messages
+  // carry their encoding in the frame header so both are always accepted.
+  enum Encoding : uint8_t
+  {
+    TEXT,
+    BINARY
+  };
   JobMessage(JobType job_type = NONE, MessageType msg_type = UNICAST)
       : msg_type_(msg_type), job_type_(job_type)
   {
@@ -95,14 +104,44 @@ class JobMessage
   JobType getJobType() const { return job_type_; }
   MessageType getMessageType() const { return msg_type_; }
 
+  // Process wide settings for outgoing messages.  Payloads at least
+  // compression_threshold bytes long are zlib compressed (0 disables).
+  static void setEncoding(Encoding encoding);
+  static Encoding getEncoding();
+  static void setCompressionThreshold(std::size_t bytes);
+  static std::size_t getCompressionThreshold();
+  // Receivers allocate the sizes given in a frame header, so incoming frames
+  // whose payload is larger than this, before or after decompression, are
+  // rejected as malformed.
+  static constexpr std::size_t DEFAULT_MAX_FRAME_SIZE = 256 << 20;
+  static void setMaxFrameSize(std::size_t bytes);
+  static std::size_t getMaxFrameSize();
+
  private:
   MessageType msg_type_;
   JobType job_type_;
   std::unique_ptr<JobDescription> desc_;
   std::vector<std::unique_ptr<JobDescription>> descs_;
 
-  static constexpr const char* EOP
-      = "\r\nENDOFPACKET\r\n";  // ENDOFPACKET SEQUENCE
+  // Every message is sent as a fixed size header followed by the payload:
+  //   magic[4] version[1] encoding[1] flags[1] reserved[1]
+  //   payload_size[8] raw_size[8]
+  // Sizes are little endian; raw_size is the payload size before
+  // compression.  Framing by size lets binary payloads contain any bytes.
+  static constexpr char MAGIC[4] = {'D', 'S', 'T', 'M'};
+  static constexpr uint8_t FORMAT_VERSION = 1;
+  static constexpr std::size_t HEADER_SIZE = 24;
+  static constexpr uint8_t COMPRESSED = 0x1;
+  // zlib cannot expand data by more than MAX_COMPRESSION_RATIO.
+  static constexpr uint64_t MAX_COMPRESSION_RATIO = 1032;
+
+  struct FrameHeader
+  {
+    Encoding encoding{BINARY};
+    uint8_t flags{0};
+    uint64_t payload_size{0};
+    uint64_t raw_size{0};
+  };
 
   template <class Archive>
   void serialize(Archive& ar, const unsigned int version);
@@ -114,9 +153,22 @@ class JobMessage
     READ,
     WRITE
   };
+  // WRITE encodes msg into a complete frame (header and payload) in str.
+  // READ decodes the first frame found in str into msg.
   static bool serializeMsg(SerializeType type,
                            JobMessage& msg,
                            std::string& str);
+  // Parses a frame header; returns false if it is not a valid header.
+  static bool decodeHeader(const char* data,
+                           std::size_t size,
+                           FrameHeader& header);
+  // Returns the number of complete frames making up data, or -1 if data
+  // ends with a partial or malformed frame.
+  static int countFrames(const char* data, std::size_t size);
+  // Decodes a payload in place without copying it.
+  static bool deserializeMsg(const FrameHeader& header,
+                             const char* payload,
+                             JobMessage& msg);
   friend class dst::Distributed;
   friend class dst::WorkerConnection;
   friend class dst::BalancerConnection;
@@ -30,6 +30,8 @@
 
 #include <dst/JobMessage.h>
 
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/asio/post.hpp>
@@ -64,10 +66,42 @@ tcp::socket& BalancerConnection::socket()
 
 void BalancerConnection::start()
 {
-  async_read_until(
+  asio::async_read(
       sock_,
-      in_packet_,
-      JobMessage::EOP,
+      asio::buffer(header_),
+      [me = shared_from_this()](boost::system::error_code const& ec,
+                                std::size_t bytes_xfer) {
+        me->handle_read_header(ec, bytes_xfer);
+      });
+}
+
+void BalancerConnection::handle_read_header(
+    boost::system::error_code const& err,
+    size_t bytes_transferred)
+{
+  if (err) {
+    logger_->warn(utl::DST,
+                  46,
+                  "Balancer conhandler failed with message: {}",
+                  err.message());
+    sock_.close();
+    return;
+  }
+  if (!JobMessage::decodeHeader(
+          header_.data(), bytes_transferred, frame_header_)) {
+    boost::system::error_code error;
+    logger_->warn(utl::DST,
+                  44,
+                  "Received malformed msg header from port {}",
+                  sock_.remote_endpoint().port());
+    asio::write(sock_, asio::buffer("0"), error);
+    sock_.close();
+    return;
+  }
+  payload_.resize(frame_header_.payload_size);
+  asio::async_read(
+      sock_,
+      asio::buffer(payload_),
       [me = shared_from_this()](boost::system::error_code const& ec,
                                 std::size_t bytes_xfer) {
         boost::thread t(&BalancerConnection::handle_read, me, ec, bytes_xfer);
@@ -80,14 +114,15 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
 {
   if (!err) {
     boost::system::error_code error;
-    std::string data{buffers_begin(in_packet_.data()),
-                     buffers_begin(in_packet_.data()) + bytes_transferred};
+    // The received frame is relayed to workers as is.
+    const std::array<asio::const_buffer, 2> packet{asio::buffer(header_),
+                                                   asio::buffer(payload_)};
     JobMessage msg(JobMessage::NONE);
-    if (!JobMessage::serializeMsg(JobMessage::READ, msg, data)) {
+    if (!JobMessage::deserializeMsg(frame_header_, payload_.data(), msg)) {
       logger_->warn(utl::DST,
                     42,
-                    "Received malformed msg {} from port {}",
-                    data,
+                    "Received malformed msg of {} bytes from port {}",
+                    bytes_transferred,
                     sock_.remote_endpoint().port());
       asio::write(sock_, asio::buffer("0"), error);
       sock_.close();
@@ -97,7 +132,20 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
       case JobMessage::UNICAST: {
         ip::address workerAddress;
         unsigned short port;
-        owner_->getNextWorker(workerAddress, port);
+        // Relayed jobs are charged by size until their reply comes back.
+        // Jobs only asking for a worker carry their own cost estimate.
+        uint64_t cost = payload_.size();
+        if (msg.getJobType() == JobMessage::BALANCER) {
+          auto request
+              = dynamic_cast<BalancerJobDescription*>(msg.getJobDescription());
+          cost = request != nullptr ? request->getCost() : 1;
+          if (request != nullptr
+              && request->getAction() != BalancerJobDescription::ASSIGN) {
+            releaseWorker(*request);
+            break;
+          }
+        }
+        owner_->getNextWorker(workerAddress, port, cost);
         if (workerAddress.is_unspecified()) {
           logger_->warn(utl::DST, 6, "No workers available");
           sock_.close();
@@ -112,28 +160,37 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
             owner_->dist_->sendResult(reply, sock_);
             sock_.close();
           } else {
-            asio::io_service io_service;
-            tcp::socket socket(io_service);
             int failed_workers_trials = 0;
-            asio::streambuf receive_buffer;
+            std::string reply;
             bool failure = true;
             while (failure) {
+              asio::io_service io_service;
+              tcp::socket socket(io_service);
+              asio::streambuf receive_buffer;
               try {
                 socket.connect(tcp::endpoint(workerAddress, port));
-                asio::write(socket, in_packet_);
-                asio::read(socket, receive_buffer, asio::transfer_all());
+                socket.set_option(asio::socket_base::keep_alive(true));
+                asio::write(socket, packet);
+                boost::system::error_code read_error;
+                asio::read(
+                    socket, receive_buffer, asio::transfer_all(), read_error);
+                // The worker closes the connection once it has replied, so
+                // eof is expected.  A reply cut short by a disconnect is a
+                // failure and the job is retried on another worker.
+                if (read_error && read_error != asio::error::eof) {
+                  throw boost::system::system_error(read_error);
+                }
+                reply.assign(asio::buffers_begin(receive_buffer.data()),
+                             asio::buffers_end(receive_buffer.data()));
+                if (JobMessage::countFrames(reply.data(), reply.size()) <= 0) {
+                  throw std::runtime_error("incomplete reply");
+                }
+                owner_->updateWorker(workerAddress, port, cost);
                 failure = false;
               } catch (std::exception const& ex) {
                 if (socket.is_open()) {
                   socket.close();
                 }
-                if (std::string(ex.what()).find("read: End of file")
-                    != std::string::npos) {
-                  // Since asio::transfer_all() used with a stream buffer it
-                  // always reach an eof file exception!
-                  failure = false;
-                  break;
-                }
                 logger_->warn(utl::DST,
                               204,
                               "Exception thrown: {}. worker with ip \"{}\" and "
@@ -141,7 +198,7 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
                               ex.what(),
                               workerAddress,
                               port);
-                owner_->punishWorker(workerAddress, port);
+                owner_->punishWorker(workerAddress, port, cost);
                 failed_workers_trials++;
                 if (failed_workers_trials == MAX_FAILED_WORKERS_TRIALS) {
                   logger_->warn(utl::DST,
@@ -151,7 +208,11 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
                                 failed_workers_trials);
                   break;
                 }
-                owner_->getNextWorker(workerAddress, port);
+                workerAddress = ip::address();
+                owner_->getNextWorker(workerAddress, port, cost);
+                if (workerAddress.is_unspecified()) {
+                  break;
+                }
               }
             }
             if (failure) {
@@ -160,7 +221,7 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
               JobMessage::serializeMsg(JobMessage::WRITE, result, msgStr);
               asio::write(sock_, asio::buffer(msgStr), error);
             } else {
-              asio::write(sock_, receive_buffer, error);
+              asio::write(sock_, asio::buffer(reply), error);
             }
             sock_.close();
           }
@@ -169,17 +230,17 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
       }
       case JobMessage::BROADCAST: {
         std::lock_guard<std::mutex> lock(owner_->workers_mutex_);
+        std::string data(header_.begin(), header_.end());
+        data.append(payload_.begin(), payload_.end());
         owner_->broadcastData.push_back(data);
         asio::thread_pool pool(owner_->workers_.size());
-        auto workers_copy = owner_->workers_;
+        const auto workers_copy = owner_->workers_;
         std::mutex broadcast_failure_mutex;
         std::vector<std::pair<ip::address, unsigned short>> failed_workers;
-        while (!workers_copy.empty()) {
-          auto worker = workers_copy.top();
-          workers_copy.pop();
+        for (const auto& worker : workers_copy) {
           asio::post(
               pool,
-              [worker, data, &failed_workers, &broadcast_failure_mutex]() {
+              [worker, &data, &failed_workers, &broadcast_failure_mutex]() {
                 try {
                   asio::io_service io_service;
                   tcp::socket socket(io_service);
@@ -237,6 +298,24 @@ void BalancerConnection::handle_read(boost::system::error_code const& err,
   }
 }
 
+void BalancerConnection::releaseWorker(const BalancerJobDescription& request)
+{
+  boost::system::error_code error;
+  const auto address = ip::address::from_string(request.getWorkerIP(), error);
+  if (!error) {
+    if (request.getAction() == BalancerJobDescription::RELEASE) {
+      owner_->updateWorker(
+          address, request.getWorkerPort(), request.getCost());
+    } else {
+      owner_->punishWorker(
+          address, request.getWorkerPort(), request.getCost());
+    }
+  }
+  JobMessage reply(JobMessage::SUCCESS);
+  owner_->dist_->sendResult(reply, sock_);
+  sock_.close();
+}
+
 #if !SWIG && FMT_VERSION >= 100000
 namespace boost::asio::ip {
 
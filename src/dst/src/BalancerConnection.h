@@ -27,9 +27,13 @@
  */
 
 #pragma once
+#include <dst/JobMessage.h>
+
+#include <array>
 #include <boost/asio.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/make_shared.hpp>
+#include <vector>
 
 namespace asio = boost::asio;
 namespace ip = asio::ip;
@@ -40,6 +44,7 @@ class Logger;
 }
 namespace dst {
 class LoadBalancer;
+class BalancerJobDescription;
 
 class BalancerConnection
     : public boost::enable_shared_from_this<BalancerConnection>
@@ -57,13 +62,20 @@ class BalancerConnection
   }
   tcp::socket& socket();
   void start();
+  void handle_read_header(boost::system::error_code const& err,
+                          size_t bytes_transferred);
   void handle_read(boost::system::error_code const& err,
                    size_t bytes_transferred);
   LoadBalancer* getOwner() const { return owner_; }
 
  private:
+  // Releases the cost of a job the leader ran on a worker assigned to it.
+  void releaseWorker(const BalancerJobDescription& request);
+
   tcp::socket sock_;
-  asio::streambuf in_packet_;
+  std::array<char, JobMessage::HEADER_SIZE> header_;
+  JobMessage::FrameHeader frame_header_;
+  std::vector<char> payload_;
   utl::Logger* logger_;
   LoadBalancer* owner_;
   const int MAX_FAILED_WORKERS_TRIALS = 3;
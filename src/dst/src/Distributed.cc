@@ -203,18 +203,6 @@ bool Distributed::sendJob(JobMessage& msg,
   return false;
 }
 
-inline bool getNextMsg(std::string& haystack,
-                       const std::string& needle,
-                       std::string& result)
-{
-  std::size_t found = haystack.find(needle);
-  if (found != std::string::npos) {
-    result = haystack.substr(0, found + needle.size());
-    haystack.erase(0, found + needle.size());
-    return true;
-  }
-  return false;
-}
 bool Distributed::sendJobMultiResult(JobMessage& msg,
                                      const char* ip,
                                      unsigned short port,
@@ -249,14 +237,40 @@ bool Distributed::sendJobMultiResult(JobMessage& msg,
     if (!ok) {
       continue;
     }
-    std::string split;
-    while (getNextMsg(resultStr, JobMessage::EOP, split)) {
+    // The worker replies with a sequence of frames, walk them in place.  A
+    // reply cut short by a lost worker is retried like a failed send.
+    std::vector<std::unique_ptr<JobDescription>> descs;
+    std::size_t offset = 0;
+    JobMessage::FrameHeader header;
+    while (offset < resultStr.size()) {
+      const std::size_t payload_offset = offset + JobMessage::HEADER_SIZE;
+      if (!JobMessage::decodeHeader(
+              resultStr.data() + offset, resultStr.size() - offset, header)
+          || resultStr.size() - payload_offset < header.payload_size) {
+        logger_->warn(
+            utl::DST, 15, "Received truncated msg from {}:{}", ip, port);
+        ok = false;
+        break;
+      }
       JobMessage tmp;
-      if (!JobMessage::serializeMsg(JobMessage::READ, tmp, split)) {
-        logger_->error(utl::DST, 9999, "Problem in deserialize {}", split);
-      } else {
-        result.addJobDescription(std::move(tmp.getJobDescriptionRef()));
+      if (!JobMessage::deserializeMsg(
+              header, resultStr.data() + payload_offset, tmp)) {
+        logger_->warn(utl::DST,
+                      9999,
+                      "Problem in deserialize msg of {} bytes",
+                      header.payload_size);
+        ok = false;
+        break;
       }
+      descs.push_back(std::move(tmp.getJobDescriptionRef()));
+      offset = payload_offset + header.payload_size;
+    }
+    if (!ok) {
+      resultStr = "incomplete reply";
+      continue;
+    }
+    for (auto& desc : descs) {
+      result.addJobDescription(std::move(desc));
     }
     result.setJobType(JobMessage::SUCCESS);
     if (sock.is_open()) {
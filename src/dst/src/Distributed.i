@@ -28,6 +28,7 @@
 
 %{
 #include "dst/Distributed.h"
+#include "dst/JobMessage.h"
 #include "ord/OpenRoad.hh"
 %}
 
@@ -56,4 +57,16 @@ void add_worker_address(
   distributed->addWorkerAddress(address, ip);
 }
 
+void set_message_format_cmd(bool text,
+                            int compression_threshold,
+                            long max_frame_size)
+{
+  dst::JobMessage::setEncoding(text ? dst::JobMessage::TEXT
+                                    : dst::JobMessage::BINARY);
+  dst::JobMessage::setCompressionThreshold(compression_threshold);
+  dst::JobMessage::setMaxFrameSize(
+      max_frame_size > 0 ? max_frame_size
+                         : dst::JobMessage::DEFAULT_MAX_FRAME_SIZE);
+}
+
 %} // inline
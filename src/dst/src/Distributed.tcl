@@ -96,4 +96,28 @@ proc add_worker_address { args } {
     utl::error DST 17 "-port is required in add_worker_address cmd."
   }
   dst::add_worker_address $host $port
-}
\ No newline at end of file
+}
+sta::define_cmd_args "set_distributed_message_format" {
+    [-compression_threshold bytes]
+    [-max_frame_size bytes]
+    [-text]
+}
+proc set_distributed_message_format { args } {
+  sta::parse_key_args "set_distributed_message_format" args \
+    keys {-compression_threshold -max_frame_size} \
+    flags {-text}
+  sta::check_argc_eq0 "set_distributed_message_format" $args
+  set threshold 0
+  if { [info exists keys(-compression_threshold)] } {
+    set threshold $keys(-compression_threshold)
+    sta::check_positive_integer "-compression_threshold" $threshold
+  }
+  # Frames announcing a larger payload are rejected (default 256 MB).
+  set max_frame_size 0
+  if { [info exists keys(-max_frame_size)] } {
+    set max_frame_size $keys(-max_frame_size)
+    sta::check_positive_integer "-max_frame_size" $max_frame_size
+  }
+  dst::set_message_format_cmd [info exists flags(-text)] $threshold \
+    $max_frame_size
+}
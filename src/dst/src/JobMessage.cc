@@ -28,55 +28,265 @@
 
 #include "dst/JobMessage.h"
 
+#include <zlib.h>
+
+#include <atomic>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/unique_ptr.hpp>
-#include <sstream>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <streambuf>
 
 #include "dst/BalancerJobDescription.h"
 
 using namespace dst;
 
-template <class Archive>
-inline bool is_loading(const Archive& ar)
+namespace {
+
+std::atomic<JobMessage::Encoding> encoding_setting{JobMessage::BINARY};
+std::atomic<std::size_t> compression_threshold_setting{0};
+std::atomic<std::size_t> max_frame_size_setting{
+    JobMessage::DEFAULT_MAX_FRAME_SIZE};
+
+constexpr unsigned int archive_flags
+    = boost::archive::no_header | boost::archive::no_codecvt;
+
+// Read only stream buffer over an existing byte range so that received
+// payloads are decoded without being copied into a std::string first.
+class ArrayStreamBuf : public std::streambuf
+{
+ public:
+  ArrayStreamBuf(const char* data, std::size_t size)
+  {
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+  }
+};
+
+// Stream buffer appending to a std::string, used to serialize directly
+// after the space reserved for the frame header.
+class StringStreamBuf : public std::streambuf
+{
+ public:
+  explicit StringStreamBuf(std::string& str) : str_(str) {}
+
+ protected:
+  int_type overflow(int_type ch) override
+  {
+    if (ch != traits_type::eof()) {
+      str_.push_back(traits_type::to_char_type(ch));
+    }
+    return ch;
+  }
+  std::streamsize xsputn(const char* s, std::streamsize n) override
+  {
+    str_.append(s, n);
+    return n;
+  }
+
+ private:
+  std::string& str_;
+};
+
+void putUInt64(char* dst, uint64_t value)
+{
+  for (int i = 0; i < 8; i++) {
+    dst[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+}
+
+uint64_t getUInt64(const char* src)
 {
-  return std::is_same<typename Archive::is_loading, boost::mpl::true_>::value;
+  uint64_t value = 0;
+  for (int i = 0; i < 8; i++) {
+    value |= static_cast<uint64_t>(static_cast<uint8_t>(src[i])) << (8 * i);
+  }
+  return value;
 }
 
+}  // namespace
+
 template <class Archive>
 void JobMessage::serialize(Archive& ar, const unsigned int version)
 {
   (ar) & msg_type_;
   (ar) & job_type_;
   (ar) & desc_;
-  if (!is_loading(ar)) {
-    std::string eop = EOP;
-    (ar) & eop;
+}
+
+void JobMessage::setEncoding(Encoding encoding)
+{
+  encoding_setting = encoding;
+}
+
+JobMessage::Encoding JobMessage::getEncoding()
+{
+  return encoding_setting;
+}
+
+void JobMessage::setCompressionThreshold(std::size_t bytes)
+{
+  compression_threshold_setting = bytes;
+}
+
+std::size_t JobMessage::getCompressionThreshold()
+{
+  return compression_threshold_setting;
+}
+
+void JobMessage::setMaxFrameSize(std::size_t bytes)
+{
+  max_frame_size_setting = bytes;
+}
+
+std::size_t JobMessage::getMaxFrameSize()
+{
+  return max_frame_size_setting;
+}
+
+bool JobMessage::decodeHeader(const char* data,
+                              std::size_t size,
+                              FrameHeader& header)
+{
+  if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0
+      || static_cast<uint8_t>(data[4]) != FORMAT_VERSION) {
+    return false;
+  }
+  const uint8_t encoding = data[5];
+  if (encoding != TEXT && encoding != BINARY) {
+    return false;
+  }
+  header.encoding = static_cast<Encoding>(encoding);
+  header.flags = data[6];
+  header.payload_size = getUInt64(data + 8);
+  header.raw_size = getUInt64(data + 16);
+  const uint64_t max_frame_size = getMaxFrameSize();
+  if (header.payload_size > max_frame_size
+      || header.raw_size > max_frame_size) {
+    return false;
+  }
+  if (header.flags & COMPRESSED) {
+    if (header.raw_size > header.payload_size * MAX_COMPRESSION_RATIO) {
+      return false;
+    }
+  } else if (header.raw_size != header.payload_size) {
+    return false;
+  }
+  return true;
+}
+
+int JobMessage::countFrames(const char* data, std::size_t size)
+{
+  int frames = 0;
+  std::size_t offset = 0;
+  while (offset < size) {
+    FrameHeader header;
+    if (!decodeHeader(data + offset, size - offset, header)
+        || size - offset - HEADER_SIZE < header.payload_size) {
+      return -1;
+    }
+    offset += HEADER_SIZE + header.payload_size;
+    frames++;
+  }
+  return frames;
+}
+
+bool JobMessage::deserializeMsg(const FrameHeader& header,
+                                const char* payload,
+                                JobMessage& msg)
+{
+  std::string inflated;
+  const char* data = payload;
+  std::size_t size = header.payload_size;
+  if (header.flags & COMPRESSED) {
+    inflated.resize(header.raw_size);
+    uLongf inflated_size = header.raw_size;
+    if (uncompress(reinterpret_cast<Bytef*>(inflated.data()),
+                   &inflated_size,
+                   reinterpret_cast<const Bytef*>(payload),
+                   header.payload_size)
+            != Z_OK
+        || inflated_size != header.raw_size) {
+      return false;
+    }
+    data = inflated.data();
+    size = inflated.size();
+  }
+  try {
+    ArrayStreamBuf buf(data, size);
+    if (header.encoding == BINARY) {
+      boost::archive::binary_iarchive archive(buf, archive_flags);
+      archive >> msg;
+    } else {
+      std::istream stream(&buf);
+      boost::archive::text_iarchive archive(stream, archive_flags);
+      archive >> msg;
+    }
+  } catch (const boost::archive::archive_exception& e) {
+    return false;
   }
+  return true;
 }
 
 bool JobMessage::serializeMsg(SerializeType type,
                               JobMessage& msg,
                               std::string& str)
 {
-  if (type == WRITE) {
-    try {
-      std::ostringstream oarchive_stream;
-      boost::archive::text_oarchive archive(oarchive_stream);
-      archive << msg;
-      str = oarchive_stream.str();
-    } catch (const boost::archive::archive_exception& e) {
+  if (type == READ) {
+    FrameHeader header;
+    if (!decodeHeader(str.data(), str.size(), header)
+        || str.size() - HEADER_SIZE < header.payload_size) {
       return false;
     }
-  } else {
-    try {
-      std::istringstream iarchive_stream(str);
-      boost::archive::text_iarchive archive(iarchive_stream);
-      archive >> msg;
-    } catch (const boost::archive::archive_exception& e) {
-      return false;
+    return deserializeMsg(header, str.data() + HEADER_SIZE, msg);
+  }
+
+  const Encoding encoding = getEncoding();
+  str.assign(HEADER_SIZE, '\0');
+  try {
+    StringStreamBuf buf(str);
+    if (encoding == BINARY) {
+      boost::archive::binary_oarchive archive(buf, archive_flags);
+      archive << msg;
+    } else {
+      std::ostream stream(&buf);
+      boost::archive::text_oarchive archive(stream, archive_flags);
+      archive << msg;
     }
+  } catch (const boost::archive::archive_exception& e) {
+    return false;
   }
+
+  uint8_t flags = 0;
+  const uint64_t raw_size = str.size() - HEADER_SIZE;
+  const std::size_t threshold = getCompressionThreshold();
+  if (threshold != 0 && raw_size >= threshold) {
+    std::string compressed(HEADER_SIZE + compressBound(raw_size), '\0');
+    uLongf compressed_size = compressed.size() - HEADER_SIZE;
+    if (compress2(reinterpret_cast<Bytef*>(compressed.data() + HEADER_SIZE),
+                  &compressed_size,
+                  reinterpret_cast<const Bytef*>(str.data() + HEADER_SIZE),
+                  raw_size,
+                  Z_BEST_SPEED)
+            == Z_OK
+        && compressed_size < raw_size) {
+      compressed.resize(HEADER_SIZE + compressed_size);
+      str.swap(compressed);
+      flags |= COMPRESSED;
+    }
+  }
+
+  std::memcpy(str.data(), MAGIC, sizeof(MAGIC));
+  str[4] = static_cast<char>(FORMAT_VERSION);
+  str[5] = static_cast<char>(encoding);
+  str[6] = static_cast<char>(flags);
+  str[7] = 0;
+  putUInt64(str.data() + 8, str.size() - HEADER_SIZE);
+  putUInt64(str.data() + 16, raw_size);
   return true;
-}
\ No newline at end of file
+}
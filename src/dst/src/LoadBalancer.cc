@@ -28,6 +28,7 @@
 
 #include "LoadBalancer.h"
 
+#include <algorithm>
 #include <boost/bind/bind.hpp>
 #include <boost/thread/thread.hpp>
 
@@ -41,14 +42,13 @@ void LoadBalancer::start_accept()
 {
   if (jobs_ != 0 && jobs_ % 100 == 0) {
     logger_->info(utl::DST, 7, "Processed {} jobs", jobs_);
-    auto copy = workers_;
-    while (!copy.empty()) {
-      auto worker = copy.top();
-      logger_->report("Worker {}/{} handled {} jobs",
+    std::lock_guard<std::mutex> lock(workers_mutex_);
+    for (const auto& worker : workers_) {
+      logger_->report("Worker {}/{} handled {} jobs, pending load {}",
                       worker.ip,
                       worker.port,
-                      worker.priority);
-      copy.pop();
+                      worker.jobs,
+                      worker.load);
     }
   }
   jobs_++;
@@ -114,52 +114,71 @@ bool LoadBalancer::addWorker(const std::string& ip, unsigned short port)
     }
   }
   if (validWorkerState) {
-    workers_.push(worker(ip::address::from_string(ip), port, 0));
+    const worker new_worker(ip::address::from_string(ip), port);
+    if (std::find(workers_.begin(), workers_.end(), new_worker)
+        == workers_.end()) {
+      workers_.push_back(new_worker);
+    }
   }
   return validWorkerState;
 }
-void LoadBalancer::updateWorker(const ip::address& ip, unsigned short port)
+
+LoadBalancer::worker* LoadBalancer::findWorker(const ip::address& ip,
+                                               unsigned short port)
 {
-  std::lock_guard<std::mutex> lock(workers_mutex_);
-  std::priority_queue<worker, std::vector<worker>, CompareWorker> newQueue;
-  while (!workers_.empty()) {
-    auto worker = workers_.top();
-    workers_.pop();
+  for (auto& worker : workers_) {
     if (worker.ip == ip && worker.port == port) {
-      worker.priority--;
+      return &worker;
     }
-    newQueue.push(worker);
   }
-  workers_.swap(newQueue);
+  return nullptr;
 }
-void LoadBalancer::getNextWorker(ip::address& ip, unsigned short& port)
+
+void LoadBalancer::updateWorker(const ip::address& ip,
+                                unsigned short port,
+                                uint64_t cost)
 {
   std::lock_guard<std::mutex> lock(workers_mutex_);
-  if (!workers_.empty()) {
-    worker w = workers_.top();
-    workers_.pop();
-    ip = w.ip;
-    port = w.port;
-    if (w.priority != std::numeric_limits<unsigned short>::max()) {
-      w.priority++;
-    }
-    workers_.push(w);
+  worker* w = findWorker(ip, port);
+  if (w != nullptr) {
+    w->load -= std::min(w->load, cost);
+    w->failures = 0;
   }
 }
 
-void LoadBalancer::punishWorker(const ip::address& ip, unsigned short port)
+void LoadBalancer::getNextWorker(ip::address& ip,
+                                 unsigned short& port,
+                                 uint64_t cost)
 {
   std::lock_guard<std::mutex> lock(workers_mutex_);
-  std::priority_queue<worker, std::vector<worker>, CompareWorker> newQueue;
-  while (!workers_.empty()) {
-    auto worker = workers_.top();
-    workers_.pop();
-    if (worker.ip == ip && worker.port == port) {
-      worker.priority = worker.priority == 0 ? 2 : worker.priority * 2;
-    }
-    newQueue.push(worker);
+  auto best = std::min_element(workers_.begin(), workers_.end());
+  if (best != workers_.end()) {
+    ip = best->ip;
+    port = best->port;
+    best->load += cost;
+    best->jobs++;
+  }
+}
+
+void LoadBalancer::punishWorker(const ip::address& ip,
+                                unsigned short port,
+                                uint64_t cost)
+{
+  std::lock_guard<std::mutex> lock(workers_mutex_);
+  worker* w = findWorker(ip, port);
+  if (w == nullptr) {
+    return;
+  }
+  w->load -= std::min(w->load, cost);
+  if (++w->failures >= MAX_WORKER_FAILURES) {
+    logger_->warn(utl::DST,
+                  208,
+                  "Worker {}/{} failed {} consecutive jobs and is removed.",
+                  ip,
+                  port,
+                  w->failures);
+    removeWorker(ip, port, false);
   }
-  workers_.swap(newQueue);
 }
 
 void LoadBalancer::removeWorker(const ip::address& ip,
@@ -169,21 +188,19 @@ void LoadBalancer::removeWorker(const ip::address& ip,
   if (lock) {
     workers_mutex_.lock();
   }
-  std::priority_queue<worker, std::vector<worker>, CompareWorker> newQueue;
-  while (!workers_.empty()) {
-    auto worker = workers_.top();
-    workers_.pop();
-    if (worker.ip == ip && worker.port == port) {
-      continue;
-    }
-    newQueue.push(worker);
-  }
-  workers_.swap(newQueue);
+  workers_.erase(std::remove(workers_.begin(), workers_.end(), worker(ip, port)),
+                 workers_.end());
   if (lock) {
     workers_mutex_.unlock();
   }
 }
 
+int LoadBalancer::getWorkersCount()
+{
+  std::lock_guard<std::mutex> lock(workers_mutex_);
+  return workers_.size();
+}
+
 void LoadBalancer::lookUpWorkers(const char* domain, unsigned short port)
 {
   asio::io_service ios;
@@ -206,7 +223,7 @@ void LoadBalancer::lookUpWorkers(const char* domain, unsigned short port)
     int new_workers_count = 0;
     udp::resolver::iterator it_end;
     for (; it != it_end; ++it) {
-      auto discovered_worker = worker(it->endpoint().address(), port, 0);
+      auto discovered_worker = worker(it->endpoint().address(), port);
       if (std::find(workers_set.begin(), workers_set.end(), discovered_worker)
           == workers_set.end()) {
         workers_set.push_back(discovered_worker);
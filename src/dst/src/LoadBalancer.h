@@ -33,7 +33,7 @@
 #include <boost/thread/thread.hpp>
 #include <cstdint>
 #include <mutex>
-#include <queue>
+#include <tuple>
 #include <vector>
 
 #include "BalancerConnection.h"
@@ -58,41 +58,59 @@ class LoadBalancer
                unsigned short port = 1234);
   ~LoadBalancer();
   bool addWorker(const std::string& ip, unsigned short port);
-  void updateWorker(const ip::address& ip, unsigned short port);
-  void getNextWorker(ip::address& ip, unsigned short& port);
+  // Releases cost from the load of a worker once its job is done.
+  // This also clears the failures recorded on the worker.
+  void updateWorker(const ip::address& ip,
+                    unsigned short port,
+                    uint64_t cost = 1);
+  // Picks the least loaded healthy worker and charges cost to it.
+  void getNextWorker(ip::address& ip,
+                     unsigned short& port,
+                     uint64_t cost = 1);
   void removeWorker(const ip::address& ip,
                     unsigned short port,
                     bool lock = true);
-  void punishWorker(const ip::address& ip, unsigned short port);
+  // Records a failed job on a worker and releases its cost. Failing workers
+  // are chosen less often and are removed after MAX_WORKER_FAILURES
+  // consecutive failures.
+  void punishWorker(const ip::address& ip,
+                    unsigned short port,
+                    uint64_t cost = 0);
+  int getWorkersCount();
 
  private:
   struct worker
   {
     ip::address ip;
     unsigned short port;
-    unsigned short priority;
-    worker(ip::address ipIn, unsigned short portIn, unsigned short priorityIn)
-        : ip(ipIn), port(portIn), priority(priorityIn)
+    // Cost of the jobs assigned to the worker and not released yet.
+    uint64_t load{0};
+    uint32_t jobs{0};
+    uint32_t failures{0};
+    worker(ip::address ipIn, unsigned short portIn) : ip(ipIn), port(portIn)
     {
     }
     bool operator==(const worker& rhs) const
     {
-      return (ip == rhs.ip && port == rhs.port && priority == rhs.priority);
+      return (ip == rhs.ip && port == rhs.port);
     }
-  };
-  struct CompareWorker
-  {
-    bool operator()(worker const& w1, worker const& w2)
+    // Workers that failed recently are only used when all others failed
+    // too, then the least loaded worker is preferred.
+    bool operator<(const worker& rhs) const
     {
-      return w1.priority > w2.priority;
+      return std::tie(failures, load, jobs)
+             < std::tie(rhs.failures, rhs.load, rhs.jobs);
     }
   };
+  static constexpr uint32_t MAX_WORKER_FAILURES = 4;
+
+  worker* findWorker(const ip::address& ip, unsigned short port);
 
   Distributed* dist_;
   tcp::acceptor acceptor_;
   asio::io_service* service;
   utl::Logger* logger_;
-  std::priority_queue<worker, std::vector<worker>, CompareWorker> workers_;
+  std::vector<worker> workers_;
   std::mutex workers_mutex_;
   std::unique_ptr<asio::thread_pool> pool_;
   std::mutex pool_mutex_;
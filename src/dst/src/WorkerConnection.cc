@@ -57,10 +57,41 @@ tcp::socket& WorkerConnection::socket()
 
 void WorkerConnection::start()
 {
-  async_read_until(
+  asio::async_read(
       sock_,
-      in_packet_,
-      JobMessage::EOP,
+      asio::buffer(header_),
+      [me = shared_from_this()](boost::system::error_code const& ec,
+                                std::size_t bytes_xfer) {
+        me->handle_read_header(ec, bytes_xfer);
+      });
+}
+
+void WorkerConnection::handle_read_header(boost::system::error_code const& err,
+                                          size_t bytes_transferred)
+{
+  if (err) {
+    logger_->warn(utl::DST,
+                  45,
+                  "Worker conhandler failed with message: \"{}\"",
+                  err.message());
+    sock_.close();
+    return;
+  }
+  if (!JobMessage::decodeHeader(
+          header_.data(), bytes_transferred, frame_header_)) {
+    boost::system::error_code error;
+    logger_->warn(utl::DST,
+                  43,
+                  "Received malformed msg header from port {}",
+                  sock_.remote_endpoint().port());
+    asio::write(sock_, asio::buffer("0"), error);
+    sock_.close();
+    return;
+  }
+  payload_.resize(frame_header_.payload_size);
+  asio::async_read(
+      sock_,
+      asio::buffer(payload_),
       [me = shared_from_this()](boost::system::error_code const& ec,
                                 std::size_t bytes_xfer) {
         me->handle_read(ec, bytes_xfer);
@@ -71,19 +102,19 @@ void WorkerConnection::handle_read(boost::system::error_code const& err,
                                    size_t bytes_transferred)
 {
   if (!err) {
-    std::string data{buffers_begin(in_packet_.data()),
-                     buffers_begin(in_packet_.data()) + bytes_transferred};
     boost::system::error_code error;
-    if (!JobMessage::serializeMsg(JobMessage::READ, msg_, data)) {
+    if (!JobMessage::deserializeMsg(frame_header_, payload_.data(), msg_)) {
       logger_->warn(utl::DST,
                     41,
-                    "Received malformed msg {} from port {}",
-                    data,
+                    "Received malformed msg of {} bytes from port {}",
+                    bytes_transferred,
                     sock_.remote_endpoint().port());
       asio::write(sock_, asio::buffer("0"), error);
       sock_.close();
       return;
     }
+    // The payload is no longer needed once decoded.
+    std::vector<char>().swap(payload_);
     switch (msg_.getJobType()) {
       case JobMessage::ROUTING:
         for (auto& cb : dist_->getCallBacks()) {
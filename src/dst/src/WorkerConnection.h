@@ -29,9 +29,11 @@
 #pragma once
 #include <dst/JobMessage.h>
 
+#include <array>
 #include <boost/asio.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/make_shared.hpp>
+#include <vector>
 namespace asio = boost::asio;
 using asio::ip::tcp;
 namespace utl {
@@ -49,6 +51,8 @@ class WorkerConnection : public boost::enable_shared_from_this<WorkerConnection>
                    Worker* worker);
   tcp::socket& socket();
   void start();
+  void handle_read_header(boost::system::error_code const& err,
+                          size_t bytes_transferred);
   void handle_read(boost::system::error_code const& err,
                    size_t bytes_transferred);
   Worker* getWorker() const { return worker_; }
@@ -56,7 +60,9 @@ class WorkerConnection : public boost::enable_shared_from_this<WorkerConnection>
  private:
   tcp::socket sock_;
   Distributed* dist_;
-  asio::streambuf in_packet_;
+  std::array<char, JobMessage::HEADER_SIZE> header_;
+  JobMessage::FrameHeader frame_header_;
+  std::vector<char> payload_;
   utl::Logger* logger_;
   JobMessage msg_;
   Worker* worker_;
@@ -0,0 +1,91 @@
+// Loopback throughput benchmark for the dst message encodings.
+//
+// Usage: BenchJobMessage [jobs] [blob_bytes] [iterations]
+//
+// Each iteration sends one routing job holding `jobs` blobs of `blob_bytes`
+// to a local worker that echoes it back, so every round trip serializes and
+// parses the payload twice on each side.  It fails if any echoed payload
+// differs from the one sent; ctest runs it with a small payload.
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/serialization/export.hpp>
+#include <boost/thread/thread.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "EchoCallBack.h"
+#include "PayloadJobDescription.h"
+#include "Worker.h"
+#include "dst/Distributed.h"
+#include "dst/JobMessage.h"
+#include "utl/Logger.h"
+
+BOOST_CLASS_EXPORT(PayloadJobDescription)
+
+using namespace dst;
+
+int main(int argc, char* argv[])
+{
+  const int jobs = argc > 1 ? std::atoi(argv[1]) : 256;
+  const int blob_bytes = argc > 2 ? std::atoi(argv[2]) : 16384;
+  const int iterations = argc > 3 ? std::atoi(argv[3]) : 20;
+  const std::string local_ip = "127.0.0.1";
+  const unsigned short port = 1236;
+
+  Distributed* dist = new Distributed();
+  utl::Logger* logger = new utl::Logger();
+  dist->addCallBack(new EchoCallBack(dist));
+  Worker* worker = new Worker(dist, logger, local_ip.c_str(), port);
+  boost::thread t(boost::bind(&Worker::run, worker));
+  t.detach();
+
+  const auto workers = makePayload(jobs, blob_bytes);
+  const double payload_mb = double(jobs) * blob_bytes / (1024.0 * 1024.0);
+
+  struct Mode
+  {
+    const char* name;
+    JobMessage::Encoding encoding;
+    std::size_t compression_threshold;
+  };
+  const Mode modes[] = {{"text", JobMessage::TEXT, 0},
+                        {"binary", JobMessage::BINARY, 0},
+                        {"binary+zlib", JobMessage::BINARY, 1}};
+
+  std::printf("payload %.2f MB, %d iterations\n", payload_mb, iterations);
+  for (const Mode& mode : modes) {
+    JobMessage::setEncoding(mode.encoding);
+    JobMessage::setCompressionThreshold(mode.compression_threshold);
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+      JobMessage msg(JobMessage::ROUTING);
+      auto desc = std::make_unique<PayloadJobDescription>();
+      desc->setWorkers(workers);
+      msg.setJobDescription(std::move(desc));
+      JobMessage result;
+      if (!dist->sendJob(msg, local_ip.c_str(), port, result)) {
+        std::printf("%s: round trip failed\n", mode.name);
+        return 1;
+      }
+      auto result_desc
+          = dynamic_cast<PayloadJobDescription*>(result.getJobDescription());
+      if (result.getJobType() != JobMessage::SUCCESS || result_desc == nullptr
+          || result_desc->getWorkers() != workers) {
+        std::printf("%s: echoed payload differs\n", mode.name);
+        return 1;
+      }
+    }
+    const std::chrono::duration<double> elapsed
+        = std::chrono::steady_clock::now() - start;
+    std::printf("%-12s %8.3f s %10.1f MB/s\n",
+                mode.name,
+                elapsed.count(),
+                2 * payload_mb * iterations / elapsed.count());
+  }
+  return 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "PayloadJobDescription.h"
+#include "dst/Distributed.h"
+#include "dst/JobCallBack.h"
+#include "dst/JobMessage.h"
+
+// Replies to routing jobs with a copy of the received payload.
+class EchoCallBack : public dst::JobCallBack
+{
+ public:
+  EchoCallBack(dst::Distributed* dist) : dist_(dist) {}
+  void onRoutingJobReceived(dst::JobMessage& msg, dst::socket& sock) override
+  {
+    dst::JobMessage reply(dst::JobMessage::SUCCESS);
+    auto desc = static_cast<PayloadJobDescription*>(msg.getJobDescription());
+    if (desc != nullptr) {
+      auto reply_desc = std::make_unique<PayloadJobDescription>();
+      reply_desc->setWorkers(desc->getWorkers());
+      reply.setJobDescription(std::move(reply_desc));
+    }
+    dist_->sendResult(reply, sock);
+    sock.close();
+  }
+  void onFrDesignUpdated(dst::JobMessage& msg, dst::socket& sock) override {}
+  void onPinAccessJobReceived(dst::JobMessage& msg, dst::socket& sock) override
+  {
+  }
+  void onGRDRInitJobReceived(dst::JobMessage& msg, dst::socket& sock) override
+  {
+  }
+
+ private:
+  dst::Distributed* dist_;
+};
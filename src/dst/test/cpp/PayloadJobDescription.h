@@ -0,0 +1,53 @@
+#pragma once
+
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dst/JobMessage.h"
+
+// Job description shaped like the drt routing jobs: a list of (id, blob)
+// pairs, used to exercise the message encodings with realistic payloads.
+class PayloadJobDescription : public dst::JobDescription
+{
+ public:
+  void setWorkers(const std::vector<std::pair<int, std::string>>& workers)
+  {
+    workers_ = workers;
+  }
+  const std::vector<std::pair<int, std::string>>& getWorkers() const
+  {
+    return workers_;
+  }
+
+ private:
+  std::vector<std::pair<int, std::string>> workers_;
+
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int version)
+  {
+    (ar) & boost::serialization::base_object<dst::JobDescription>(*this);
+    (ar) & workers_;
+  }
+  friend class boost::serialization::access;
+};
+
+inline std::vector<std::pair<int, std::string>> makePayload(int count,
+                                                            int blob_size)
+{
+  std::vector<std::pair<int, std::string>> workers;
+  for (int i = 0; i < count; i++) {
+    std::string blob(blob_size, '\0');
+    for (int j = 0; j < blob_size; j++) {
+      // Mostly repetitive bytes, including ones that would have collided with
+      // a text packet delimiter.
+      blob[j] = static_cast<char>((j % 64 == 0) ? '\r' : (i + j / 16) & 0xff);
+    }
+    workers.emplace_back(i, std::move(blob));
+  }
+  return workers;
+}
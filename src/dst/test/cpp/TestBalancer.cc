@@ -7,6 +7,7 @@
 
 #include "HelperCallBack.h"
 #include "LoadBalancer.h"
+#include "dst/BalancerJobDescription.h"
 #include "dst/BroadcastJobDescription.h"
 #include "dst/Distributed.h"
 #include "dst/JobMessage.h"
@@ -107,4 +108,116 @@ BOOST_AUTO_TEST_CASE(test_default)
   // history i.e have invalid state.
   BOOST_TEST(balancer->addWorker(local_ip, worker_port_2) == false);
 }
+
+BOOST_AUTO_TEST_CASE(test_load_aware)
+{
+  utl::Logger* logger = new utl::Logger();
+  Distributed* dist = new Distributed(logger);
+  std::string local_ip = "127.0.0.1";
+  unsigned short balancer_port = 5565;
+  unsigned short worker_port_1 = 5566;
+  unsigned short worker_port_2 = 5567;
+  unsigned short worker_port_3 = 5568;
+  auto worker_ip = asio::ip::address::from_string(local_ip);
+  asio::io_service io_service;
+  LoadBalancer* balancer = new LoadBalancer(
+      dist, io_service, logger, local_ip.c_str(), "", balancer_port);
+  balancer->addWorker(local_ip, worker_port_1);
+  balancer->addWorker(local_ip, worker_port_2);
+  balancer->addWorker(local_ip, worker_port_3);
+  asio::ip::address address;
+  unsigned short port;
+
+  // An expensive job keeps its worker busy while cheap ones go elsewhere.
+  balancer->getNextWorker(address, port, 100);
+  BOOST_TEST(port == worker_port_1);
+  balancer->getNextWorker(address, port, 10);
+  BOOST_TEST(port == worker_port_2);
+  balancer->getNextWorker(address, port, 10);
+  BOOST_TEST(port == worker_port_3);
+  balancer->getNextWorker(address, port, 10);
+  BOOST_TEST(port == worker_port_2);
+  balancer->getNextWorker(address, port, 10);
+  BOOST_TEST(port == worker_port_3);
+
+  // Releasing the expensive job makes its worker the least loaded one.
+  balancer->updateWorker(worker_ip, worker_port_1, 100);
+  balancer->getNextWorker(address, port, 10);
+  BOOST_TEST(port == worker_port_1);
+
+  // A failing worker is avoided, and dropped after repeated failures.
+  balancer->punishWorker(worker_ip, worker_port_1);
+  balancer->getNextWorker(address, port, 1);
+  BOOST_TEST(port != worker_port_1);
+  for (int i = 1; i < 4; i++) {
+    balancer->punishWorker(worker_ip, worker_port_1);
+  }
+  BOOST_TEST(balancer->getWorkersCount() == 2);
+
+  // Jobs relayed through the balancer are retried on another worker when
+  // the first one is not reachable.
+  balancer->updateWorker(worker_ip, worker_port_2, 21);
+  dist->addCallBack(new HelperCallBack(dist));
+  dist->runWorker(local_ip.c_str(), worker_port_3, true);
+  boost::thread t(boost::bind(&asio::io_service::run, &io_service));
+  t.detach();
+  for (int i = 0; i < 4; i++) {
+    JobMessage msg(JobMessage::JobType::ROUTING);
+    JobMessage result;
+    BOOST_TEST(dist->sendJob(msg, local_ip.c_str(), balancer_port, result));
+    BOOST_TEST(result.getJobType() == JobMessage::JobType::SUCCESS);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_release)
+{
+  utl::Logger* logger = new utl::Logger();
+  Distributed* dist = new Distributed(logger);
+  std::string local_ip = "127.0.0.1";
+  unsigned short balancer_port = 5575;
+  unsigned short worker_port_1 = 5576;
+  unsigned short worker_port_2 = 5577;
+  asio::io_service io_service;
+  LoadBalancer* balancer = new LoadBalancer(
+      dist, io_service, logger, local_ip.c_str(), "", balancer_port);
+  balancer->addWorker(local_ip, worker_port_1);
+  balancer->addWorker(local_ip, worker_port_2);
+  boost::thread t(boost::bind(&asio::io_service::run, &io_service));
+  t.detach();
+
+  auto request = [&](BalancerJobDescription::Action action,
+                     unsigned short port,
+                     uint64_t cost) {
+    JobMessage msg(JobMessage::JobType::BALANCER);
+    auto desc = std::make_unique<BalancerJobDescription>();
+    desc->setWorkerIP(local_ip);
+    desc->setWorkerPort(port);
+    desc->setCost(cost);
+    desc->setAction(action);
+    msg.setJobDescription(std::move(desc));
+    JobMessage result;
+    BOOST_TEST(dist->sendJob(msg, local_ip.c_str(), balancer_port, result));
+    BOOST_TEST(result.getJobType() == JobMessage::JobType::SUCCESS);
+    auto reply = dynamic_cast<BalancerJobDescription*>(
+        result.getJobDescription());
+    return reply != nullptr ? reply->getWorkerPort() : 0;
+  };
+
+  // Jobs the leader runs directly on an assigned worker keep it loaded
+  // until they are released.
+  BOOST_TEST(request(BalancerJobDescription::ASSIGN, 0, 100)
+             == worker_port_1);
+  BOOST_TEST(request(BalancerJobDescription::ASSIGN, 0, 10)
+             == worker_port_2);
+  BOOST_TEST(request(BalancerJobDescription::ASSIGN, 0, 10)
+             == worker_port_2);
+  request(BalancerJobDescription::RELEASE, worker_port_1, 100);
+  BOOST_TEST(request(BalancerJobDescription::ASSIGN, 0, 10)
+             == worker_port_1);
+
+  // A lost job releases its cost but the worker is avoided.
+  request(BalancerJobDescription::FAIL, worker_port_1, 10);
+  BOOST_TEST(request(BalancerJobDescription::ASSIGN, 0, 10)
+             == worker_port_2);
+}
 BOOST_AUTO_TEST_SUITE_END()
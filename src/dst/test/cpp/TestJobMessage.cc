@@ -0,0 +1,122 @@
+#define BOOST_TEST_MODULE TestJobMessage
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/asio.hpp>
+#include <boost/serialization/export.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/thread/thread.hpp>
+#include <string>
+
+#include "EchoCallBack.h"
+#include "PayloadJobDescription.h"
+#include "Worker.h"
+#include "dst/Distributed.h"
+#include "dst/JobMessage.h"
+#include "utl/Logger.h"
+
+BOOST_CLASS_EXPORT(PayloadJobDescription)
+
+using namespace dst;
+
+namespace {
+
+const std::string local_ip = "127.0.0.1";
+const unsigned short port = 1235;
+
+struct WorkerFixture
+{
+  WorkerFixture()
+  {
+    dist = new Distributed();
+    logger = new utl::Logger();
+    dist->addCallBack(new EchoCallBack(dist));
+    worker = new Worker(dist, logger, local_ip.c_str(), port);
+    boost::thread t(boost::bind(&Worker::run, worker));
+    t.detach();
+  }
+  Distributed* dist;
+  utl::Logger* logger;
+  Worker* worker;
+};
+
+void roundTrip(Distributed* dist,
+               JobMessage::Encoding encoding,
+               std::size_t threshold)
+{
+  JobMessage::setEncoding(encoding);
+  JobMessage::setCompressionThreshold(threshold);
+
+  const auto workers = makePayload(16, 4096);
+  JobMessage msg(JobMessage::ROUTING);
+  auto desc = std::make_unique<PayloadJobDescription>();
+  desc->setWorkers(workers);
+  msg.setJobDescription(std::move(desc));
+
+  JobMessage result;
+  BOOST_TEST(dist->sendJob(msg, local_ip.c_str(), port, result));
+  BOOST_TEST(result.getJobType() == JobMessage::SUCCESS);
+  auto result_desc
+      = dynamic_cast<PayloadJobDescription*>(result.getJobDescription());
+  BOOST_TEST_REQUIRE(result_desc != nullptr);
+  BOOST_TEST((result_desc->getWorkers() == workers));
+}
+
+void expectRejected(const std::string& packet)
+{
+  asio::io_service io_service;
+  tcp::socket sock(io_service);
+  sock.connect(tcp::endpoint(asio::ip::address::from_string(local_ip), port));
+  asio::write(sock, asio::buffer(packet));
+  asio::streambuf reply;
+  boost::system::error_code error;
+  asio::read(sock, reply, asio::transfer_all(), error);
+  BOOST_TEST(std::string(asio::buffers_begin(reply.data()),
+                         asio::buffers_end(reply.data()))
+                 .front()
+             == '0');
+}
+
+// A well formed uncompressed frame header announcing size payload bytes.
+std::string frameHeader(uint64_t size)
+{
+  std::string header = {'D', 'S', 'T', 'M', 1, JobMessage::BINARY, 0, 0};
+  for (int i = 0; i < 2; i++) {
+    for (int byte = 0; byte < 8; byte++) {
+      header.push_back(static_cast<char>((size >> (8 * byte)) & 0xff));
+    }
+  }
+  return header;
+}
+
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(test_suite, WorkerFixture)
+
+BOOST_AUTO_TEST_CASE(test_encodings)
+{
+  roundTrip(dist, JobMessage::BINARY, 0);
+  roundTrip(dist, JobMessage::TEXT, 0);
+  roundTrip(dist, JobMessage::BINARY, 1);
+  roundTrip(dist, JobMessage::TEXT, 1);
+  JobMessage::setEncoding(JobMessage::BINARY);
+  JobMessage::setCompressionThreshold(0);
+
+  // A packet without a valid frame header is rejected by the worker.
+  expectRejected(std::string(64, 'x'));
+
+  // So is a well formed header announcing a huge payload, before the
+  // worker allocates anything for it.
+  expectRejected(frameHeader(uint64_t(1) << 40));
+  expectRejected(frameHeader(JobMessage::DEFAULT_MAX_FRAME_SIZE + 1));
+
+  // The limit is configurable.
+  JobMessage::setMaxFrameSize(1024);
+  expectRejected(frameHeader(1025));
+  JobMessage::setMaxFrameSize(JobMessage::DEFAULT_MAX_FRAME_SIZE);
+  roundTrip(dist, JobMessage::BINARY, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -50,7 +50,11 @@ class Finale
  public:
   void init(odb::dbDatabase* db, Logger* logger);
 
-  void densityFill(const char* rules_filename, const odb::Rect& fill_area);
+  // tile_size is in dbu; zero fills the area as a single tile.
+  void densityFill(const char* rules_filename,
+                   const odb::Rect& fill_area,
+                   int tile_size = 0,
+                   bool report_density = false);
 
   void setDebug();
 
@@ -38,6 +38,7 @@
 
 #include "graphics.h"
 #include "odb/dbShape.h"
+#include "utl/ThreadPool.h"
 
 namespace fin {
 
@@ -57,6 +58,31 @@ struct DensityFillShapesConfig
   int space_line_end;
 };
 
+// The fills found for one tile of a layer
+struct TileFill
+{
+  struct Shape
+  {
+    Rect rect;
+    int mask;
+    bool needs_opc;
+  };
+  std::vector<Shape> fills;
+  int non_opc_areas = 0;
+  int opc_areas = 0;
+  // only computed for density reporting
+  int64_t non_fill_area = 0;
+  int64_t fill_area = 0;
+};
+
+// The block objects with shapes near a tile
+struct TileObjects
+{
+  std::vector<dbWire*> wires;
+  std::vector<dbSBox*> sboxes;
+  std::vector<dbInst*> insts;
+};
+
 // The rules for a layer from the JSON config
 struct DensityFillLayerConfig
 {
@@ -203,11 +229,24 @@ void DensityFill::loadConfig(const char* cfg_filename, dbTech* tech)
   readAndExpandLayers(tech, tree);
 }
 
-// Insert into polygon_set any part of given shape on the given layer (shape may
-// be a via)
+// Add rect to the non-fill shapes of layer if layer is being filled and
+// rect is within window
+static void addNonFill(dbTechLayer* layer,
+                       const Rect& rect,
+                       const Rect& window,
+                       std::map<dbTechLayer*, std::vector<Rect>>& non_fills)
+{
+  auto it = non_fills.find(layer);
+  if (it != non_fills.end() && rect.overlaps(window)) {
+    it->second.push_back(rect);
+  }
+}
+
+// Add the parts of the given shape on the filled layers within window
+// (shape may be a via)
 static void insertShape(const dbShape& shape,
-                        Polygon90Set& polygon_set,
-                        dbTechLayer* layer)
+                        const Rect& window,
+                        std::map<dbTechLayer*, std::vector<Rect>>& non_fills)
 {
   auto type = shape.getType();
   switch (type) {
@@ -225,84 +264,153 @@ static void insertShape(const dbShape& shape,
         bottom = via->getBottomLayer();
       }
 
-      if (top != layer && bottom != layer) {
+      if ((non_fills.find(top) == non_fills.end()
+           && non_fills.find(bottom) == non_fills.end())
+          || !shape.getBox().overlaps(window)) {
         return;
       }
       std::vector<dbShape> boxes;
       dbShape::getViaBoxes(shape, boxes);
       for (auto& box : boxes) {
-        if (box.getTechLayer() == layer) {
-          polygon_set.insert(
-              makeRect(box.xMin(), box.yMin(), box.xMax(), box.yMax()));
+        dbTechLayer* layer = box.getTechLayer();
+        if (layer == top || layer == bottom) {
+          addNonFill(layer, box.getBox(), window, non_fills);
         }
       }
       break;
     }
     case dbShape::SEGMENT:
-      if (shape.getTechLayer() == layer) {
-        polygon_set.insert(
-            makeRect(shape.xMin(), shape.yMin(), shape.xMax(), shape.yMax()));
-      }
-      break;
     case dbShape::TECH_VIA_BOX:
     case dbShape::VIA_BOX:
-      if (shape.getTechLayer() == layer) {
-        polygon_set.insert(
-            makeRect(shape.xMin(), shape.yMin(), shape.xMax(), shape.yMax()));
-      }
+      addNonFill(shape.getTechLayer(), shape.getBox(), window, non_fills);
       break;
   }
 }
 
-// Build a polygon set out of all the non-fill shape on the given layer
-// including wires, special wires, and instances' pins & OBS
-static Polygon90Set orNonFills(dbBlock* block, dbTechLayer* layer)
+// The extent of all the pin and obstruction shapes of a master, which may
+// reach outside its boundary
+static Rect masterShapesBBox(dbMaster* master)
 {
-  Polygon90Set non_fill;  // The result
-  dbShape shape;          // Shared temp
+  Rect bbox;
+  master->getPlacementBoundary(bbox);
+  for (dbMTerm* mterm : master->getMTerms()) {
+    for (dbMPin* mpin : mterm->getMPins()) {
+      bbox.merge(mpin->getBBox());
+    }
+  }
+  for (dbBox* obs : master->getObstructions()) {
+    bbox.merge(obs->getBox());
+  }
+  return bbox;
+}
 
-  // Get shapes from regular wires
-  dbWireShapeItr shapes;
-  for (auto net : block->getNets()) {
+// Record which wires, special wire boxes and instances have shapes within
+// halo of each tile.  Only the objects are recorded so the memory used
+// doesn't grow with the number of shapes.
+std::vector<TileObjects> DensityFill::findTileObjects(dbBlock* block,
+                                                      const Rect& fill_area,
+                                                      int tile_size,
+                                                      int num_x,
+                                                      int num_y,
+                                                      int halo)
+{
+  std::vector<TileObjects> tile_objects(num_x * num_y);
+  auto for_tiles = [&](const Rect& bbox, auto add) {
+    Rect rect;
+    bbox.bloat(halo + 1, rect);
+    if (!rect.overlaps(fill_area)) {
+      return;
+    }
+    auto tile_index = [&](int coord, int origin, int count) {
+      return std::clamp((coord - origin) / tile_size, 0, count - 1);
+    };
+    const int x_lo = tile_index(rect.xMin(), fill_area.xMin(), num_x);
+    const int x_hi = tile_index(rect.xMax(), fill_area.xMin(), num_x);
+    const int y_lo = tile_index(rect.yMin(), fill_area.yMin(), num_y);
+    const int y_hi = tile_index(rect.yMax(), fill_area.yMin(), num_y);
+    for (int iy = y_lo; iy <= y_hi; iy++) {
+      for (int ix = x_lo; ix <= x_hi; ix++) {
+        add(tile_objects[iy * num_x + ix]);
+      }
+    }
+  };
+
+  for (dbNet* net : block->getNets()) {
     dbWire* wire = net->getWire();
-    if (!wire) {
-      continue;
+    if (wire) {
+      if (auto bbox = wire->getBBox()) {
+        for_tiles(*bbox,
+                  [=](TileObjects& objs) { objs.wires.push_back(wire); });
+      }
+    }
+    for (dbSWire* swire : net->getSWires()) {
+      for (dbSBox* sbox : swire->getWires()) {
+        for_tiles(sbox->getBox(),
+                  [=](TileObjects& objs) { objs.sboxes.push_back(sbox); });
+      }
     }
+  }
+
+  std::map<dbMaster*, Rect> master_bboxes;
+  for (dbInst* inst : block->getInsts()) {
+    dbMaster* master = inst->getMaster();
+    auto it = master_bboxes.find(master);
+    if (it == master_bboxes.end()) {
+      it = master_bboxes.emplace(master, masterShapesBBox(master)).first;
+    }
+    Rect bbox = it->second;
+    inst->getTransform().apply(bbox);
+    for_tiles(bbox, [=](TileObjects& objs) { objs.insts.push_back(inst); });
+  }
+
+  return tile_objects;
+}
+
+// Collect the non-fill shapes on the filled layers within window,
+// including wires, special wires, and instances' pins & OBS.
+DensityFill::LayerShapes DensityFill::collectNonFills(
+    const TileObjects& objects,
+    const Rect& window)
+{
+  LayerShapes non_fills;  // The result
+  for (const auto& [layer, cfg] : layers_) {
+    non_fills[layer];
+  }
+  dbShape shape;  // Shared temp
+
+  // Get shapes from regular wires
+  dbWireShapeItr shapes;
+  for (dbWire* wire : objects.wires) {
     for (shapes.begin(wire); shapes.next(shape);) {
-      insertShape(shape, non_fill, layer);
+      insertShape(shape, window, non_fills);
     }
   }
 
   // Get shapes from special wires
   std::vector<dbShape> via_shapes;
-  for (auto net : block->getNets()) {
-    for (auto swire : net->getSWires()) {
-      for (auto sbox : swire->getWires()) {
-        if (sbox->isVia()) {
-          dbVia* via = sbox->getBlockVia();
-          Rect rect = sbox->getBox();
-          shape.setVia(via, rect);
-          dbShape::getViaBoxes(shape, via_shapes);
-          for (auto& via_shape : via_shapes) {
-            insertShape(via_shape, non_fill, layer);
-          }
-        } else if (sbox->getTechLayer() == layer) {
-          non_fill.insert(
-              makeRect(sbox->xMin(), sbox->yMin(), sbox->xMax(), sbox->yMax()));
-        }
+  for (dbSBox* sbox : objects.sboxes) {
+    if (sbox->isVia()) {
+      dbVia* via = sbox->getBlockVia();
+      Rect rect = sbox->getBox();
+      shape.setVia(via, rect);
+      dbShape::getViaBoxes(shape, via_shapes);
+      for (auto& via_shape : via_shapes) {
+        insertShape(via_shape, window, non_fills);
       }
+    } else {
+      addNonFill(sbox->getTechLayer(), sbox->getBox(), window, non_fills);
     }
   }
 
   // Get shapes from instances
   dbInstShapeItr insts(/* expand_vias */ false);
-  for (auto inst : block->getInsts()) {
+  for (dbInst* inst : objects.insts) {
     for (insts.begin(inst, dbInstShapeItr::ALL); insts.next(shape);) {
-      insertShape(shape, non_fill, layer);
+      insertShape(shape, window, non_fills);
     }
   }
 
-  return non_fill;
+  return non_fills;
 }
 
 static std::pair<int, int> getSpacing(dbTechLayer* layer,
@@ -342,15 +450,16 @@ static void prune(Polygon90Set& fill_area,
 }
 
 // Fill a polygon (area) on the given layer using the given configuration.
-// Num_masks is used to color the generated fills.
+// Num_masks is used to color the generated fills which are added to
+// fills_out.
 // filled_area, if given, is an OR of the generated fills without bloating
 static void fillPolygon(const Polygon90& area,
                         dbTechLayer* layer,
-                        dbBlock* block,
                         const DensityFillShapesConfig& cfg,
                         int num_masks,
                         bool needs_opc,
                         Graphics* graphics,
+                        std::vector<TileFill::Shape>& fills_out,
                         Polygon90Set* filled_area = nullptr)
 {
   // Convert the area polygon to a polygon set as we will remove areas
@@ -431,7 +540,7 @@ static void fillPolygon(const Polygon90& area,
         auto y_lo = yl(f);
         auto x_hi = xh(f);
         auto y_hi = yh(f);
-        dbFill::create(block, needs_opc, mask, layer, x_lo, y_lo, x_hi, y_hi);
+        fills_out.push_back({Rect(x_lo, y_lo, x_hi, y_hi), mask, needs_opc});
         if (filled_area) {
           *filled_area += makeRect(x_lo, y_lo, x_hi, y_hi);
         }
@@ -442,21 +551,29 @@ static void fillPolygon(const Polygon90& area,
   }
 }
 
-// Fill the given layer
-void DensityFill::fillLayer(dbBlock* block,
-                            dbTechLayer* layer,
-                            const odb::Rect& fill_bounds_rect)
+// Fill the part of a layer within fill_region.  tile is fill_region before
+// it was shrunk away from the neighboring tiles.  non_fills are the
+// non-fill shapes near the tile.
+void DensityFill::fillTile(dbTechLayer* layer,
+                           const Rect& tile,
+                           const Rect& fill_region,
+                           const std::vector<Rect>& non_fills,
+                           bool report_density,
+                           Graphics* graphics,
+                           TileFill& result)
 {
-  logger_->info(FIN, 3, "Filling layer {}.", layer->getConstName());
-
-  Polygon90Set non_fill = orNonFills(block, layer);
+  Polygon90Set non_fill;
+  for (const Rect& rect : non_fills) {
+    non_fill.insert(
+        makeRect(rect.xMin(), rect.yMin(), rect.xMax(), rect.yMax()));
+  }
 
-  auto fill_bounds = makeRect(fill_bounds_rect.xMin(),
-                              fill_bounds_rect.yMin(),
-                              fill_bounds_rect.xMax(),
-                              fill_bounds_rect.yMax());
+  auto fill_bounds = makeRect(fill_region.xMin(),
+                              fill_region.yMin(),
+                              fill_region.xMax(),
+                              fill_region.yMax());
 
-  const DensityFillLayerConfig& cfg = layers_[layer];
+  const DensityFillLayerConfig& cfg = layers_.at(layer);
 
   std::vector<Polygon90> polygons;
 
@@ -464,62 +581,88 @@ void DensityFill::fillLayer(dbBlock* block,
   Polygon90Set fill_area
       = fill_bounds - (non_fill + cfg.non_opc.space_to_non_fill);
 
-  if (graphics_) {
-    graphics_->status("Non-OPC Area");
-    graphics_->drawPolygon90Set(fill_area);
+  if (graphics) {
+    graphics->status("Non-OPC Area");
+    graphics->drawPolygon90Set(fill_area);
   }
 
-  prune(fill_area, layer, cfg.non_opc, graphics_.get());
+  prune(fill_area, layer, cfg.non_opc, graphics);
 
   fill_area.get(polygons);
-  logger_->info(FIN, 9, "Filling {} areas with non-OPC fill.", polygons.size());
+  result.non_opc_areas = polygons.size();
 
   Polygon90Set non_opc_fill_area;
   for (auto& polygon : polygons) {
     fillPolygon(polygon,
                 layer,
-                block,
                 cfg.non_opc,
                 cfg.num_masks,
                 false,
-                graphics_.get(),
+                graphics,
+                result.fills,
                 &non_opc_fill_area);
   }
-  logger_->info(FIN, 4, "Total fills: {}.", block->getFills().size());
 
-  if (!cfg.has_opc) {
-    return;
-  }
-
-  Polygon90Set opc_fill_area
-      = fill_bounds - (non_fill + cfg.opc.space_to_non_fill)
-        - (non_opc_fill_area + cfg.non_opc.space_to_fill);
+  if (cfg.has_opc) {
+    Polygon90Set opc_fill_area
+        = fill_bounds - (non_fill + cfg.opc.space_to_non_fill)
+          - (non_opc_fill_area + cfg.non_opc.space_to_fill);
 
-  if (graphics_) {
-    graphics_->status("OPC Area");
-    graphics_->drawPolygon90Set(opc_fill_area);
-  }
+    if (graphics) {
+      graphics->status("OPC Area");
+      graphics->drawPolygon90Set(opc_fill_area);
+    }
 
-  prune(opc_fill_area, layer, cfg.opc, graphics_.get());
+    prune(opc_fill_area, layer, cfg.opc, graphics);
+
+    polygons.clear();
+    opc_fill_area.get(polygons);
+    result.opc_areas = polygons.size();
+    for (auto& polygon : polygons) {
+      fillPolygon(polygon,
+                  layer,
+                  cfg.opc,
+                  cfg.num_masks,
+                  true,
+                  graphics,
+                  result.fills);
+    }
 
-  polygons.clear();
-  opc_fill_area.get(polygons);
-  logger_->info(FIN, 5, "Filling {} areas with OPC fill.", polygons.size());
-  for (auto& polygon : polygons) {
-    fillPolygon(
-        polygon, layer, block, cfg.opc, cfg.num_masks, true, graphics_.get());
+    if (graphics) {
+      graphics->status("OPC Area");
+      graphics->drawPolygon90Set(opc_fill_area);
+    }
   }
 
-  logger_->info(FIN, 6, "Total fills: {}.", block->getFills().size());
-
-  if (graphics_) {
-    graphics_->status("OPC Area");
-    graphics_->drawPolygon90Set(opc_fill_area);
+  if (report_density) {
+    non_fill &= makeRect(tile.xMin(), tile.yMin(), tile.xMax(), tile.yMax());
+    result.non_fill_area = boost::polygon::area(non_fill);
+    for (const auto& fill : result.fills) {
+      result.fill_area += fill.rect.area();
+    }
   }
 }
 
+void DensityFill::reportDensity(dbTechLayer* layer,
+                                int num_tiles,
+                                const LayerFillStats& stats)
+{
+  logger_->info(FIN,
+                11,
+                "Layer {} density over {} tiles: min {:.1f}% max {:.1f}% "
+                "average {:.1f}%.",
+                layer->getConstName(),
+                num_tiles,
+                100 * stats.min_density,
+                100 * stats.max_density,
+                100 * stats.total_density / num_tiles);
+}
+
 // Fill the design according to the given cfg file
-void DensityFill::fill(const char* cfg_filename, const odb::Rect& fill_area)
+void DensityFill::fill(const char* cfg_filename,
+                       const odb::Rect& fill_area,
+                       int tile_size,
+                       bool report_density)
 {
   dbTech* tech = db_->getTech();
   loadConfig(cfg_filename, tech);
@@ -527,13 +670,174 @@ void DensityFill::fill(const char* cfg_filename, const odb::Rect& fill_area)
   dbChip* chip = db_->getChip();
   dbBlock* block = chip->getBlock();
 
+  std::vector<dbTechLayer*> fill_layers;
   for (dbTechLayer* layer : tech->getLayers()) {
-    auto it = layers_.find(layer);
-    if (it == layers_.end()) {
+    if (layers_.find(layer) != layers_.end()) {
+      fill_layers.push_back(layer);
+    }
+  }
+  const int num_layers = fill_layers.size();
+
+  // Split the fill area into tiles (row major)
+  if (tile_size <= 0) {
+    tile_size = std::max(fill_area.dx(), fill_area.dy());
+  }
+  tile_size = std::max(tile_size, 1);
+  const int num_x = std::max(1, (fill_area.dx() + tile_size - 1) / tile_size);
+  const int num_y = std::max(1, (fill_area.dy() + tile_size - 1) / tile_size);
+  std::vector<Rect> tiles;
+  tiles.reserve(num_x * num_y);
+  for (int iy = 0; iy < num_y; iy++) {
+    for (int ix = 0; ix < num_x; ix++) {
+      const int x_lo = fill_area.xMin() + ix * tile_size;
+      const int y_lo = fill_area.yMin() + iy * tile_size;
+      tiles.emplace_back(x_lo,
+                         y_lo,
+                         std::min(x_lo + tile_size, fill_area.xMax()),
+                         std::min(y_lo + tile_size, fill_area.yMax()));
+    }
+  }
+  const int num_tiles = tiles.size();
+
+  // A tile sees the non-fill shapes within a halo around it.  Where a tile
+  // meets another tile its fill region is pulled back by half the fill
+  // spacing so fills from neighboring tiles can't be too close.
+  int halo = 0;
+  std::vector<int> insets(num_layers);
+  for (int li = 0; li < num_layers; li++) {
+    const DensityFillLayerConfig& cfg = layers_[fill_layers[li]];
+    halo = std::max(halo, cfg.non_opc.space_to_non_fill);
+    int spacing
+        = std::max(cfg.non_opc.space_to_fill, cfg.non_opc.space_line_end);
+    if (cfg.has_opc) {
+      halo = std::max(halo, cfg.opc.space_to_non_fill);
+      spacing = std::max(
+          {spacing, cfg.opc.space_to_fill, cfg.opc.space_line_end});
+    }
+    insets[li] = (spacing + 1) / 2;
+  }
+  auto fill_region = [&](const Rect& tile, int inset) {
+    Rect region = tile;
+    if (region.xMin() > fill_area.xMin()) {
+      region.set_xlo(region.xMin() + inset);
+    }
+    if (region.yMin() > fill_area.yMin()) {
+      region.set_ylo(region.yMin() + inset);
+    }
+    if (region.xMax() < fill_area.xMax()) {
+      region.set_xhi(region.xMax() - inset);
+    }
+    if (region.yMax() < fill_area.yMax()) {
+      region.set_yhi(region.yMax() - inset);
+    }
+    return region;
+  };
+
+  const std::vector<TileObjects> tile_objects
+      = findTileObjects(block, fill_area, tile_size, num_x, num_y, halo);
+
+  // Tiles are filled in batches of one tile per thread and each batch's
+  // fills are created in the db, in tile then layer order, before the next
+  // batch starts.  Only a batch's non-fill shapes and fills are held in
+  // memory and the result doesn't depend on thread timing.  Graphics is not
+  // thread safe so it forces one tile at a time.
+  const int batch_size
+      = graphics_ ? 1 : std::max(1, utl::ThreadPool::global().getThreadCount());
+  std::vector<LayerFillStats> stats(num_layers);
+  const int initial_fills = block->getFills().size();
+  std::vector<LayerShapes> batch_non_fills;
+  std::vector<TileFill> batch_results;
+  for (int first = 0; first < num_tiles; first += batch_size) {
+    const int last = std::min(first + batch_size, num_tiles);
+
+    batch_non_fills.clear();
+    for (int t = first; t < last; t++) {
+      Rect window;
+      tiles[t].bloat(halo, window);
+      batch_non_fills.push_back(collectNonFills(tile_objects[t], window));
+    }
+
+    batch_results.assign((last - first) * num_layers, TileFill());
+    auto fill_job = [&](int job) {
+      const int t = first + job / num_layers;
+      const int li = job % num_layers;
+      const Rect region = fill_region(tiles[t], insets[li]);
+      if (region.xMin() >= region.xMax() || region.yMin() >= region.yMax()) {
+        return;
+      }
+      dbTechLayer* layer = fill_layers[li];
+      fillTile(layer,
+               tiles[t],
+               region,
+               batch_non_fills[t - first].at(layer),
+               report_density,
+               graphics_.get(),
+               batch_results[job]);
+    };
+    if (graphics_) {
+      for (int job = 0; job < batch_results.size(); job++) {
+        fill_job(job);
+      }
+    } else {
+      utl::ThreadPool::global().parallelFor(
+          0, batch_results.size(), fill_job);
+    }
+
+    for (int job = 0; job < batch_results.size(); job++) {
+      const int t = first + job / num_layers;
+      const int li = job % num_layers;
+      const TileFill& result = batch_results[job];
+      LayerFillStats& layer_stats = stats[li];
+      layer_stats.non_opc_areas += result.non_opc_areas;
+      layer_stats.opc_areas += result.opc_areas;
+      for (const auto& fill : result.fills) {
+        const Rect& rect = fill.rect;
+        dbFill::create(block,
+                       fill.needs_opc,
+                       fill.mask,
+                       fill_layers[li],
+                       rect.xMin(),
+                       rect.yMin(),
+                       rect.xMax(),
+                       rect.yMax());
+        (fill.needs_opc ? layer_stats.opc_fills : layer_stats.non_opc_fills)++;
+      }
+      const double density
+          = static_cast<double>(result.non_fill_area + result.fill_area)
+            / tiles[t].area();
+      layer_stats.min_density = std::min(layer_stats.min_density, density);
+      layer_stats.max_density = std::max(layer_stats.max_density, density);
+      layer_stats.total_density += density;
+    }
+  }
+
+  // Report in layer order
+  int total_fills = initial_fills;
+  int li = 0;
+  for (dbTechLayer* layer : tech->getLayers()) {
+    if (li == num_layers || layer != fill_layers[li]) {
       logger_->warn(FIN, 10, "Skipping layer {}.", layer->getConstName());
       continue;
     }
-    fillLayer(block, layer, fill_area);
+    const LayerFillStats& layer_stats = stats[li];
+    logger_->info(FIN, 3, "Filling layer {}.", layer->getConstName());
+    logger_->info(FIN,
+                  9,
+                  "Filling {} areas with non-OPC fill.",
+                  layer_stats.non_opc_areas);
+    total_fills += layer_stats.non_opc_fills;
+    logger_->info(FIN, 4, "Total fills: {}.", total_fills);
+    if (layers_[layer].has_opc) {
+      logger_->info(
+          FIN, 5, "Filling {} areas with OPC fill.", layer_stats.opc_areas);
+      total_fills += layer_stats.opc_fills;
+      logger_->info(FIN, 6, "Total fills: {}.", total_fills);
+    }
+
+    if (report_density) {
+      reportDensity(layer, num_tiles, layer_stats);
+    }
+    li++;
   }
 }
 
@@ -43,6 +43,8 @@
 namespace fin {
 
 struct DensityFillLayerConfig;
+struct TileFill;
+struct TileObjects;
 class Graphics;
 
 ////////////////////////////////////////////////////////////////
@@ -60,15 +62,50 @@ class DensityFill
   DensityFill(const DensityFill&&) = delete;
   DensityFill& operator=(const DensityFill&&) = delete;
 
-  void fill(const char* cfg_filename, const odb::Rect& fill_area);
+  // The fill area is split into tiles of tile_size (dbu) that are filled
+  // in parallel.  A tile_size of zero fills the whole area as one tile.
+  void fill(const char* cfg_filename,
+            const odb::Rect& fill_area,
+            int tile_size = 0,
+            bool report_density = false);
 
  private:
+  using LayerShapes = std::map<odb::dbTechLayer*, std::vector<odb::Rect>>;
+
+  // Totals over the tiles of a layer
+  struct LayerFillStats
+  {
+    int non_opc_areas = 0;
+    int opc_areas = 0;
+    int non_opc_fills = 0;
+    int opc_fills = 0;
+    // only meaningful for density reporting
+    double min_density = 1.0;
+    double max_density = 0.0;
+    double total_density = 0.0;
+  };
+
   void loadConfig(const char* cfg_filename, odb::dbTech* tech);
   void readAndExpandLayers(odb::dbTech* tech,
                            boost::property_tree::ptree& tree);
-  void fillLayer(odb::dbBlock* block,
-                 odb::dbTechLayer* layer,
-                 const odb::Rect& fill_bounds);
+  std::vector<TileObjects> findTileObjects(odb::dbBlock* block,
+                                           const odb::Rect& fill_area,
+                                           int tile_size,
+                                           int num_x,
+                                           int num_y,
+                                           int halo);
+  LayerShapes collectNonFills(const TileObjects& objects,
+                              const odb::Rect& window);
+  void fillTile(odb::dbTechLayer* layer,
+                const odb::Rect& tile,
+                const odb::Rect& fill_region,
+                const std::vector<odb::Rect>& non_fills,
+                bool report_density,
+                Graphics* graphics,
+                TileFill& result);
+  void reportDensity(odb::dbTechLayer* layer,
+                     int num_tiles,
+                     const LayerFillStats& stats);
 
   odb::dbDatabase* db_;
   std::map<odb::dbTechLayer*, DensityFillLayerConfig> layers_;
@@ -50,10 +50,13 @@ void Finale::setDebug()
   debug_ = true;
 }
 
-void Finale::densityFill(const char* rules_filename, const odb::Rect& fill_area)
+void Finale::densityFill(const char* rules_filename,
+                         const odb::Rect& fill_area,
+                         int tile_size,
+                         bool report_density)
 {
   DensityFill filler(db_, logger_, debug_);
-  filler.fill(rules_filename, fill_area);
+  filler.fill(rules_filename, fill_area, tile_size, report_density);
 }
 
 }  // namespace fin
@@ -51,10 +51,12 @@ set_density_fill_debug_cmd()
 
 void
 density_fill_cmd(const char* rules_filename,
-                 const odb::Rect& fill_area)
+                 const odb::Rect& fill_area,
+                 int tile_size,
+                 bool report_density)
 {
   auto *finale = ord::OpenRoad::openRoad()->getFinale();
-  finale->densityFill(rules_filename, fill_area);
+  finale->densityFill(rules_filename, fill_area, tile_size, report_density);
 }
 
 %} // inline
@@ -0,0 +1,22 @@
+# density_fill split into tiles with a stripe crossing the tile boundaries
+source "helpers.tcl"
+
+read_lef Nangate45/Nangate45_tech.lef
+
+set db [ord::get_db]
+set block [odb::dbBlock_create [odb::dbChip_create $db] top]
+set metal1 [[$db getTech] findLayer metal1]
+set net [odb::dbNet_create $block VDD]
+set swire [odb::dbSWire_create $net ROUTED]
+odb::dbSBox_create $swire $metal1 0 9000 20000 11000 STRIPE
+
+utl::suppress_message FIN 10
+
+density_fill -rules fill_tiles.json -area {0 0 10 10} -report_density
+
+foreach fill [$block getFills] {
+  odb::dbFill_destroy $fill
+}
+
+density_fill -rules fill_tiles.json -area {0 0 10 10} -tile_size 5 \
+  -report_density
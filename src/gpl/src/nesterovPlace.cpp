@@ -46,6 +46,7 @@
 #include "routeBase.h"
 #include "timingBase.h"
 #include "utl/Logger.h"
+#include "utl/Profiler.h"
 
 namespace gpl {
 using utl::GPL;
@@ -306,6 +307,8 @@ int NesterovPlace::doNesterovPlace(int start_iter)
     return 0;
   }
 
+  utl::ProfileScope profile_scope("gpl::nesterov_place");
+
   if (graphics_) {
     graphics_->cellPlot(true);
   }
@@ -330,6 +333,7 @@ int NesterovPlace::doNesterovPlace(int start_iter)
   // Core Nesterov Loop
   int iter = start_iter;
   for (; iter < npVars_.maxNesterovIter; iter++) {
+    utl::ProfileScope iter_scope("gpl::nesterov_iter");
     float prevA = curA;
 
     // here, prevA is a_(k), curA is a_(k+1)
@@ -79,8 +79,14 @@ class InitFloorplan
                      odb::dbSite* base_site,
                      const std::vector<odb::dbSite*>& additional_sites = {});
 
+  // Ties off the constant nets driven by tie_term's function. A net is split
+  // so that each tiecell drives at most max_fanout loads and, once the loads
+  // are placed, is placed within max_distance (dbu) of all of them.
+  // A limit of zero means no limit.
   void insertTiecells(odb::dbMTerm* tie_term,
-                      const std::string& prefix = "TIEOFF_");
+                      const std::string& prefix = "TIEOFF_",
+                      int max_fanout = 0,
+                      int max_distance = 0);
 
   void makeTracks();
   void makeTracks(odb::dbTechLayer* layer,
@@ -101,21 +107,68 @@ class InitFloorplan
  private:
   using SitesByName = std::map<std::string, odb::dbSite*>;
 
+  // A row computed before being created in the block
+  struct RowSpec
+  {
+    std::string name;
+    odb::dbSite* site;
+    int x;
+    int y;
+    odb::dbOrientType orient;
+    int num_sites;
+    int spacing;
+  };
+
+  struct TieLoad
+  {
+    odb::dbITerm* iterm;
+    odb::Point location;
+    bool placed;
+  };
+  // A range of loads driven by one tiecell
+  struct TieCluster
+  {
+    int begin;
+    int end;
+  };
+
   double designArea();
   void makeRows(const odb::dbSite::RowPattern& pattern, const odb::Rect& core);
   void makeUniformRows(odb::dbSite* base_site,
                        const SitesByName& sites_by_name,
-                       const odb::Rect& core);
+                       const odb::Rect& core,
+                       std::vector<RowSpec>& rows) const;
   void makeHybridRows(odb::dbSite* base_hybrid_site,
                       const SitesByName& sites_by_name,
-                      const odb::Rect& core);
+                      const odb::Rect& core,
+                      std::vector<RowSpec>& rows) const;
+  void commitRows(const std::vector<RowSpec>& rows);
   int getOffset(odb::dbSite* base_hybrid_site,
                 odb::dbSite* site,
                 odb::dbOrientType& orientation) const;
   void makeTracks(const char* tracks_file, odb::Rect& die_area);
+  void addTrackPatterns(odb::dbTechLayer* layer,
+                        int x_offset,
+                        int x_pitch,
+                        int y_offset,
+                        int y_pitch,
+                        bool add_x_pattern);
   void autoPlacePins(odb::dbTechLayer* pin_layer, odb::Rect& core);
   int snapToMfgGrid(int coord) const;
-  void updateVoltageDomain(int core_lx, int core_ly, int core_ux, int core_uy);
+  void updateVoltageDomain(int core_lx,
+                           int core_ly,
+                           int core_ux,
+                           int core_uy,
+                           std::vector<RowSpec>& rows) const;
+  void clusterTieLoads(std::vector<TieLoad>& loads,
+                       int begin,
+                       int end,
+                       int max_fanout,
+                       int max_distance,
+                       std::vector<TieCluster>& clusters) const;
+  void placeTiecell(odb::dbInst* inst,
+                    const std::vector<TieLoad>& loads,
+                    const TieCluster& cluster) const;
   void addUsedSites(std::map<std::string, odb::dbSite*>& sites_by_name) const;
 
   odb::dbBlock* block_;
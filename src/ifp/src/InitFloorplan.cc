@@ -35,6 +35,7 @@
 
 #include "ifp/InitFloorplan.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iostream>
@@ -215,13 +216,17 @@ void InitFloorplan::initFloorplan(
                     cly / dbu);
     }
 
+    // Rows are computed and cut around the voltage domains before any of
+    // them is created in the block.
+    std::vector<RowSpec> row_specs;
     if (base_site->hasRowPattern()) {
-      makeHybridRows(base_site, sites_by_name, snapped_core);
+      makeHybridRows(base_site, sites_by_name, snapped_core, row_specs);
     } else {
-      makeUniformRows(base_site, sites_by_name, snapped_core);
+      makeUniformRows(base_site, sites_by_name, snapped_core, row_specs);
     }
 
-    updateVoltageDomain(clx, cly, cux, cuy);
+    updateVoltageDomain(clx, cly, cux, cuy, row_specs);
+    commitRows(row_specs);
   }
 
   std::vector<dbBox*> blockage_bboxes;
@@ -242,140 +247,129 @@ void InitFloorplan::initFloorplan(
 void InitFloorplan::updateVoltageDomain(const int core_lx,
                                         const int core_ly,
                                         const int core_ux,
-                                        const int core_uy)
+                                        const int core_uy,
+                                        std::vector<RowSpec>& rows) const
 {
   // The unit for power_domain_y_space is the site height. The real space is
   // power_domain_y_space * site_dy
   static constexpr int power_domain_y_space = 6;
 
+  std::vector<RowSpec> cut_rows;
   // checks if a group is defined as a voltage domain, if so it creates a region
   for (dbGroup* group : block_->getGroups()) {
-    if (group->getType() == dbGroupType::VOLTAGE_DOMAIN
-        || group->getType() == dbGroupType::POWER_DOMAIN) {
-      dbRegion* domain_region = group->getRegion();
-      int domain_xMin = std::numeric_limits<int>::max();
-      int domain_yMin = std::numeric_limits<int>::max();
-      int domain_xMax = std::numeric_limits<int>::min();
-      int domain_yMax = std::numeric_limits<int>::min();
-      for (auto boundary : domain_region->getBoundaries()) {
-        domain_xMin = std::min(domain_xMin, boundary->xMin());
-        domain_yMin = std::min(domain_yMin, boundary->yMin());
-        domain_xMax = std::max(domain_xMax, boundary->xMax());
-        domain_yMax = std::max(domain_yMax, boundary->yMax());
-      }
+    if (group->getType() != dbGroupType::VOLTAGE_DOMAIN
+        && group->getType() != dbGroupType::POWER_DOMAIN) {
+      continue;
+    }
+    dbRegion* domain_region = group->getRegion();
+    Rect domain;
+    domain.mergeInit();
+    for (auto boundary : domain_region->getBoundaries()) {
+      domain.merge(boundary->getBox());
+    }
 
-      string domain_name = group->getName();
+    const string domain_name = group->getName();
+
+    cut_rows.clear();
+    cut_rows.reserve(rows.size());
+    for (RowSpec& row : rows) {
+      auto site = row.site;
+      const int site_dy = site->getHeight();
+      const int site_dx = site->getWidth();
+      const int row_yMin = row.y;
+      const int row_yMax = row.y + site_dy;
+
+      // check if the rows overlapped with the area of a defined voltage
+      // domains + margin
+      if (site->getClass() == odb::dbSiteClass::PAD
+          || row_yMax + power_domain_y_space * site_dy <= domain.yMin()
+          || row_yMin >= domain.yMax() + power_domain_y_space * site_dy) {
+        cut_rows.push_back(std::move(row));
+        continue;
+      }
 
-      std::vector<dbRow*> rows;
-      for (dbRow* row : block_->getRows()) {
-        if (row->getSite()->getClass() == odb::dbSiteClass::PAD) {
-          continue;
+      // snap inward to site grid
+      const int domain_xMin
+          = odb::makeSiteLoc(domain.xMin(), site_dx, false, 0);
+      const int domain_xMax
+          = odb::makeSiteLoc(domain.xMax(), site_dx, true, 0);
+
+      // lcr stands for left core row
+      const int lcr_xMax = domain_xMin - power_domain_y_space * site_dy;
+      // in case there is at least one valid site width on the left, create
+      // left core rows
+      if (lcr_xMax > core_lx + site_dx) {
+        string lcr_name = row.name + "_1";
+        // warning message since tap cells might not be inserted
+        if (lcr_xMax < core_lx + 10 * site_dx) {
+          logger_->warn(
+              IFP, 26, "left core row: {} has less than 10 sites", lcr_name);
         }
-        rows.push_back(row);
+        const int lcr_sites = (lcr_xMax - core_lx) / site_dx;
+        cut_rows.push_back({std::move(lcr_name),
+                            site,
+                            core_lx,
+                            row_yMin,
+                            row.orient,
+                            lcr_sites,
+                            site_dx});
       }
 
-      int total_row_count = rows.size();
-
-      std::vector<dbRow*>::iterator row_itr = rows.begin();
-      for (int row_processed = 0; row_processed < total_row_count;
-           row_processed++) {
-        dbRow* row = *row_itr;
-        Rect row_bbox = row->getBBox();
-        int row_yMin = row_bbox.yMin();
-        int row_yMax = row_bbox.yMax();
-        auto site = row->getSite();
-
-        int site_dy = site->getHeight();
-        int site_dx = site->getWidth();
-
-        // snap inward to site grid
-        domain_xMin = odb::makeSiteLoc(domain_xMin, site_dx, false, 0);
-        domain_xMax = odb::makeSiteLoc(domain_xMax, site_dx, true, 0);
-
-        // check if the rows overlapped with the area of a defined voltage
-        // domains + margin
-        if (row_yMax + power_domain_y_space * site_dy <= domain_yMin
-            || row_yMin >= domain_yMax + power_domain_y_space * site_dy) {
-          row_itr++;
-        } else {
-          string row_name = row->getName();
-          dbOrientType orient = row->getOrient();
-          dbRow::destroy(row);
-          row_itr++;
-
-          // lcr stands for left core row
-          int lcr_xMax = domain_xMin - power_domain_y_space * site_dy;
-          // in case there is at least one valid site width on the left, create
-          // left core rows
-          if (lcr_xMax > core_lx + static_cast<int>(site_dx)) {
-            string lcr_name = row_name + "_1";
-            // warning message since tap cells might not be inserted
-            if (lcr_xMax < core_lx + 10 * site_dx) {
-              logger_->warn(IFP,
-                            26,
-                            "left core row: {} has less than 10 sites",
-                            lcr_name);
-            }
-            int lcr_sites = (lcr_xMax - core_lx) / site_dx;
-            dbRow::create(block_,
-                          lcr_name.c_str(),
-                          site,
-                          core_lx,
-                          row_yMin,
-                          orient,
-                          dbRowDir::HORIZONTAL,
-                          lcr_sites,
-                          site_dx);
-          }
-
-          // rcr stands for right core row
-          // rcr_dx_site_number is the max number of site_dx that is less than
-          // power_domain_y_space * site_dy. This helps align the rcr_xMin on
-          // the multiple of site_dx.
-          int rcr_dx_site_number = (power_domain_y_space * site_dy) / site_dx;
-          int rcr_xMin = domain_xMax + rcr_dx_site_number * site_dx;
-          // snap to the site grid rightward
-          rcr_xMin = odb::makeSiteLoc(rcr_xMin, site_dx, false, 0);
-
-          // in case there is at least one valid site width on the right, create
-          // right core rows
-          if (rcr_xMin + static_cast<int>(site_dx) < core_ux) {
-            string rcr_name = row_name + "_2";
-            if (rcr_xMin + 10 * site_dx > core_ux) {
-              logger_->warn(IFP,
-                            27,
-                            "right core row: {} has less than 10 sites",
-                            rcr_name);
-            }
-            int rcr_sites = (core_ux - rcr_xMin) / site_dx;
-            dbRow::create(block_,
-                          rcr_name.c_str(),
-                          site,
-                          rcr_xMin,
-                          row_yMin,
-                          orient,
-                          dbRowDir::HORIZONTAL,
-                          rcr_sites,
-                          site_dx);
-          }
-
-          int domain_row_sites = (domain_xMax - domain_xMin) / site_dx;
-          // create domain rows if current iterations are not in margin area
-          if (row_yMin >= domain_yMin && row_yMax <= domain_yMax) {
-            string domain_row_name = row_name + "_" + domain_name;
-            dbRow::create(block_,
-                          domain_row_name.c_str(),
-                          site,
-                          domain_xMin,
-                          row_yMin,
-                          orient,
-                          dbRowDir::HORIZONTAL,
-                          domain_row_sites,
-                          site_dx);
-          }
+      // rcr stands for right core row
+      // rcr_dx_site_number is the max number of site_dx that is less than
+      // power_domain_y_space * site_dy. This helps align the rcr_xMin on
+      // the multiple of site_dx.
+      const int rcr_dx_site_number = (power_domain_y_space * site_dy) / site_dx;
+      int rcr_xMin = domain_xMax + rcr_dx_site_number * site_dx;
+      // snap to the site grid rightward
+      rcr_xMin = odb::makeSiteLoc(rcr_xMin, site_dx, false, 0);
+
+      // in case there is at least one valid site width on the right, create
+      // right core rows
+      if (rcr_xMin + site_dx < core_ux) {
+        string rcr_name = row.name + "_2";
+        if (rcr_xMin + 10 * site_dx > core_ux) {
+          logger_->warn(
+              IFP, 27, "right core row: {} has less than 10 sites", rcr_name);
         }
+        const int rcr_sites = (core_ux - rcr_xMin) / site_dx;
+        cut_rows.push_back({std::move(rcr_name),
+                            site,
+                            rcr_xMin,
+                            row_yMin,
+                            row.orient,
+                            rcr_sites,
+                            site_dx});
+      }
+
+      const int domain_row_sites = (domain_xMax - domain_xMin) / site_dx;
+      // create domain rows if current iterations are not in margin area
+      if (row_yMin >= domain.yMin() && row_yMax <= domain.yMax()) {
+        cut_rows.push_back({row.name + "_" + domain_name,
+                            site,
+                            domain_xMin,
+                            row_yMin,
+                            row.orient,
+                            domain_row_sites,
+                            site_dx});
       }
     }
+    rows.swap(cut_rows);
+  }
+}
+
+void InitFloorplan::commitRows(const std::vector<RowSpec>& rows)
+{
+  for (const RowSpec& row : rows) {
+    dbRow::create(block_,
+                  row.name.c_str(),
+                  row.site,
+                  row.x,
+                  row.y,
+                  row.orient,
+                  dbRowDir::HORIZONTAL,
+                  row.num_sites,
+                  row.spacing);
   }
 }
 
@@ -407,11 +401,12 @@ void InitFloorplan::addUsedSites(
 // Create the rows for the core area
 void InitFloorplan::makeUniformRows(odb::dbSite* base_site,
                                     const SitesByName& sites_by_name,
-                                    const odb::Rect& core)
+                                    const odb::Rect& core,
+                                    std::vector<RowSpec>& rows) const
 {
   const int core_dx = core.dx();
   const int core_dy = core.dy();
-  const uint site_dx = base_site->getWidth();
+  const int site_dx = base_site->getWidth();
   const int rows_x = core_dx / site_dx;
 
   auto make_rows = [&](dbSite* site) {
@@ -419,19 +414,17 @@ void InitFloorplan::makeUniformRows(odb::dbSite* base_site,
     const int rows_y = core_dy / site_dy;
 
     int y = core.yMin();
+    rows.reserve(rows.size() + rows_y);
     for (int row = 0; row < rows_y; row++) {
       dbOrientType orient = (row % 2 == 0) ? dbOrientType::R0   // N
                                            : dbOrientType::MX;  // FS
-      string row_name = fmt::format("ROW_{}", block_->getRows().size());
-      dbRow::create(block_,
-                    row_name.c_str(),
-                    site,
-                    core.xMin(),
-                    y,
-                    orient,
-                    dbRowDir::HORIZONTAL,
-                    rows_x,
-                    site_dx);
+      rows.push_back({fmt::format("ROW_{}", rows.size()),
+                      site,
+                      core.xMin(),
+                      y,
+                      orient,
+                      rows_x,
+                      site_dx});
       y += site_dy;
     }
     logger_->info(IFP,
@@ -514,7 +507,8 @@ int InitFloorplan::getOffset(dbSite* base_hybrid_site,
 
 void InitFloorplan::makeHybridRows(dbSite* base_hybrid_site,
                                    const SitesByName& sites_by_name,
-                                   const odb::Rect& core)
+                                   const odb::Rect& core,
+                                   std::vector<RowSpec>& rows) const
 {
   auto row_pattern = base_hybrid_site->getRowPattern();
   auto first_site = row_pattern[0].site;
@@ -529,16 +523,13 @@ void InitFloorplan::makeHybridRows(dbSite* base_hybrid_site,
     if (y + site->getHeight() > core.yMax()) {
       break;
     }
-    const string row_name = fmt::format("ROW_{}", row);
-    dbRow::create(block_,
-                  row_name.c_str(),
-                  site,
-                  core.xMin(),
-                  y,
-                  orient,
-                  dbRowDir::HORIZONTAL,
-                  row_width,
-                  site_width);
+    rows.push_back({fmt::format("ROW_{}", rows.size()),
+                    site,
+                    core.xMin(),
+                    y,
+                    orient,
+                    row_width,
+                    site_width});
     y += site->getHeight();
     ++row;
   }
@@ -555,16 +546,13 @@ void InitFloorplan::makeHybridRows(dbSite* base_hybrid_site,
     int row = 0;
 
     while (y + site->getHeight() <= core.yMax()) {
-      const string row_name = fmt::format("ROW_{}", block_->getRows().size());
-      dbRow::create(block_,
-                    row_name.c_str(),
-                    site,
-                    core.xMin(),
-                    y,
-                    orient,
-                    dbRowDir::HORIZONTAL,
-                    row_width,
-                    site_width);
+      rows.push_back({fmt::format("ROW_{}", rows.size()),
+                      site,
+                      core.xMin(),
+                      y,
+                      orient,
+                      row_width,
+                      site_width});
       y += site->getHeight();
       ++row;
     }
@@ -603,10 +591,14 @@ int InitFloorplan::snapToMfgGrid(int coord) const
 }
 
 void InitFloorplan::insertTiecells(odb::dbMTerm* tie_term,
-                                   const std::string& prefix)
+                                   const std::string& prefix,
+                                   int max_fanout,
+                                   int max_distance)
 {
   utl::Validator v(logger_, IFP);
   v.check_non_null("tie_term", tie_term, 43);
+  v.check_non_negative("max_fanout", max_fanout, 51);
+  v.check_non_negative("max_distance", max_distance, 52);
 
   auto* master = tie_term->getMaster();
 
@@ -635,8 +627,8 @@ void InitFloorplan::insertTiecells(odb::dbMTerm* tie_term,
                    master->getName());
   }
 
-  int count = 0;
-
+  // Collect the nets first as splitting them creates new nets.
+  std::vector<odb::dbNet*> tie_nets;
   for (auto* net : block_->getNets()) {
     if (net->isSpecial()) {
       continue;
@@ -644,14 +636,55 @@ void InitFloorplan::insertTiecells(odb::dbMTerm* tie_term,
     if (look_for != net->getSigType()) {
       continue;
     }
+    tie_nets.push_back(net);
+  }
 
-    const std::string inst_name = prefix + net->getName();
+  int count = 0;
+  int split_count = 0;
+  std::vector<TieLoad> loads;
+  std::vector<TieCluster> clusters;
+  for (auto* net : tie_nets) {
+    loads.clear();
+    clusters.clear();
+    for (auto* iterm : net->getITerms()) {
+      auto* inst = iterm->getInst();
+      const odb::Rect bbox = inst->getBBox()->getBox();
+      loads.push_back({iterm,
+                       {bbox.xCenter(), bbox.yCenter()},
+                       inst->getPlacementStatus().isPlaced()});
+    }
+    clusterTieLoads(
+        loads, 0, loads.size(), max_fanout, max_distance, clusters);
+    if (clusters.empty()) {
+      // Nothing is connected but keep the net tied off.
+      clusters.push_back({0, 0});
+    }
 
-    auto* inst = odb::dbInst::create(block_, master, inst_name.c_str());
-    auto* iterm = inst->findITerm(tie_term->getConstName());
-    iterm->connect(net);
-    net->setSigType(odb::dbSigType::SIGNAL);
-    count++;
+    const std::string net_name = net->getName();
+    for (int i = 0; i < clusters.size(); ++i) {
+      const TieCluster& cluster = clusters[i];
+      std::string inst_name = prefix + net_name;
+      odb::dbNet* tie_net = net;
+      if (i > 0) {
+        // The first cluster stays on the original net along with any bterm.
+        inst_name += "_" + std::to_string(i);
+        std::string split_name = net_name + "_" + std::to_string(i);
+        while (block_->findNet(split_name.c_str())) {
+          split_name += "_";
+        }
+        tie_net = odb::dbNet::create(block_, split_name.c_str());
+        for (int j = cluster.begin; j < cluster.end; ++j) {
+          loads[j].iterm->connect(tie_net);
+        }
+        split_count++;
+      }
+
+      auto* inst = odb::dbInst::create(block_, master, inst_name.c_str());
+      inst->getITerm(tie_term)->connect(tie_net);
+      tie_net->setSigType(odb::dbSigType::SIGNAL);
+      placeTiecell(inst, loads, cluster);
+      count++;
+    }
   }
 
   logger_->info(utl::IFP,
@@ -660,6 +693,84 @@ void InitFloorplan::insertTiecells(odb::dbMTerm* tie_term,
                 count,
                 master->getName(),
                 tie_term->getName());
+  if (split_count > 0) {
+    logger_->info(utl::IFP,
+                  53,
+                  "Split {} constant nets to meet the fanout and distance "
+                  "limits.",
+                  split_count);
+  }
+}
+
+// Recursively bisects loads[begin, end) at the median of the longer side of
+// its bounding box until each cluster is within max_fanout loads and every
+// placed load is within max_distance of the center of its cluster.
+void InitFloorplan::clusterTieLoads(std::vector<TieLoad>& loads,
+                                    const int begin,
+                                    const int end,
+                                    const int max_fanout,
+                                    const int max_distance,
+                                    std::vector<TieCluster>& clusters) const
+{
+  const int size = end - begin;
+  if (size <= 0) {
+    return;
+  }
+
+  odb::Rect bbox;
+  bbox.mergeInit();
+  bool placed = true;
+  for (int i = begin; i < end; ++i) {
+    bbox.merge(odb::Rect(loads[i].location, loads[i].location));
+    placed &= loads[i].placed;
+  }
+
+  const bool too_many = max_fanout > 0 && size > max_fanout;
+  // Distances are only meaningful once the loads are placed.
+  const bool too_far
+      = placed && max_distance > 0
+        && (static_cast<int64_t>(bbox.dx()) + bbox.dy()) / 2 > max_distance;
+  if (size == 1 || (!too_many && !too_far)) {
+    clusters.push_back({begin, end});
+    return;
+  }
+
+  const int middle = begin + size / 2;
+  const bool by_x = bbox.dx() >= bbox.dy();
+  std::nth_element(loads.begin() + begin,
+                   loads.begin() + middle,
+                   loads.begin() + end,
+                   [by_x](const TieLoad& a, const TieLoad& b) {
+                     return by_x ? a.location.x() < b.location.x()
+                                 : a.location.y() < b.location.y();
+                   });
+  clusterTieLoads(loads, begin, middle, max_fanout, max_distance, clusters);
+  clusterTieLoads(loads, middle, end, max_fanout, max_distance, clusters);
+}
+
+// Places the tiecell at the center of its loads when they are all placed.
+// The location is not legalized; detailed placement is expected to follow.
+void InitFloorplan::placeTiecell(odb::dbInst* inst,
+                                 const std::vector<TieLoad>& loads,
+                                 const TieCluster& cluster) const
+{
+  if (cluster.begin == cluster.end) {
+    return;
+  }
+
+  odb::Rect bbox;
+  bbox.mergeInit();
+  for (int i = cluster.begin; i < cluster.end; ++i) {
+    if (!loads[i].placed) {
+      return;
+    }
+    bbox.merge(odb::Rect(loads[i].location, loads[i].location));
+  }
+
+  auto* master = inst->getMaster();
+  inst->setLocation(bbox.xCenter() - master->getWidth() / 2,
+                    bbox.yCenter() - master->getHeight() / 2);
+  inst->setPlacementStatus(odb::dbPlacementStatus::PLACED);
 }
 
 void InitFloorplan::makeTracks()
@@ -690,6 +801,17 @@ void InitFloorplan::makeTracks(odb::dbTechLayer* layer,
                                int x_pitch,
                                int y_offset,
                                int y_pitch)
+{
+  addTrackPatterns(layer, x_offset, x_pitch, y_offset, y_pitch, true);
+}
+
+// Adds the y track pattern of the layer and, if add_x_pattern, the x one.
+void InitFloorplan::addTrackPatterns(odb::dbTechLayer* layer,
+                                     int x_offset,
+                                     int x_pitch,
+                                     int y_offset,
+                                     int y_pitch,
+                                     const bool add_x_pattern)
 {
   utl::Validator v(logger_, IFP);
   v.check_non_null("layer", layer, 38);
@@ -731,22 +853,24 @@ void InitFloorplan::makeTracks(odb::dbTechLayer* layer,
 
   int layer_min_width = layer->getMinWidth();
 
-  auto x_track_count = int((die_area.dx() - x_offset) / x_pitch) + 1;
-  int origin_x = die_area.xMin() + x_offset;
-  // Check if the track origin is not usable during routing
+  if (add_x_pattern) {
+    auto x_track_count = int((die_area.dx() - x_offset) / x_pitch) + 1;
+    int origin_x = die_area.xMin() + x_offset;
+    // Check if the track origin is not usable during routing
 
-  if (origin_x - layer_min_width / 2 < die_area.xMin()) {
-    origin_x += x_pitch;
-    x_track_count--;
-  }
+    if (origin_x - layer_min_width / 2 < die_area.xMin()) {
+      origin_x += x_pitch;
+      x_track_count--;
+    }
 
-  // Check if the last track is not usable during routing
-  int last_x = origin_x + (x_track_count - 1) * x_pitch;
-  if (last_x + layer_min_width / 2 > die_area.xMax()) {
-    x_track_count--;
-  }
+    // Check if the last track is not usable during routing
+    int last_x = origin_x + (x_track_count - 1) * x_pitch;
+    if (last_x + layer_min_width / 2 > die_area.xMax()) {
+      x_track_count--;
+    }
 
-  grid->addGridPatternX(origin_x, x_track_count, x_pitch);
+    grid->addGridPatternX(origin_x, x_track_count, x_pitch);
+  }
 
   auto y_track_count = int((die_area.dy() - y_offset) / y_pitch) + 1;
   int origin_y = die_area.yMin() + y_offset;
@@ -794,12 +918,19 @@ void InitFloorplan::makeTracksNonUniform(odb::dbTechLayer* layer,
   auto y_track_count
       = int((cell_row_height - 2 * first_last_pitch) / y_pitch) + 1;
   int origin_y = die_area.yMin() + first_last_pitch;
+  // Every y pattern shares the same x pattern so it is only added once.
   for (int i = 0; i < y_track_count; i++) {
-    makeTracks(layer, x_offset, x_pitch, origin_y, cell_row_height);
+    addTrackPatterns(
+        layer, x_offset, x_pitch, origin_y, cell_row_height, i == 0);
     origin_y += y_pitch;
   }
   origin_y += first_last_pitch - y_pitch;
-  makeTracks(layer, x_offset, x_pitch, origin_y, cell_row_height);
+  addTrackPatterns(layer,
+                   x_offset,
+                   x_pitch,
+                   origin_y,
+                   cell_row_height,
+                   y_track_count <= 0);
 }
 
 }  // namespace ifp
@@ -121,9 +121,12 @@ init_floorplan_util(double util,
 }
 
 void
-insert_tiecells_cmd(odb::dbMTerm* tie_term, const char* prefix)
+insert_tiecells_cmd(odb::dbMTerm* tie_term,
+                    const char* prefix,
+                    int max_fanout,
+                    int max_distance)
 {
-  get_floorplan().insertTiecells(tie_term, prefix);
+  get_floorplan().insertTiecells(tie_term, prefix, max_fanout, max_distance);
 }
 
 void
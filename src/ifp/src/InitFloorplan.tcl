@@ -204,12 +204,14 @@ proc make_tracks { args } {
 }
 
 sta::define_cmd_args "insert_tiecells" {tie_pin \
-                                        [-prefix prefix]
+                                        [-prefix prefix] \
+                                        [-max_fanout fanout] \
+                                        [-max_distance distance]
 }
 
 proc insert_tiecells { args } {
   sta::parse_key_args "insert_tiecells" args \
-    keys {-prefix} \
+    keys {-prefix -max_fanout -max_distance} \
     flags {}
 
   sta::check_argc_eq1 "insert_tiecells" $args
@@ -219,6 +221,19 @@ proc insert_tiecells { args } {
     set prefix $keys(-prefix)
   }
 
+  set max_fanout 0
+  if { [info exists keys(-max_fanout)] } {
+    set max_fanout $keys(-max_fanout)
+    sta::check_positive_integer "-max_fanout" $max_fanout
+  }
+
+  set max_distance 0
+  if { [info exists keys(-max_distance)] } {
+    set max_distance $keys(-max_distance)
+    sta::check_positive_float "-max_distance" $max_distance
+    set max_distance [ord::microns_to_dbu $max_distance]
+  }
+
   set tie_pin_split [split $args {/}]
   set port [lindex $tie_pin_split end]
   set tie_cell [join [lrange $tie_pin_split 0 end-1] {/}]
@@ -239,7 +254,7 @@ proc insert_tiecells { args } {
     utl::error "IFP" 32 "Unable to find master pin: $args"
   }
 
-  ifp::insert_tiecells_cmd $mterm $prefix
+  ifp::insert_tiecells_cmd $mterm $prefix $max_fanout $max_distance
 }
 
 namespace eval ifp {
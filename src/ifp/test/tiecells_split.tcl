@@ -0,0 +1,52 @@
+# insert_tiecells splitting constant nets by -max_fanout and -max_distance
+source "helpers.tcl"
+
+read_liberty Nangate45/Nangate45_typ.lib
+read_lef Nangate45/Nangate45_tech.lef
+read_lef Nangate45/Nangate45_stdcell.lef
+
+set db [ord::get_db]
+set block [odb::dbBlock_create [odb::dbChip_create $db] "top"]
+set buf [$db findMaster BUF_X1]
+
+# zero_1 is taken so the first split of zero is named zero_1_
+odb::dbNet_create $block "zero_1"
+
+# Three buffers near the origin and two 40um away
+set zero [odb::dbNet_create $block "zero"]
+$zero setSigType GROUND
+foreach {name x y} {a1 0 0 a2 2000 0 a3 4000 0 b1 80000 28000 b2 82000 28000} {
+  set inst [odb::dbInst_create $block $buf $name]
+  $inst setLocation $x $y
+  $inst setPlacementStatus PLACED
+  [$inst findITerm A] connect $zero
+}
+
+# Unplaced loads are only split by fanout and their tiecells are not placed
+set unplaced [odb::dbNet_create $block "zero_unplaced"]
+$unplaced setSigType GROUND
+foreach {name x} {u1 0 u2 2000 u3 4000 u4 6000} {
+  set inst [odb::dbInst_create $block $buf $name]
+  $inst setLocation $x 56000
+  [$inst findITerm A] connect $unplaced
+}
+
+ord::design_created
+
+insert_tiecells LOGIC0_X1/Z -max_fanout 3 -max_distance 20
+
+foreach inst [$block getInsts] {
+  if { [[$inst getMaster] getName] != "LOGIC0_X1" } {
+    continue
+  }
+  set net [[$inst findITerm Z] getNet]
+  set loads {}
+  foreach iterm [$net getITerms] {
+    if { [$iterm getInst] != $inst } {
+      lappend loads [[$iterm getInst] getName]
+    }
+  }
+  set bbox [$inst getBBox]
+  puts "[$inst getName] [$bbox xMin] [$bbox yMin]\
+        [$inst getPlacementStatus] [$net getName] [lsort $loads]"
+}
@@ -95,6 +95,7 @@ class dbCapNode;
 class dbRSeg;
 class dbCCSeg;
 class dbBlockSearch;
+class dbWireShapeCache;
 class dbRow;
 class dbFill;
 class dbTechAntennaPinModel;
@@ -1427,6 +1428,26 @@ class dbBlock : public dbObject
   ///
   dbBlockSearch* getSearchDb();
 
+  ///
+  /// Get the cache of decoded wire shapes of this block. It is created on
+  /// first use.
+  ///
+  dbWireShapeCache* getWireShapeCache();
+
+  ///
+  /// Release the unused pages at the end of the object tables of this block
+  /// and relink their free-lists so new objects fill the lowest free ids
+  /// first. Object ids are not changed. Tables are left alone while an ECO
+  /// journal is active. Returns the number of bytes released.
+  ///
+  size_t compactTables();
+
+  ///
+  /// Report the objects, capacity and memory of each object table of this
+  /// block.
+  ///
+  void reportTableMemory();
+
   ///
   /// destroy coupling caps of nets
   ///
@@ -5282,6 +5303,22 @@ class dbLib : public dbObject
   ///
   void getBusDelimeters(char& left, char& right);
 
+  ///
+  /// Write the contents of this library to a standalone snapshot.
+  /// Throws ZIOError..
+  ///
+  void writeSnapshot(std::ostream& file);
+
+  ///
+  /// Load a snapshot written by writeSnapshot into this newly created
+  /// library. The library keeps its name and technology. The masters of the
+  /// snapshot refer to technology objects by id, so the technology must be
+  /// the one the snapshot was written against.
+  /// Returns false, without modifying the library, if the snapshot was
+  /// written with a different database schema.
+  ///
+  bool readSnapshot(std::istream& file);
+
   ///
   /// Create a new library.
   ///
@@ -6087,6 +6124,20 @@ class dbTech : public dbObject
   ///
   void checkLayer(bool typeChk, bool widthChk, bool pitchChk, bool spacingChk);
 
+  ///
+  /// Write the contents of this technology to a standalone snapshot.
+  /// Throws ZIOError..
+  ///
+  void writeSnapshot(std::ostream& file);
+
+  ///
+  /// Load a snapshot written by writeSnapshot into this newly created
+  /// technology. The technology keeps its name.
+  /// Returns false, without modifying the technology, if the snapshot was
+  /// written with a different database schema.
+  ///
+  bool readSnapshot(std::istream& file);
+
   ///
   /// Create a new technology.
   /// Returns nullptr if a database technology already exists
@@ -33,6 +33,7 @@
 #pragma once
 
 #include <list>
+#include <vector>
 
 #include "odb.h"
 
@@ -162,6 +163,15 @@ class dbBlockCallBackObj
   virtual void inDbFillCreate(dbFill*) {}
   // dbFill End
 
+  // dbNetlistBuilder Start
+  // The objects made by a dbNetlistBuilder since its last commit. The
+  // default reports them through inDbInstCreate, inDbITermCreate,
+  // inDbNetCreate and inDbITermPostConnect.
+  virtual void inDbNetlistBuilt(const std::vector<dbInst*>& insts,
+                                const std::vector<dbNet*>& nets,
+                                const std::vector<dbITerm*>& connected_iterms);
+  // dbNetlistBuilder End
+
   virtual void inDbBlockStreamOutBefore(dbBlock*) {}
   virtual void inDbBlockStreamOutAfter(dbBlock*) {}
   virtual void inDbBlockReadNetsBefore(dbBlock*) {}
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <vector>
+
+#include "odb/odb.h"
+
+namespace odb {
+
+class dbBlock;
+class dbInst;
+class dbITerm;
+class dbMaster;
+class dbModule;
+class dbNet;
+class dbRegion;
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// dbNetlistBuilder - Creates instances, nets and connections in bulk.
+///
+/// The block's tables and name hashes are grown once up front by reserve.
+/// Objects made through the builder are not reported to the block callbacks
+/// one at a time; commit (or the destructor) reports all of them with a
+/// single dbBlockCallBackObj::inDbNetlistBuilt.
+///
+/// Objects made by the builder should not be edited through other odb calls
+/// before they are committed: the callbacks of such edits are still sent
+/// immediately and would refer to objects the clients do not know yet.
+///
+///////////////////////////////////////////////////////////////////////////////
+class dbNetlistBuilder
+{
+ public:
+  explicit dbNetlistBuilder(dbBlock* block);
+  ~dbNetlistBuilder();
+
+  dbNetlistBuilder(const dbNetlistBuilder&) = delete;
+  dbNetlistBuilder& operator=(const dbNetlistBuilder&) = delete;
+
+  ///
+  /// Make room for this many more instances, nets and instance terminals.
+  ///
+  void reserve(uint num_insts, uint num_nets, uint num_iterms);
+
+  ///
+  /// Same as dbInst::create.
+  ///
+  dbInst* createInst(dbMaster* master,
+                     const char* name,
+                     dbRegion* region = nullptr,
+                     dbModule* parent_module = nullptr);
+
+  ///
+  /// Same as dbNet::create.
+  /// Returns nullptr if a net with this name already exists.
+  ///
+  dbNet* createNet(const char* name);
+
+  ///
+  /// Same as dbITerm::connect.
+  ///
+  void connect(dbITerm* iterm, dbNet* net);
+
+  ///
+  /// Report the objects made since the last commit to the block callbacks.
+  ///
+  void commit();
+
+ private:
+  dbBlock* block_;
+  std::vector<dbInst*> insts_;
+  std::vector<dbNet*> nets_;
+  std::vector<dbITerm*> connected_iterms_;
+};
+
+}  // namespace odb
@@ -54,6 +54,17 @@ class _dbDatabase;
 
 inline constexpr size_t kTemplateRecursionLimit = 16;
 
+// Names of these kinds are front-coded: each one is stored as the length of
+// the prefix it shares with the previous name of its kind plus the rest.
+// Consecutive instances and nets of flattened designs mostly share their
+// hierarchy prefix.
+enum dbStreamNameKind
+{
+  DB_STREAM_INST_NAME,
+  DB_STREAM_NET_NAME,
+  DB_STREAM_NUM_NAME_KINDS
+};
+
 class dbOStream
 {
   using Position = std::ostream::pos_type;
@@ -68,6 +79,7 @@ class dbOStream
   double _lef_area_factor;
   double _lef_dist_factor;
   std::vector<Scope> _scopes;
+  std::array<std::string, DB_STREAM_NUM_NAME_KINDS> _prev_names;
 
   // By default values are written as their string ("255" vs 0xFF)
   // representations when using the << stream method. In dbOstream we are
@@ -83,6 +95,9 @@ class dbOStream
 
   _dbDatabase* getDatabase() { return _db; }
 
+  // Write a name front-coded against the previous name of this kind.
+  void writeName(dbStreamNameKind kind, const char* name);
+
   dbOStream& operator<<(bool c)
   {
     unsigned char b = (c == true ? 1 : 0);
@@ -295,12 +310,17 @@ class dbIStream
   _dbDatabase* _db;
   double _lef_area_factor;
   double _lef_dist_factor;
+  std::array<std::string, DB_STREAM_NUM_NAME_KINDS> _prev_names;
 
  public:
   dbIStream(_dbDatabase* db, std::istream& f);
 
   _dbDatabase* getDatabase() { return _db; }
 
+  // Read a name written by dbOStream::writeName; the result is malloc'ed.
+  // Streams older than front coding hold the name as a plain string.
+  void readName(dbStreamNameKind kind, char*& name);
+
   dbIStream& operator>>(bool& c)
   {
     unsigned char b;
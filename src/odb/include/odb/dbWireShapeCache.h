@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <boost/core/span.hpp>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "odb/dbBlockCallBackObj.h"
+#include "odb/dbShape.h"
+
+namespace odb {
+
+class dbBlock;
+class dbNet;
+class dbTechLayer;
+class dbWire;
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// dbWireShapeCache - Decoded shapes of the routed wires of a block.
+///
+/// A net's wire is decoded the first time its shapes are asked for and kept
+/// in flat arrays until the wire changes.  The cache registers itself on the
+/// block and drops a net whenever its wire is created, modified, attached,
+/// detached or destroyed.
+///
+/// Several threads may query the cache at the same time.  The returned spans
+/// stay valid until the net's wire changes or the cache is cleared; changing
+/// wires while other threads read the cache is not supported.
+///
+/// Use dbBlock::getWireShapeCache to get the cache of a block.
+///
+///////////////////////////////////////////////////////////////////////////////
+class dbWireShapeCache : public dbBlockCallBackObj
+{
+ public:
+  explicit dbWireShapeCache(dbBlock* block);
+  ~dbWireShapeCache() override;
+
+  ///
+  /// The wire segments of the net sorted by layer and then in wire order.
+  ///
+  boost::span<const dbShape> getSegments(dbNet* net);
+
+  ///
+  /// The wire segments of the net on the given layer in wire order.
+  ///
+  boost::span<const dbShape> getSegments(dbNet* net, dbTechLayer* layer);
+
+  ///
+  /// The vias of the net in wire order.
+  ///
+  boost::span<const dbShape> getVias(dbNet* net);
+
+  ///
+  /// Drop the decoded shapes of the net.  They are decoded again the next
+  /// time they are asked for.
+  ///
+  void erase(dbNet* net);
+
+  ///
+  /// Drop all the decoded nets.
+  ///
+  void clear();
+
+  ///
+  /// Number of nets currently decoded.
+  ///
+  size_t size();
+
+  // dbBlockCallBackObj
+  void inDbNetDestroy(dbNet* net) override;
+  void inDbWireCreate(dbWire* wire) override;
+  void inDbWireDestroy(dbWire* wire) override;
+  void inDbWirePostModify(dbWire* wire) override;
+  void inDbWirePostAttach(dbWire* wire) override;
+  void inDbWirePreDetach(dbWire* wire) override;
+  void inDbWirePostAppend(dbWire* src, dbWire* dst) override;
+  void inDbWirePostCopy(dbWire* src, dbWire* dst) override;
+
+ private:
+  struct NetShapes
+  {
+    std::vector<dbShape> segments;
+    // (layer number, index of its first segment) for each layer in segments
+    std::vector<std::pair<uint, int>> layer_starts;
+    std::vector<dbShape> vias;
+  };
+
+  const NetShapes& getNetShapes(dbNet* net);
+  static std::unique_ptr<NetShapes> decode(dbNet* net);
+  void invalidate(dbWire* wire);
+
+  std::shared_mutex mutex_;
+  std::unordered_map<uint, std::unique_ptr<NetShapes>> nets_;
+};
+
+}  // namespace odb
@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <array>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace utl {
+class Logger;
+}
+
+namespace odb {
+
+class dbBlock;
+class dbTech;
+class dbTechLayer;
+
+//
+// Writes a block as a GDSII stream. Masters and vias become structures that
+// the top structure references, so the master abstracts can be replaced by
+// the library layouts when the stream is merged downstream. The structures
+// and the shapes of the top structure are encoded in parallel on the global
+// thread pool.
+//
+class gdsout
+{
+ public:
+  // The kinds of shapes written on each layer.
+  enum Purpose
+  {
+    DRAWING,
+    PIN,
+    LABEL,
+    FILL,
+    NUM_PURPOSES
+  };
+
+  // A GDSII layer and datatype.
+  struct GdsLayer
+  {
+    int layer;
+    int datatype;
+  };
+
+  gdsout(utl::Logger* logger, std::ostream& out);
+
+  // Read a layer map. Each line holds
+  //   <layer name> <drawing|pin|label|fill> <gds layer> <gds datatype>
+  // and '#' starts a comment. Without a map every layer is written on its
+  // mask order number with the purpose as datatype. With a map only the
+  // mapped layer and purpose pairs are written.
+  void readLayerMap(const char* file_name);
+
+  void writeBlock(dbBlock* block);
+
+ private:
+  void resolveLayers(dbTech* tech);
+
+  utl::Logger* logger_;
+  std::ostream& out_;
+  bool has_layer_map_ = false;
+  std::map<std::pair<std::string, Purpose>, GdsLayer> layer_map_;
+
+  // The layer map resolved for the tech being written; a negative layer
+  // marks a pair that is not written.
+  std::unordered_map<dbTechLayer*, std::array<GdsLayer, NUM_PURPOSES>>
+      layers_;
+};
+
+}  // namespace odb
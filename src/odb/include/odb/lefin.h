@@ -105,6 +105,9 @@ class lefin
   bool _master_modified;
   bool _ignore_non_routing_layers;
   std::vector<std::pair<odb::dbObject*, std::string>> _incomplete_props;
+  std::string _cache_dir;
+  // Hash of the technology before a library is read against it
+  uint64_t _tech_hash;
 
   void init();
   void setDBUPerMicron(int dbu);
@@ -128,6 +131,9 @@ class lefin
 
   bool readLefInner(const char* lef_file);
   bool readLef(const char* lef_file);
+  std::string cacheKey(const char* lef_file);
+  bool loadCache(const std::string& key, const char* lef_file);
+  void saveCache(const std::string& key, const char* lef_file);
   bool addGeoms(dbObject* object, bool is_pin, lefiGeometries* geometry);
   void createLibrary();
   void createPolygon(dbObject* object,
@@ -222,6 +228,12 @@ class lefin
   // Skip macro-obstructions in the lef file.
   void skipObstructions() { _skip_obstructions = true; }
 
+  // Keep snapshots of the technologies and libraries read in this
+  // directory. A LEF file whose contents (and the technology and libraries
+  // it is read against) are unchanged since it was last read is loaded from
+  // its snapshot instead of being parsed again.
+  void setCacheDir(const std::string& dir) { _cache_dir = dir; }
+
   //
   // Override the LEF DBU-PER-MICRON unit.
   // This function only is only effective when creating a technolgy, because the
@@ -128,6 +128,7 @@
 #include "odb/dbDiff.h"
 #include "odb/dbExtControl.h"
 #include "odb/dbShape.h"
+#include "odb/dbWireShapeCache.h"
 #include "odb/defout.h"
 #include "odb/lefout.h"
 #include "odb/parse.h"
@@ -417,6 +418,7 @@ _dbBlock::_dbBlock(_dbDatabase* db)
   _extmi = nullptr;
   _journal = nullptr;
   _journal_pending = nullptr;
+  _wire_shape_cache = nullptr;
 }
 
 _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
@@ -627,6 +629,7 @@ _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
   _extmi = block._extmi;
   _journal = nullptr;
   _journal_pending = nullptr;
+  _wire_shape_cache = nullptr;
 }
 
 _dbBlock::~_dbBlock()
@@ -680,6 +683,7 @@ _dbBlock::~_dbBlock()
   delete _r_seg_tbl;
   delete _cc_seg_tbl;
   delete _extControl;
+  delete _wire_shape_cache;
   delete _net_bterm_itr;
   delete _net_iterm_itr;
   delete _inst_iterm_itr;
@@ -745,6 +749,12 @@ void dbBlock::clear()
   // save callbacks
   callbacks.swap(block->_callbacks);
 
+  // the wire shape cache is owned by the block and destroyed with its
+  // contents below so it must not be restored
+  if (block->_wire_shape_cache) {
+    callbacks.remove(block->_wire_shape_cache);
+  }
+
   // unlink the child from the parent
   if (parent) {
     unlink_child_from_parent(block, parent);
@@ -3108,6 +3118,107 @@ dbBlockSearch* dbBlock::getSearchDb()
   return block->_searchDb;
 }
 
+dbWireShapeCache* dbBlock::getWireShapeCache()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  std::lock_guard<std::mutex> lock(block->_wire_shape_cache_mutex);
+  if (!block->_wire_shape_cache) {
+    block->_wire_shape_cache = new dbWireShapeCache(this);
+  }
+  return block->_wire_shape_cache;
+}
+
+template <typename Func>
+static void forEachTable(_dbBlock* block, Func func)
+{
+  func(block->_bterm_tbl);
+  func(block->_iterm_tbl);
+  func(block->_net_tbl);
+  func(block->_inst_hdr_tbl);
+  func(block->_inst_tbl);
+  func(block->_box_tbl);
+  func(block->_via_tbl);
+  func(block->_gcell_grid_tbl);
+  func(block->_track_grid_tbl);
+  func(block->_obstruction_tbl);
+  func(block->_blockage_tbl);
+  func(block->_wire_tbl);
+  func(block->_swire_tbl);
+  func(block->_sbox_tbl);
+  func(block->_row_tbl);
+  func(block->_fill_tbl);
+  func(block->_region_tbl);
+  func(block->_hier_tbl);
+  func(block->_bpin_tbl);
+  func(block->_non_default_rule_tbl);
+  func(block->_layer_rule_tbl);
+  func(block->_prop_tbl);
+  func(block->_module_tbl);
+  func(block->_powerdomain_tbl);
+  func(block->_logicport_tbl);
+  func(block->_powerswitch_tbl);
+  func(block->_isolation_tbl);
+  func(block->_levelshifter_tbl);
+  func(block->_modinst_tbl);
+  func(block->_group_tbl);
+  func(block->ap_tbl_);
+  func(block->global_connect_tbl_);
+  func(block->_guide_tbl);
+  func(block->_net_tracks_tbl);
+  func(block->_dft_tbl);
+  func(block->_modbterm_tbl);
+  func(block->_moditerm_tbl);
+  func(block->_modnet_tbl);
+  func(block->_cap_node_tbl);
+  func(block->_r_seg_tbl);
+  func(block->_cc_seg_tbl);
+}
+
+size_t dbBlock::compactTables()
+{
+  _dbBlock* block = (_dbBlock*) this;
+
+  // An ECO replay expects the free-lists of both databases to match.
+  if (block->_journal) {
+    return 0;
+  }
+
+  size_t released = 0;
+  forEachTable(block, [&released](auto* table) {
+    const size_t before = table->memoryUsage();
+    table->compact();
+    released += before - table->memoryUsage();
+  });
+  return released;
+}
+
+void dbBlock::reportTableMemory()
+{
+  _dbBlock* block = (_dbBlock*) this;
+  utl::Logger* logger = block->getImpl()->getLogger();
+
+  logger->report("{:<20} {:>10} {:>10} {:>12}",
+                 "Table",
+                 "Objects",
+                 "Capacity",
+                 "Memory (KB)");
+  size_t total = 0;
+  forEachTable(block, [logger, &total](auto* table) {
+    const size_t bytes = table->memoryUsage();
+    total += bytes;
+    if (table->capacity() == 0) {
+      return;
+    }
+    logger->report("{:<20} {:>10} {:>10} {:>12.1f}",
+                   dbObject::getTypeName(table->_type),
+                   table->size(),
+                   table->capacity(),
+                   bytes / 1024.0);
+  });
+  logger->report(
+      "{:<20} {:>10} {:>10} {:>12.1f}", "Total", "", "", total / 1024.0);
+}
+
 void dbBlock::getWireUpdatedNets(std::vector<dbNet*>& result)
 {
   dbSet<dbNet> nets = getNets();
@@ -33,6 +33,7 @@
 #pragma once
 
 #include <list>
+#include <mutex>
 #include <vector>
 
 #include "dbCore.h"
@@ -133,6 +134,7 @@ class dbIStream;
 class dbOStream;
 class dbDiff;
 class dbBlockSearch;
+class dbWireShapeCache;
 class dbBlockCallBackObj;
 class dbGuideItr;
 class dbNetTrackItr;
@@ -291,6 +293,9 @@ class _dbBlock : public _dbObject
   dbJournal* _journal;
   dbJournal* _journal_pending;
 
+  dbWireShapeCache* _wire_shape_cache;
+  std::mutex _wire_shape_cache_mutex;
+
   _dbBlock(_dbDatabase* db);
   _dbBlock(_dbDatabase* db, const _dbBlock& block);
   ~_dbBlock();
@@ -33,6 +33,7 @@
 #include "odb/dbBlockCallBackObj.h"
 
 #include "dbBlock.h"
+#include "odb/db.h"
 
 namespace odb {
 
@@ -42,6 +43,34 @@ namespace odb {
 //
 ////////////////////////////////////////////////////////////////////
 
+void dbBlockCallBackObj::inDbNetlistBuilt(
+    const std::vector<dbInst*>& insts,
+    const std::vector<dbNet*>& nets,
+    const std::vector<dbITerm*>& connected_iterms)
+{
+  for (dbInst* inst : insts) {
+    dbRegion* region = inst->getRegion();
+    if (region) {
+      (*this)().inDbInstCreate(inst, region);
+    } else {
+      (*this)().inDbInstCreate(inst);
+    }
+    for (dbITerm* iterm : inst->getITerms()) {
+      (*this)().inDbITermCreate(iterm);
+    }
+  }
+
+  for (dbNet* net : nets) {
+    (*this)().inDbNetCreate(net);
+  }
+
+  for (dbITerm* iterm : connected_iterms) {
+    if (iterm->getNet()) {
+      (*this)().inDbITermPostConnect(iterm);
+    }
+  }
+}
+
 void dbBlockCallBackObj::addOwner(dbBlock* new_owner)
 {
   if (!new_owner) {
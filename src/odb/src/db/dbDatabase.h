@@ -70,7 +70,10 @@ namespace odb {
 const uint db_schema_major = 0;  // Not used...
 const uint db_schema_initial = 57;
 
-const uint db_schema_minor = 85;  // Current revision number
+const uint db_schema_minor = 86;  // Current revision number
+
+// Revision where instance and net names are front-coded
+const uint db_schema_front_coded_names = 86;
 
 // Revision where constraint region was added to dbBTerm
 const uint db_schema_bterm_constraint_region = 85;
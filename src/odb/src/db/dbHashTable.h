@@ -69,8 +69,9 @@ class dbHashTable
   // NON-PERSISTANT-MEMBERS
   dbTable<T>* _obj_tbl;
 
-  void growTable();
-  void shrinkTable();
+  // Resize the table to new_size buckets, a power of two, and reinsert
+  // the entries.
+  void rehash(uint new_size);
 
   dbHashTable();
   dbHashTable(const dbHashTable<T>& table);
@@ -87,6 +88,8 @@ class dbHashTable
   int hasMember(const char* name);
   void insert(T* object);
   void remove(T* object);
+  // Grow the table once for this many entries in total.
+  void reserve(uint num_entries);
 };
 
 template <class T>
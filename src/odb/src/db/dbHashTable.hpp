@@ -82,55 +82,13 @@ bool dbHashTable<T>::operator==(const dbHashTable<T>& rhs) const
 }
 
 template <class T>
-void dbHashTable<T>::growTable()
+void dbHashTable<T>::rehash(uint new_size)
 {
-  uint sz = _hash_tbl.size();
-  dbId<T> entries;
-  uint i;
-
-  for (i = 0; i < sz; ++i) {
-    dbId<T> cur = _hash_tbl[i];
-
-    while (cur != 0) {
-      T* entry = _obj_tbl->getPtr(cur);
-      dbId<T> next = entry->_next_entry;
-      entry->_next_entry = entries;
-      entries = entry->getOID();
-      cur = next;
-    }
-
-    _hash_tbl[i] = 0;
-  }
-
-  // double the size of the hash-table
-  dbId<T> nullId;
-  for (i = 0; i < sz; ++i) {
-    _hash_tbl.push_back(nullId);
-  }
-
-  // reinsert the entries
-  sz = _hash_tbl.size() - 1;
-  dbId<T> cur = entries;
-
-  while (cur != 0) {
-    T* entry = _obj_tbl->getPtr(cur);
-    dbId<T> next = entry->_next_entry;
-    uint hid = hash_string(entry->_name) & sz;
-    dbId<T>& e = _hash_tbl[hid];
-    entry->_next_entry = e;
-    e = entry->getOID();
-    cur = next;
-  }
-}
+  const uint sz = _hash_tbl.size();
 
-template <class T>
-void dbHashTable<T>::shrinkTable()
-{
-  uint sz = _hash_tbl.size();
+  // unlink the entries
   dbId<T> entries;
-  uint i;
-
-  for (i = 0; i < sz; ++i) {
+  for (uint i = 0; i < sz; ++i) {
     dbId<T> cur = _hash_tbl[i];
 
     while (cur != 0) {
@@ -144,25 +102,24 @@ void dbHashTable<T>::shrinkTable()
     _hash_tbl[i] = 0;
   }
 
-  // TODO: add method to dbPagedVector to resize the table
-  _hash_tbl.clear();
-  sz >>= 1;
-
-  // halve the size of the hash-table
+  // resize the hash-table
+  if (new_size < sz) {
+    // TODO: add method to dbPagedVector to resize the table
+    _hash_tbl.clear();
+  }
   dbId<T> nullId;
-  for (i = 0; i < sz; ++i) {
+  for (uint i = _hash_tbl.size(); i < new_size; ++i) {
     _hash_tbl.push_back(nullId);
   }
 
-  sz -= 1;
   // reinsert the entries
+  const uint mask = new_size - 1;
   dbId<T> cur = entries;
 
   while (cur != 0) {
     T* entry = _obj_tbl->getPtr(cur);
     dbId<T> next = entry->_next_entry;
-    uint hid = hash_string(entry->_name) & sz;
-    dbId<T>& e = _hash_tbl[hid];
+    dbId<T>& e = _hash_tbl[hash_string(entry->_name) & mask];
     entry->_next_entry = e;
     e = entry->getOID();
     cur = next;
@@ -183,7 +140,7 @@ void dbHashTable<T>::insert(T* object)
     uint r = _num_entries / sz;
 
     if (r > CHAIN_LENGTH) {
-      growTable();
+      rehash(sz << 1);
       sz = _hash_tbl.size();
     }
   }
@@ -194,6 +151,27 @@ void dbHashTable<T>::insert(T* object)
   e = object->getOID();
 }
 
+template <class T>
+void dbHashTable<T>::reserve(uint num_entries)
+{
+  uint sz = _hash_tbl.size();
+
+  if (sz == 0) {
+    dbId<T> nullId;
+    _hash_tbl.push_back(nullId);
+    sz = 1;
+  }
+
+  uint target = sz;
+  while (num_entries / target > CHAIN_LENGTH) {
+    target <<= 1;
+  }
+
+  if (target != sz) {
+    rehash(target);
+  }
+}
+
 template <class T>
 T* dbHashTable<T>::find(const char* name)
 {
@@ -268,7 +246,7 @@ void dbHashTable<T>::remove(T* object)
       uint r = (_num_entries + _num_entries / 10) / sz;
 
       if ((r < (CHAIN_LENGTH >> 1)) && (sz > 1)) {
-        shrinkTable();
+        rehash(sz >> 1);
       }
 
       return;
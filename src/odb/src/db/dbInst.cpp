@@ -168,7 +168,7 @@ dbOStream& operator<<(dbOStream& stream, const _dbInst& inst)
 {
   uint* bit_field = (uint*) &inst._flags;
   stream << *bit_field;
-  stream << inst._name;
+  stream.writeName(DB_STREAM_INST_NAME, inst._name);
   stream << inst._x;
   stream << inst._y;
   stream << inst._weight;
@@ -194,7 +194,7 @@ dbIStream& operator>>(dbIStream& stream, _dbInst& inst)
 {
   uint* bit_field = (uint*) &inst._flags;
   stream >> *bit_field;
-  stream >> inst._name;
+  stream.readName(DB_STREAM_INST_NAME, inst._name);
   stream >> inst._x;
   stream >> inst._y;
   stream >> inst._weight;
@@ -386,6 +386,77 @@ void dbLib::getBusDelimeters(char& left, char& right)
   right = lib->_right_bus_delimeter;
 }
 
+void dbLib::writeSnapshot(std::ostream& file)
+{
+  _dbLib* lib = (_dbLib*) this;
+  _dbDatabase* db = lib->getDatabase();
+  dbOStream stream(db, file);
+  stream << db_schema_major;
+  stream << db_schema_minor;
+  stream << lib->getOID();
+  stream << db->_lib_tbl->getPropList(lib->getOID());
+  stream << *lib;
+  file.flush();
+}
+
+bool dbLib::readSnapshot(std::istream& file)
+{
+  _dbLib* lib = (_dbLib*) this;
+  _dbDatabase* db = lib->getDatabase();
+  dbIStream stream(db, file);
+
+  uint schema_major;
+  uint schema_minor;
+  stream >> schema_major;
+  stream >> schema_minor;
+  if (schema_major != db_schema_major || schema_minor != db_schema_minor) {
+    return false;
+  }
+
+  uint old_oid;
+  dbId<_dbProperty> prop_list;
+  stream >> old_oid;
+  stream >> prop_list;
+
+  char* name = lib->_name;
+  const dbId<_dbTech> tech = lib->_tech;
+  stream >> *lib;
+  if (lib->_name) {
+    free((void*) lib->_name);
+  }
+  lib->_name = name;
+  lib->_tech = tech;
+
+  // The snapshot may have been written from a library with another id;
+  // fix up the references to it and give the masters fresh database ids.
+  const uint oid = lib->getOID();
+  db->_lib_tbl->setPropList(oid, prop_list);
+  dbSet<_dbProperty> props(lib, lib->_prop_tbl);
+  for (_dbProperty* prop : props) {
+    if (prop->_flags._owner_type == dbLibObj && prop->_owner == old_oid) {
+      prop->_owner = oid;
+    }
+  }
+
+  dbSet<_dbMaster> masters(lib, lib->_master_tbl);
+  for (_dbMaster* master : masters) {
+    master->_id = db->_master_id++;
+    if (master->_lib_for_site == old_oid) {
+      master->_lib_for_site = oid;
+    }
+  }
+
+  dbSet<_dbSite> sites(lib, lib->_site_tbl);
+  for (_dbSite* site : sites) {
+    for (OrientedSiteInternal& row_site : site->_row_pattern) {
+      if (row_site.lib == old_oid) {
+        row_site.lib = oid;
+      }
+    }
+  }
+  return true;
+}
+
 dbLib* dbLib::create(dbDatabase* db_,
                      const char* name,
                      dbTech* tech,
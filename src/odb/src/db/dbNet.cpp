@@ -153,7 +153,7 @@ dbOStream& operator<<(dbOStream& stream, const _dbNet& net)
 {
   uint* bit_field = (uint*) &net._flags;
   stream << *bit_field;
-  stream << net._name;
+  stream.writeName(DB_STREAM_NET_NAME, net._name);
   stream << net._gndc_calibration_factor;
   stream << net._cc_calibration_factor;
   stream << net._next_entry;
@@ -179,7 +179,7 @@ dbIStream& operator>>(dbIStream& stream, _dbNet& net)
 {
   uint* bit_field = (uint*) &net._flags;
   stream >> *bit_field;
-  stream >> net._name;
+  stream.readName(DB_STREAM_NET_NAME, net._name);
   stream >> net._gndc_calibration_factor;
   stream >> net._cc_calibration_factor;
   stream >> net._next_entry;
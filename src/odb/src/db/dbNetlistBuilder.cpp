@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "odb/dbNetlistBuilder.h"
+
+#include <list>
+#include <utility>
+
+#include "dbBlock.h"
+#include "dbBox.h"
+#include "dbHashTable.hpp"
+#include "dbITerm.h"
+#include "dbInst.h"
+#include "dbNet.h"
+#include "dbTable.h"
+#include "dbTable.hpp"
+#include "odb/db.h"
+#include "odb/dbBlockCallBackObj.h"
+
+namespace odb {
+
+namespace {
+
+// Detaches the callbacks of a block for the scope of one builder call.
+class CallbackSuspension
+{
+ public:
+  explicit CallbackSuspension(dbBlock* block) : block_((_dbBlock*) block)
+  {
+    callbacks_.swap(block_->_callbacks);
+  }
+  ~CallbackSuspension() { callbacks_.swap(block_->_callbacks); }
+
+ private:
+  _dbBlock* block_;
+  std::list<dbBlockCallBackObj*> callbacks_;
+};
+
+}  // namespace
+
+dbNetlistBuilder::dbNetlistBuilder(dbBlock* block) : block_(block)
+{
+}
+
+dbNetlistBuilder::~dbNetlistBuilder()
+{
+  commit();
+}
+
+void dbNetlistBuilder::reserve(uint num_insts, uint num_nets, uint num_iterms)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+  block->_inst_tbl->reserve(num_insts);
+  block->_inst_hash.reserve(block->_inst_tbl->size() + num_insts);
+  // one bounding box per instance
+  block->_box_tbl->reserve(num_insts);
+  block->_net_tbl->reserve(num_nets);
+  block->_net_hash.reserve(block->_net_tbl->size() + num_nets);
+  block->_iterm_tbl->reserve(num_iterms);
+
+  insts_.reserve(insts_.size() + num_insts);
+  nets_.reserve(nets_.size() + num_nets);
+}
+
+dbInst* dbNetlistBuilder::createInst(dbMaster* master,
+                                     const char* name,
+                                     dbRegion* region,
+                                     dbModule* parent_module)
+{
+  dbInst* inst;
+  {
+    CallbackSuspension suspension(block_);
+    inst = dbInst::create(block_, master, name, region, false, parent_module);
+  }
+  insts_.push_back(inst);
+  return inst;
+}
+
+dbNet* dbNetlistBuilder::createNet(const char* name)
+{
+  dbNet* net;
+  {
+    CallbackSuspension suspension(block_);
+    net = dbNet::create(block_, name);
+  }
+  if (net) {
+    nets_.push_back(net);
+  }
+  return net;
+}
+
+void dbNetlistBuilder::connect(dbITerm* iterm, dbNet* net)
+{
+  if (iterm->getNet() == net) {
+    return;
+  }
+
+  // Breaking an existing connection is reported right away.
+  if (iterm->getNet()) {
+    iterm->disconnect();
+  }
+
+  {
+    CallbackSuspension suspension(block_);
+    iterm->connect(net);
+  }
+  connected_iterms_.push_back(iterm);
+}
+
+void dbNetlistBuilder::commit()
+{
+  if (insts_.empty() && nets_.empty() && connected_iterms_.empty()) {
+    return;
+  }
+
+  const std::vector<dbInst*> insts = std::move(insts_);
+  const std::vector<dbNet*> nets = std::move(nets_);
+  const std::vector<dbITerm*> connected_iterms = std::move(connected_iterms_);
+  insts_.clear();
+  nets_.clear();
+  connected_iterms_.clear();
+
+  _dbBlock* block = (_dbBlock*) block_;
+  for (dbBlockCallBackObj* callback : block->_callbacks) {
+    (*callback)().inDbNetlistBuilt(insts, nets, connected_iterms);
+  }
+}
+
+}  // namespace odb
@@ -127,6 +127,26 @@ dbOStream::dbOStream(_dbDatabase* db, std::ostream& f) : _f(f)
   }
 }
 
+void dbOStream::writeName(dbStreamNameKind kind, const char* name)
+{
+  std::string& prev = _prev_names[kind];
+  uint prefix = 0;
+  if (name != nullptr) {
+    while (prefix < prev.size() && name[prefix] == prev[prefix]) {
+      ++prefix;
+    }
+  }
+  *this << prefix;
+
+  if (name == nullptr) {
+    *this << (const char*) nullptr;
+    prev.clear();
+  } else {
+    *this << name + prefix;
+    prev.replace(prefix, std::string::npos, name + prefix);
+  }
+}
+
 dbIStream::dbIStream(_dbDatabase* db, std::istream& f) : _f(f)
 {
   _db = db;
@@ -142,6 +162,35 @@ dbIStream::dbIStream(_dbDatabase* db, std::istream& f) : _f(f)
   }
 }
 
+void dbIStream::readName(dbStreamNameKind kind, char*& name)
+{
+  if (!_db->isSchema(db_schema_front_coded_names)) {
+    *this >> name;
+    return;
+  }
+
+  std::string& prev = _prev_names[kind];
+  uint prefix;
+  int l;
+  *this >> prefix;
+  *this >> l;
+
+  if (l == 0) {
+    name = nullptr;
+    prev.clear();
+    return;
+  }
+
+  if (prefix > prev.size()) {
+    throw ZException("database file has a corrupt name");
+  }
+
+  name = (char*) malloc(prefix + l);
+  memcpy(name, prev.data(), prefix);
+  _f.read(name + prefix, l);
+  prev.replace(prefix, std::string::npos, name + prefix);
+}
+
 std::ostream& operator<<(std::ostream& os, const Rect& box)
 {
   os << "( " << box.xMin() << " " << box.yMin() << " ) ( " << box.xMax() << " "
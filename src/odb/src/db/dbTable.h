@@ -103,6 +103,24 @@ class dbTable : public dbObjectTable, public dbIterator
   // clear the table
   void clear();
 
+  // Allocate the pages for "n" more objects up front. The free objects
+  // already in the table are handed out first, then the new ones in
+  // increasing id order.
+  void reserve(uint n);
+
+  // Release the unused pages above the last allocated object and relink
+  // the free-list in increasing id order, so new objects fill the lowest
+  // holes first. Ids of allocated objects never change. Returns the number
+  // of pages released.
+  uint compact();
+
+  // Number of object slots in the allocated pages.
+  uint capacity() const { return _page_cnt * page_size(); }
+
+  // Bytes held by the pages and the page-table. Memory owned by the objects
+  // themselves (names, vectors) is not included.
+  size_t memoryUsage() const;
+
   uint page_size() const { return _page_mask + 1; }
 
   // Get the object of this id
@@ -172,6 +190,7 @@ class dbTable : public dbObjectTable, public dbIterator
   void getObjects(std::vector<T*>& objects);
 
  private:
+  void linkFreeObjects(uint first_page);
   void copy_pages(const dbTable<T>&);
   void copy_page(uint page_id, dbTablePage* page);
 };
@@ -239,6 +239,90 @@ void dbTable<T>::newPage()
   }
 }
 
+template <class T>
+void dbTable<T>::reserve(uint n)
+{
+  // Object zero of the first page is never allocated.
+  const uint num_slots = (_page_cnt << _page_shift) - (_page_cnt != 0);
+  const uint num_free = num_slots - _alloc_cnt;
+  if (n <= num_free) {
+    return;
+  }
+
+  const uint needed = (_page_cnt == 0) ? n + 1 : n - num_free;
+  const uint first_page = _page_cnt;
+  const uint num_pages = (needed + _page_mask) >> _page_shift;
+
+  // The new objects go after the free objects already on the list so those
+  // are still handed out first; within the new pages the lowest id comes
+  // out first.
+  const uint old_free_list = _free_list;
+  _free_list = 0;
+  for (uint i = 0; i < num_pages; ++i) {
+    newPage();
+  }
+  _free_list = 0;
+  linkFreeObjects(first_page);
+
+  if (old_free_list != 0) {
+    _dbFreeObject* tail = (_dbFreeObject*) getFreeObj(old_free_list);
+    while (tail->_next != 0) {
+      tail = (_dbFreeObject*) getFreeObj(tail->_next);
+    }
+    _dbFreeObject* head = (_dbFreeObject*) getFreeObj(_free_list);
+    tail->_next = _free_list;
+    head->_prev = tail->getImpl()->getOID();
+    _free_list = old_free_list;
+  }
+}
+
+template <class T>
+uint dbTable<T>::compact()
+{
+  // Page zero holds the zero-object, it goes only with the rest of an empty
+  // table.
+  const uint num_used = (_alloc_cnt == 0) ? 0 : (_top_idx >> _page_shift) + 1;
+  const uint num_released = _page_cnt - num_used;
+
+  // Only free objects live on these pages, there is nothing to destroy.
+  for (uint page_id = num_used; page_id < _page_cnt; ++page_id) {
+    free((void*) _pages[page_id]);
+    _pages[page_id] = nullptr;
+  }
+  _page_cnt = num_used;
+
+  _free_list = 0;
+  linkFreeObjects(0);
+
+  return num_released;
+}
+
+template <class T>
+size_t dbTable<T>::memoryUsage() const
+{
+  const size_t page_bytes = page_size() * sizeof(T) + sizeof(dbObjectPage);
+  return _page_cnt * page_bytes + _page_tbl_size * sizeof(dbTablePage*);
+}
+
+// Push the free objects of the pages from first_page on onto the free-list,
+// highest id first, so they are handed out in increasing id order.
+template <class T>
+void dbTable<T>::linkFreeObjects(uint first_page)
+{
+  for (uint page_id = _page_cnt; page_id-- > first_page;) {
+    T* b = (T*) _pages[page_id]->_objects;
+    for (T* t = &b[_page_mask]; t >= b; --t) {
+      if (t->_oid & DB_ALLOC_BIT) {
+        continue;
+      }
+      if (page_id == 0 && t == b) {  // don't link zero-object
+        continue;
+      }
+      pushQ(_free_list, (_dbFreeObject*) t);
+    }
+  }
+}
+
 template <class T>
 T* dbTable<T>::create()
 {
@@ -1044,6 +1044,55 @@ void dbTech::checkLayer(bool typeChk,
     }
   }
 }
+void dbTech::writeSnapshot(std::ostream& file)
+{
+  _dbTech* tech = (_dbTech*) this;
+  _dbDatabase* db = tech->getDatabase();
+  dbOStream stream(db, file);
+  stream << db_schema_major;
+  stream << db_schema_minor;
+  stream << tech->getOID();
+  stream << db->_tech_tbl->getPropList(tech->getOID());
+  stream << *tech;
+  file.flush();
+}
+
+bool dbTech::readSnapshot(std::istream& file)
+{
+  _dbTech* tech = (_dbTech*) this;
+  _dbDatabase* db = tech->getDatabase();
+  dbIStream stream(db, file);
+
+  uint schema_major;
+  uint schema_minor;
+  stream >> schema_major;
+  stream >> schema_minor;
+  if (schema_major != db_schema_major || schema_minor != db_schema_minor) {
+    return false;
+  }
+
+  uint old_oid;
+  dbId<_dbProperty> prop_list;
+  stream >> old_oid;
+  stream >> prop_list;
+
+  const std::string name = tech->_name;
+  stream >> *tech;
+  tech->_name = name;
+
+  // The snapshot may have been written from a technology with another id,
+  // re-attach the properties of the technology itself.
+  const uint oid = tech->getOID();
+  db->_tech_tbl->setPropList(oid, prop_list);
+  dbSet<_dbProperty> props(tech, tech->_prop_tbl);
+  for (_dbProperty* prop : props) {
+    if (prop->_flags._owner_type == dbTechObj && prop->_owner == old_oid) {
+      prop->_owner = oid;
+    }
+  }
+  return true;
+}
+
 dbTech* dbTech::create(dbDatabase* db_, const char* name, int dbu_per_micron)
 {
   _dbDatabase* db = (_dbDatabase*) db_;
@@ -438,6 +438,11 @@ void dbWire::donateWireSeg(dbWire* w1, dbRSeg** new_rsegs)
     w1->addOneSeg(opcode, data, jj, destid, new_rsegs);
   }
   free(destid);
+
+  _dbBlock* block = (_dbBlock*) w1->getBlock();
+  for (auto callback : block->_callbacks) {
+    callback->inDbWirePostModify(w1);
+  }
 }
 
 void dbWire::shuffleWireSeg(dbNet** newNets, dbRSeg** new_rsegs)
@@ -1867,6 +1872,11 @@ void dbWire::setRawWireData(const std::vector<int>& data,
   wire->_data = data;
   wire->_opcodes = op_codes;
   net->_flags._wire_ordered = 0;
+
+  _dbBlock* block = (_dbBlock*) wire->getOwner();
+  for (auto callback : block->_callbacks) {
+    callback->inDbWirePostModify(this);
+  }
 }
 
 }  // namespace odb
@@ -0,0 +1,204 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "odb/dbWireShapeCache.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include "odb/db.h"
+
+namespace odb {
+
+dbWireShapeCache::dbWireShapeCache(dbBlock* block)
+{
+  addOwner(block);
+}
+
+dbWireShapeCache::~dbWireShapeCache() = default;
+
+boost::span<const dbShape> dbWireShapeCache::getSegments(dbNet* net)
+{
+  return getNetShapes(net).segments;
+}
+
+boost::span<const dbShape> dbWireShapeCache::getSegments(dbNet* net,
+                                                         dbTechLayer* layer)
+{
+  const NetShapes& shapes = getNetShapes(net);
+  const uint number = layer->getNumber();
+  auto it = std::lower_bound(
+      shapes.layer_starts.begin(),
+      shapes.layer_starts.end(),
+      number,
+      [](const std::pair<uint, int>& start, const uint number) {
+        return start.first < number;
+      });
+  if (it == shapes.layer_starts.end() || it->first != number) {
+    return {};
+  }
+  const int begin = it->second;
+  const int end = (it + 1 == shapes.layer_starts.end())
+                      ? shapes.segments.size()
+                      : (it + 1)->second;
+  return {shapes.segments.data() + begin, static_cast<size_t>(end - begin)};
+}
+
+boost::span<const dbShape> dbWireShapeCache::getVias(dbNet* net)
+{
+  return getNetShapes(net).vias;
+}
+
+void dbWireShapeCache::clear()
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  nets_.clear();
+}
+
+size_t dbWireShapeCache::size()
+{
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return nets_.size();
+}
+
+const dbWireShapeCache::NetShapes& dbWireShapeCache::getNetShapes(dbNet* net)
+{
+  const uint id = net->getId();
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = nets_.find(id);
+    if (it != nets_.end()) {
+      return *it->second;
+    }
+  }
+
+  // Decode outside of the lock so other nets can be read or decoded
+  // meanwhile.  If another thread decoded the same net first its result is
+  // kept.
+  std::unique_ptr<NetShapes> shapes = decode(net);
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  auto [it, inserted] = nets_.emplace(id, std::move(shapes));
+  return *it->second;
+}
+
+std::unique_ptr<dbWireShapeCache::NetShapes> dbWireShapeCache::decode(
+    dbNet* net)
+{
+  auto shapes = std::make_unique<NetShapes>();
+  dbWire* wire = net->getWire();
+  if (!wire) {
+    return shapes;
+  }
+
+  dbWireShapeItr itr;
+  dbShape shape;
+  for (itr.begin(wire); itr.next(shape);) {
+    if (shape.isVia()) {
+      shapes->vias.push_back(shape);
+    } else {
+      shapes->segments.push_back(shape);
+    }
+  }
+  shapes->segments.shrink_to_fit();
+  shapes->vias.shrink_to_fit();
+
+  std::vector<dbShape>& segments = shapes->segments;
+  std::stable_sort(segments.begin(),
+                   segments.end(),
+                   [](const dbShape& a, const dbShape& b) {
+                     return a.getTechLayer()->getNumber()
+                            < b.getTechLayer()->getNumber();
+                   });
+  for (int i = 0; i < segments.size(); ++i) {
+    const uint number = segments[i].getTechLayer()->getNumber();
+    if (i == 0 || number != shapes->layer_starts.back().first) {
+      shapes->layer_starts.emplace_back(number, i);
+    }
+  }
+  return shapes;
+}
+
+void dbWireShapeCache::erase(dbNet* net)
+{
+  if (!net) {
+    return;
+  }
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  nets_.erase(net->getId());
+}
+
+void dbWireShapeCache::invalidate(dbWire* wire)
+{
+  erase(wire->getNet());
+}
+
+void dbWireShapeCache::inDbNetDestroy(dbNet* net)
+{
+  erase(net);
+}
+
+void dbWireShapeCache::inDbWireCreate(dbWire* wire)
+{
+  invalidate(wire);
+}
+
+void dbWireShapeCache::inDbWireDestroy(dbWire* wire)
+{
+  invalidate(wire);
+}
+
+void dbWireShapeCache::inDbWirePostModify(dbWire* wire)
+{
+  invalidate(wire);
+}
+
+void dbWireShapeCache::inDbWirePostAttach(dbWire* wire)
+{
+  invalidate(wire);
+}
+
+void dbWireShapeCache::inDbWirePreDetach(dbWire* wire)
+{
+  invalidate(wire);
+}
+
+void dbWireShapeCache::inDbWirePostAppend(dbWire* /* src */, dbWire* dst)
+{
+  invalidate(dst);
+}
+
+void dbWireShapeCache::inDbWirePostCopy(dbWire* /* src */, dbWire* dst)
+{
+  invalidate(dst);
+}
+
+}  // namespace odb
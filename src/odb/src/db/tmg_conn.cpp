@@ -1643,6 +1643,10 @@ void tmg_conn::treeReorder(const bool no_convert)
 
   checkVisited();
   if (!no_convert) {
+    std::unique_lock<std::mutex> lock;
+    if (_commit_mutex) {
+      lock = std::unique_lock<std::mutex>(*_commit_mutex);
+    }
     _encoder.end();
   }
 }
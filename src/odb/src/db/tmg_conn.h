@@ -34,6 +34,7 @@
 
 #include <array>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "odb/db.h"
@@ -164,10 +165,17 @@ class tmg_conn
   int _shortNmax;
   int _last_id;
   int _firstSegmentAfterVia;
+  std::mutex* _commit_mutex = nullptr;
   utl::Logger* logger_;
 
  public:
   tmg_conn(utl::Logger* logger);
+  ~tmg_conn();
+  tmg_conn(const tmg_conn&) = delete;
+  tmg_conn& operator=(const tmg_conn&) = delete;
+  // When set, rewritten wires are committed to the block under this lock so
+  // several tmg_conn can order the nets of one block concurrently.
+  void setCommitMutex(std::mutex* mutex) { _commit_mutex = mutex; }
   void analyzeNet(dbNet* net);
   void loadNet(dbNet* net);
   void loadWire(dbWire* wire);
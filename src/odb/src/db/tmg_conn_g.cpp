@@ -64,6 +64,7 @@ class tmg_conn_graph
 {
  public:
   tmg_conn_graph();
+  ~tmg_conn_graph();
   void init(int ptN, int shortN);
   tcg_edge* newEdge(const tmg_conn* conn, int fr, int to);
   tcg_edge* newShortEdge(const tmg_conn* conn, int fr, int to);
@@ -105,6 +106,14 @@ tmg_conn_graph::tmg_conn_graph()
   _stackV = (tcg_edge**) malloc(_shortNmax * sizeof(tcg_edge*));
 }
 
+tmg_conn_graph::~tmg_conn_graph()
+{
+  free(_ptV);
+  free(_path_vis);
+  free(_eV);
+  free(_stackV);
+}
+
 void tmg_conn_graph::init(const int ptN, const int shortN)
 {
   if (ptN > _ptNmax) {
@@ -445,6 +454,16 @@ tcg_edge* tmg_conn_graph::getNextEdge(const bool ok_to_descend)
   return nullptr;
 }
 
+tmg_conn::~tmg_conn()
+{
+  free(_termV);
+  free(_tstackV);
+  free(_csNV);
+  free(_shortV);
+  delete _search;
+  delete _graph;
+}
+
 void tmg_conn::relocateShorts()
 {
   _graph->relocateShorts(this);
@@ -32,26 +32,89 @@
 
 #include "odb/wOrder.h"
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "dbBlock.h"
 #include "odb/db.h"
+#include "odb/dbWireShapeCache.h"
 #include "tmg_conn.h"
+#include "utl/ThreadPool.h"
 
 namespace odb {
 
 static tmg_conn* conn = nullptr;
 
+// Nets ordered per parallel task.  Ordering a net is cheap so tasks hold
+// many of them.
+static constexpr int order_nets_per_task = 256;
+
+// Ordering a net with an existing wire and no special wires only rewrites
+// that wire and the net's flags.  Other nets may create wires or destroy
+// special wires, which changes the block's tables.
+static bool canOrderConcurrently(dbNet* net)
+{
+  return net->getWire() != nullptr && net->getSWires().empty();
+}
+
 void orderWires(utl::Logger* logger, dbBlock* block)
 {
   if (conn == nullptr) {
     conn = new tmg_conn(logger);
   }
+
+  _dbBlock* block_impl = (_dbBlock*) block;
+  utl::ThreadPool& pool = utl::ThreadPool::global();
+  // Callbacks and the journal expect changes to come from a single thread.
+  // The wire shape cache is the exception as its updates are serialized by
+  // the commit mutex.
+  const bool only_cache_callbacks = std::all_of(
+      block_impl->_callbacks.begin(),
+      block_impl->_callbacks.end(),
+      [block_impl](dbBlockCallBackObj* callback) {
+        return callback == block_impl->_wire_shape_cache;
+      });
+  const bool concurrent = pool.getThreadCount() > 1 && only_cache_callbacks
+                          && block_impl->_journal == nullptr;
+
+  std::vector<dbNet*> concurrent_nets;
   for (auto net : block->getNets()) {
     if (net->getSigType().isSupply() || net->isWireOrdered()) {
       continue;
     }
-    conn->analyzeNet(net);
+    if (concurrent && canOrderConcurrently(net)) {
+      concurrent_nets.push_back(net);
+    } else {
+      conn->analyzeNet(net);
+    }
+  }
+
+  if (concurrent_nets.empty()) {
+    return;
   }
-}
 
+  // Each net is ordered independently of the others so the result doesn't
+  // depend on how the nets are spread over the threads.
+  std::mutex commit_mutex;
+  const int net_count = concurrent_nets.size();
+  const int task_count
+      = (net_count + order_nets_per_task - 1) / order_nets_per_task;
+  pool.parallelFor(0, task_count, [&](const int task) {
+    thread_local std::unique_ptr<tmg_conn> thread_conn;
+    if (!thread_conn) {
+      thread_conn = std::make_unique<tmg_conn>(logger);
+    }
+    thread_conn->setCommitMutex(&commit_mutex);
+    const int begin = task * order_nets_per_task;
+    const int end = std::min(begin + order_nets_per_task, net_count);
+    for (int i = begin; i < end; ++i) {
+      thread_conn->analyzeNet(concurrent_nets[i]);
+    }
+    thread_conn->setCommitMutex(nullptr);
+  });
+}
 void orderWires(utl::Logger* logger, dbNet* net)
 {
   if (conn == nullptr) {
@@ -0,0 +1,563 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "odb/gdsout.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "odb/db.h"
+#include "odb/dbShape.h"
+#include "odb/dbTransform.h"
+#include "utl/Logger.h"
+#include "utl/ThreadPool.h"
+
+namespace odb {
+
+namespace {
+
+// GDSII record types
+enum RecordType : uint8_t
+{
+  HEADER = 0x00,
+  BGNLIB = 0x01,
+  LIBNAME = 0x02,
+  UNITS = 0x03,
+  ENDLIB = 0x04,
+  BGNSTR = 0x05,
+  STRNAME = 0x06,
+  ENDSTR = 0x07,
+  BOUNDARY = 0x08,
+  SREF = 0x0a,
+  TEXT = 0x0c,
+  LAYER = 0x0d,
+  DATATYPE = 0x0e,
+  XY = 0x10,
+  ENDEL = 0x11,
+  SNAME = 0x12,
+  TEXTTYPE = 0x16,
+  STRING = 0x19,
+  STRANS = 0x1a,
+  ANGLE = 0x1c
+};
+
+// GDSII record data types
+enum DataType : uint8_t
+{
+  NO_DATA = 0x00,
+  BIT_ARRAY = 0x01,
+  INT2 = 0x02,
+  INT4 = 0x03,
+  REAL8 = 0x05,
+  ASCII = 0x06
+};
+
+using LayerTable = std::unordered_map<dbTechLayer*,
+                                      std::array<gdsout::GdsLayer,
+                                                 gdsout::NUM_PURPOSES>>;
+
+// Appends GDSII records to a buffer.
+class GdsEncoder
+{
+ public:
+  GdsEncoder(const LayerTable& layers, std::string& buffer)
+      : layers_(layers), buffer_(buffer)
+  {
+  }
+
+  void record(RecordType type, DataType data_type, int length = 0)
+  {
+    putInt2(length + 4);
+    buffer_.push_back(type);
+    buffer_.push_back(data_type);
+  }
+
+  void int2Record(RecordType type, int value)
+  {
+    record(type, INT2, 2);
+    putInt2(value);
+  }
+
+  void stringRecord(RecordType type, const std::string& value)
+  {
+    // Strings are padded to an even length.
+    const bool pad = value.size() % 2;
+    record(type, ASCII, value.size() + pad);
+    buffer_ += value;
+    if (pad) {
+      buffer_.push_back('\0');
+    }
+  }
+
+  void timeRecord(RecordType type)
+  {
+    const std::time_t now = std::time(nullptr);
+    std::tm tm;
+    localtime_r(&now, &tm);
+
+    // Modification and access time.
+    record(type, INT2, 24);
+    for (int i = 0; i < 2; ++i) {
+      putInt2(tm.tm_year + 1900);
+      putInt2(tm.tm_mon + 1);
+      putInt2(tm.tm_mday);
+      putInt2(tm.tm_hour);
+      putInt2(tm.tm_min);
+      putInt2(tm.tm_sec);
+    }
+  }
+
+  void beginStructure(const std::string& name)
+  {
+    timeRecord(BGNSTR);
+    stringRecord(STRNAME, name);
+  }
+
+  void endStructure() { record(ENDSTR, NO_DATA); }
+
+  void boundary(dbTechLayer* tech_layer, gdsout::Purpose purpose, Rect rect)
+  {
+    const gdsout::GdsLayer* layer = findLayer(tech_layer, purpose);
+    if (layer == nullptr || rect.dx() == 0 || rect.dy() == 0) {
+      return;
+    }
+
+    record(BOUNDARY, NO_DATA);
+    int2Record(LAYER, layer->layer);
+    int2Record(DATATYPE, layer->datatype);
+    record(XY, INT4, 5 * 8);
+    putPoint(rect.ll());
+    putPoint(rect.lr());
+    putPoint(rect.ur());
+    putPoint(rect.ul());
+    putPoint(rect.ll());
+    record(ENDEL, NO_DATA);
+  }
+
+  void text(dbTechLayer* tech_layer, const Point& point, const std::string& s)
+  {
+    const gdsout::GdsLayer* layer = findLayer(tech_layer, gdsout::LABEL);
+    if (layer == nullptr) {
+      return;
+    }
+
+    record(TEXT, NO_DATA);
+    int2Record(LAYER, layer->layer);
+    int2Record(TEXTTYPE, layer->datatype);
+    record(XY, INT4, 8);
+    putPoint(point);
+    stringRecord(STRING, s);
+    record(ENDEL, NO_DATA);
+  }
+
+  void sref(const std::string& name, const dbTransform& transform)
+  {
+    // GDSII reflects about the x-axis before rotating counterclockwise.
+    bool reflect = false;
+    int angle = 0;
+    switch (transform.getOrient()) {
+      case dbOrientType::R0:
+        break;
+      case dbOrientType::R90:
+        angle = 90;
+        break;
+      case dbOrientType::R180:
+        angle = 180;
+        break;
+      case dbOrientType::R270:
+        angle = 270;
+        break;
+      case dbOrientType::MY:
+        reflect = true;
+        angle = 180;
+        break;
+      case dbOrientType::MYR90:
+        reflect = true;
+        angle = 270;
+        break;
+      case dbOrientType::MX:
+        reflect = true;
+        break;
+      case dbOrientType::MXR90:
+        reflect = true;
+        angle = 90;
+        break;
+    }
+
+    record(SREF, NO_DATA);
+    stringRecord(SNAME, name);
+    if (reflect || angle != 0) {
+      record(STRANS, BIT_ARRAY, 2);
+      putInt2(reflect ? 0x8000 : 0);
+      if (angle != 0) {
+        record(ANGLE, REAL8, 8);
+        putReal8(angle);
+      }
+    }
+    record(XY, INT4, 8);
+    putPoint(transform.getOffset());
+    record(ENDEL, NO_DATA);
+  }
+
+  // A box of a master or a special wire, which may be a via.
+  void box(dbBox* box, gdsout::Purpose purpose)
+  {
+    if (dbTechVia* via = box->getTechVia()) {
+      sref(via->getName(), dbTransform(box->getViaXY()));
+    } else if (dbVia* via = box->getBlockVia()) {
+      sref(via->getName(), dbTransform(box->getViaXY()));
+    } else {
+      boundary(box->getTechLayer(), purpose, box->getBox());
+    }
+  }
+
+  void putInt2(int value)
+  {
+    buffer_.push_back((value >> 8) & 0xff);
+    buffer_.push_back(value & 0xff);
+  }
+
+  void putInt4(int value)
+  {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+      buffer_.push_back((value >> shift) & 0xff);
+    }
+  }
+
+  void putPoint(const Point& point)
+  {
+    putInt4(point.x());
+    putInt4(point.y());
+  }
+
+  // GDSII reals are sign, excess-64 base-16 exponent and a 56 bit mantissa.
+  void putReal8(double value)
+  {
+    uint64_t bits = 0;
+    if (value != 0) {
+      if (value < 0) {
+        bits = uint64_t(1) << 63;
+        value = -value;
+      }
+      int exponent = 64;
+      while (value >= 1) {
+        value /= 16;
+        ++exponent;
+      }
+      while (value < 1.0 / 16) {
+        value *= 16;
+        --exponent;
+      }
+      bits |= uint64_t(exponent) << 56;
+      bits |= uint64_t(value * double(uint64_t(1) << 56));
+    }
+    for (int shift = 56; shift >= 0; shift -= 8) {
+      buffer_.push_back((bits >> shift) & 0xff);
+    }
+  }
+
+ private:
+  const gdsout::GdsLayer* findLayer(dbTechLayer* tech_layer,
+                                    gdsout::Purpose purpose) const
+  {
+    auto it = layers_.find(tech_layer);
+    if (it == layers_.end() || it->second[purpose].layer < 0) {
+      return nullptr;
+    }
+    return &it->second[purpose];
+  }
+
+  const LayerTable& layers_;
+  std::string& buffer_;
+};
+
+void writeMaster(GdsEncoder& encoder, dbMaster* master)
+{
+  encoder.beginStructure(master->getName());
+  for (dbBox* box : master->getObstructions()) {
+    encoder.box(box, gdsout::DRAWING);
+  }
+  for (dbMTerm* mterm : master->getMTerms()) {
+    for (dbMPin* mpin : mterm->getMPins()) {
+      bool labeled = false;
+      for (dbBox* box : mpin->getGeometry()) {
+        encoder.box(box, gdsout::PIN);
+        if (!labeled && !box->isVia()) {
+          const Rect rect = box->getBox();
+          encoder.text(box->getTechLayer(),
+                       Point(rect.xCenter(), rect.yCenter()),
+                       mterm->getName());
+          labeled = true;
+        }
+      }
+    }
+  }
+  encoder.endStructure();
+}
+
+template <typename Via>
+void writeVia(GdsEncoder& encoder, Via* via)
+{
+  encoder.beginStructure(via->getName());
+  for (dbBox* box : via->getBoxes()) {
+    encoder.boundary(box->getTechLayer(), gdsout::DRAWING, box->getBox());
+  }
+  encoder.endStructure();
+}
+
+void writeNet(GdsEncoder& encoder, dbNet* net)
+{
+  if (dbWire* wire = net->getWire()) {
+    dbWireShapeItr itr;
+    dbShape shape;
+    for (itr.begin(wire); itr.next(shape);) {
+      if (dbTechVia* via = shape.getTechVia()) {
+        encoder.sref(via->getName(), dbTransform(shape.getViaXY()));
+      } else if (dbVia* via = shape.getVia()) {
+        encoder.sref(via->getName(), dbTransform(shape.getViaXY()));
+      } else {
+        encoder.boundary(shape.getTechLayer(), gdsout::DRAWING, shape.getBox());
+      }
+    }
+  }
+
+  for (dbSWire* swire : net->getSWires()) {
+    for (dbSBox* sbox : swire->getWires()) {
+      encoder.box(sbox, gdsout::DRAWING);
+    }
+  }
+}
+
+void writeBTerm(GdsEncoder& encoder, dbBTerm* bterm)
+{
+  for (dbBPin* bpin : bterm->getBPins()) {
+    if (!bpin->getPlacementStatus().isPlaced()) {
+      continue;
+    }
+    for (dbBox* box : bpin->getBoxes()) {
+      dbTechLayer* layer = box->getTechLayer();
+      if (layer == nullptr) {
+        continue;
+      }
+      const Rect rect = box->getBox();
+      encoder.boundary(layer, gdsout::PIN, rect);
+      encoder.text(
+          layer, Point(rect.xCenter(), rect.yCenter()), bterm->getName());
+    }
+  }
+}
+
+// Top structure objects are encoded in chunks of this many.
+constexpr int kChunkSize = 1000;
+// Tasks encoded per thread before their buffers are flushed to the stream.
+constexpr int kTasksPerThread = 4;
+
+template <typename T>
+void addChunks(std::vector<std::function<void(GdsEncoder&)>>& tasks,
+               const std::vector<T*>& objects,
+               void (*write)(GdsEncoder&, T*))
+{
+  for (size_t begin = 0; begin < objects.size(); begin += kChunkSize) {
+    const size_t end = std::min(begin + kChunkSize, objects.size());
+    tasks.emplace_back([&objects, write, begin, end](GdsEncoder& encoder) {
+      for (size_t i = begin; i < end; ++i) {
+        write(encoder, objects[i]);
+      }
+    });
+  }
+}
+
+}  // namespace
+
+gdsout::gdsout(utl::Logger* logger, std::ostream& out)
+    : logger_(logger), out_(out)
+{
+}
+
+void gdsout::readLayerMap(const char* file_name)
+{
+  std::ifstream in(file_name);
+  if (!in) {
+    logger_->error(utl::ODB, 408, "Cannot open layer map {}.", file_name);
+  }
+
+  static const std::map<std::string, Purpose> purposes = {
+      {"drawing", DRAWING}, {"pin", PIN}, {"label", LABEL}, {"fill", FILL}};
+
+  std::string line;
+  int line_number = 0;
+  while (std::getline(in, line)) {
+    ++line_number;
+    line = line.substr(0, line.find('#'));
+
+    std::istringstream fields(line);
+    std::string layer_name;
+    std::string purpose;
+    GdsLayer layer;
+    if (!(fields >> layer_name)) {
+      continue;
+    }
+    fields >> purpose >> layer.layer >> layer.datatype;
+    auto it = purposes.find(purpose);
+    if (!fields || it == purposes.end() || layer.layer < 0
+        || layer.datatype < 0) {
+      logger_->error(utl::ODB,
+                     409,
+                     "Invalid layer map entry at {}:{}.",
+                     file_name,
+                     line_number);
+    }
+    layer_map_[{layer_name, it->second}] = layer;
+  }
+  has_layer_map_ = true;
+}
+
+void gdsout::resolveLayers(dbTech* tech)
+{
+  layers_.clear();
+  for (dbTechLayer* layer : tech->getLayers()) {
+    auto& purposes = layers_[layer];
+    for (int purpose = 0; purpose < NUM_PURPOSES; ++purpose) {
+      if (has_layer_map_) {
+        auto it = layer_map_.find({layer->getName(), Purpose(purpose)});
+        purposes[purpose] = (it != layer_map_.end()) ? it->second
+                                                     : GdsLayer{-1, -1};
+      } else {
+        purposes[purpose] = {layer->getNumber(), purpose};
+      }
+    }
+  }
+
+  for (const auto& [key, layer] : layer_map_) {
+    if (tech->findLayer(key.first.c_str()) == nullptr) {
+      logger_->warn(utl::ODB,
+                    410,
+                    "Layer {} of the layer map is not in the technology.",
+                    key.first);
+    }
+  }
+}
+
+void gdsout::writeBlock(dbBlock* block)
+{
+  dbTech* tech = block->getTech();
+  resolveLayers(tech);
+
+  std::vector<dbMaster*> masters;
+  std::vector<dbInst*> insts;
+  std::set<dbMaster*> seen_masters;
+  for (dbInst* inst : block->getInsts()) {
+    if (!inst->getPlacementStatus().isPlaced()) {
+      continue;
+    }
+    insts.push_back(inst);
+    if (seen_masters.insert(inst->getMaster()).second) {
+      masters.push_back(inst->getMaster());
+    }
+  }
+  const std::vector<dbNet*> nets(block->getNets().begin(),
+                                 block->getNets().end());
+  const std::vector<dbBTerm*> bterms(block->getBTerms().begin(),
+                                     block->getBTerms().end());
+  const std::vector<dbFill*> fills(block->getFills().begin(),
+                                   block->getFills().end());
+
+  // Every task encodes into its own buffer; the buffers are written in task
+  // order so the stream does not depend on the thread count.
+  std::vector<std::function<void(GdsEncoder&)>> tasks;
+  tasks.emplace_back([block](GdsEncoder& encoder) {
+    encoder.int2Record(HEADER, 600);
+    encoder.timeRecord(BGNLIB);
+    encoder.stringRecord(LIBNAME, block->getName());
+    // The user unit is a micron.
+    const double dbu = block->getDbUnitsPerMicron();
+    encoder.record(UNITS, REAL8, 16);
+    encoder.putReal8(1.0 / dbu);
+    encoder.putReal8(1e-6 / dbu);
+  });
+  for (dbTechVia* via : tech->getVias()) {
+    tasks.emplace_back([via](GdsEncoder& encoder) { writeVia(encoder, via); });
+  }
+  for (dbVia* via : block->getVias()) {
+    tasks.emplace_back([via](GdsEncoder& encoder) { writeVia(encoder, via); });
+  }
+  for (dbMaster* master : masters) {
+    tasks.emplace_back(
+        [master](GdsEncoder& encoder) { writeMaster(encoder, master); });
+  }
+
+  tasks.emplace_back([block](GdsEncoder& encoder) {
+    encoder.beginStructure(block->getName());
+  });
+  addChunks<dbInst>(tasks, insts, [](GdsEncoder& encoder, dbInst* inst) {
+    encoder.sref(inst->getMaster()->getName(), inst->getTransform());
+  });
+  addChunks<dbNet>(tasks, nets, writeNet);
+  addChunks<dbBTerm>(tasks, bterms, writeBTerm);
+  addChunks<dbFill>(tasks, fills, [](GdsEncoder& encoder, dbFill* fill) {
+    Rect rect;
+    fill->getRect(rect);
+    encoder.boundary(fill->getTechLayer(), gdsout::FILL, rect);
+  });
+  tasks.emplace_back([](GdsEncoder& encoder) {
+    encoder.endStructure();
+    encoder.record(ENDLIB, NO_DATA);
+  });
+
+  // Encode the tasks in windows so only a window's buffers are held in
+  // memory at a time.
+  utl::ThreadPool& pool = utl::ThreadPool::global();
+  const size_t window
+      = static_cast<size_t>(std::max(1, pool.getThreadCount()))
+        * kTasksPerThread;
+  std::vector<std::string> buffers(std::min(window, tasks.size()));
+  for (size_t begin = 0; begin < tasks.size(); begin += window) {
+    const size_t end = std::min(begin + window, tasks.size());
+    pool.parallelFor(begin, end, [&](int i) {
+      std::string& buffer = buffers[i - begin];
+      buffer.clear();
+      GdsEncoder encoder(layers_, buffer);
+      tasks[i](encoder);
+    });
+    for (size_t i = begin; i < end; ++i) {
+      out_ << buffers[i - begin];
+    }
+  }
+}
+
+}  // namespace odb
@@ -37,6 +37,10 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <list>
 #include <sstream>
 #include <string>
@@ -83,7 +87,8 @@ lefin::lefin(dbDatabase* db,
       _dbu_per_micron(1000),
       _override_lef_dbu(false),
       _master_modified(false),
-      _ignore_non_routing_layers(ignore_non_routing_layers)
+      _ignore_non_routing_layers(ignore_non_routing_layers),
+      _tech_hash(0)
 {
 }
 
@@ -131,6 +136,33 @@ dbSite* lefin::findSite(const char* name)
   return site;
 }
 
+// Snapshots of parsed LEF files, see setCacheDir.
+static const char lef_cache_magic[8] = {'O', 'D', 'B', 'L', 'E', 'F', '0', '1'};
+static const uint64_t lef_cache_hash_seed = 0xcbf29ce484222325ULL;
+// Part of every cache key. Bump it whenever lefin changes the objects it
+// builds from the same LEF so that snapshots of older builds are not reused.
+static const int lef_cache_format = 2;
+
+// 64-bit FNV-1a, stable across builds and hosts.
+static uint64_t lef_cache_hash(const char* data, size_t size, uint64_t hash)
+{
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= (unsigned char) data[i];
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// Hash of everything in the technology, the same for a technology parsed
+// from a LEF file and one loaded from its snapshot.
+static uint64_t lef_cache_tech_hash(dbTech* tech)
+{
+  std::ostringstream stream;
+  tech->writeSnapshot(stream);
+  const std::string data = stream.str();
+  return lef_cache_hash(data.data(), data.size(), lef_cache_hash_seed);
+}
+
 void lefin::createLibrary()
 {
   _lib = dbLib::create(_db, _lib_name, _tech, _hier_delimeter);
@@ -2278,6 +2310,156 @@ bool lefin::readLefInner(const char* lef_file)
   return r;
 }
 
+std::string lefin::cacheKey(const char* lef_file)
+{
+  if (_cache_dir.empty()) {
+    return "";
+  }
+
+  std::ifstream file(lef_file, std::ios::binary);
+  if (!file) {
+    return "";
+  }
+
+  // Besides the file contents and the cache format the key covers what the
+  // parsed objects refer to by id: the technology a library is read against
+  // and the sites of the other libraries.
+  std::ostringstream context;
+  context << lef_cache_format << ' ' << _create_tech << _create_lib
+          << _override_lef_dbu << _dbu_per_micron << _skip_obstructions
+          << _ignore_non_routing_layers;
+  if (!_create_tech) {
+    _tech_hash = lef_cache_tech_hash(_tech);
+    context << ' ' << _tech_hash;
+  }
+  if (_create_lib) {
+    for (dbLib* lib : _db->getLibs()) {
+      context << ' ' << lib->getId();
+      for (dbSite* site : lib->getSites()) {
+        context << ' ' << site->getId() << ':' << site->getName();
+      }
+    }
+  }
+
+  const std::string header = context.str();
+  uint64_t hash
+      = lef_cache_hash(header.data(), header.size(), lef_cache_hash_seed);
+  std::vector<char> buffer(1 << 16);
+  while (file) {
+    file.read(buffer.data(), buffer.size());
+    hash = lef_cache_hash(buffer.data(), file.gcount(), hash);
+  }
+
+  return fmt::format("{:016x}", hash);
+}
+
+bool lefin::loadCache(const std::string& key, const char* lef_file)
+{
+  if (key.empty()) {
+    return false;
+  }
+
+  const std::string path = _cache_dir + "/" + key + ".lefcache";
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  const std::string data((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+
+  const size_t header_size = sizeof(lef_cache_magic) + sizeof(uint64_t);
+  uint64_t checksum = 0;
+  if (data.size() > header_size) {
+    std::memcpy(&checksum, data.data() + sizeof(lef_cache_magic), 8);
+  }
+  if (data.size() <= header_size
+      || data.compare(0, sizeof(lef_cache_magic), lef_cache_magic, 8) != 0
+      || checksum
+             != lef_cache_hash(data.data() + header_size,
+                               data.size() - header_size,
+                               lef_cache_hash_seed)) {
+    _logger->warn(utl::ODB, 443, "Ignoring invalid LEF cache file {}.", path);
+    return false;
+  }
+
+  std::istringstream stream(data.substr(header_size));
+  const char contents = stream.get();
+  const bool has_tech = contents & 1;
+  const bool has_lib = contents & 2;
+
+  // A snapshot written by another schema revision is stale; read the LEF
+  // and overwrite it.
+  if (has_tech && !_tech->readSnapshot(stream)) {
+    return false;
+  }
+  if (has_lib) {
+    _lib = dbLib::create(_db, _lib_name, _tech);
+    if (!_lib->readSnapshot(stream)) {
+      if (has_tech) {
+        _logger->error(
+            utl::ODB, 444, "LEF cache file {} is inconsistent.", path);
+      }
+      dbLib::destroy(_lib);
+      _lib = nullptr;
+      return false;
+    }
+  }
+
+  _logger->info(
+      utl::ODB, 441, "LEF file: {}, loaded from cache {}", lef_file, path);
+  return true;
+}
+
+void lefin::saveCache(const std::string& key, const char* lef_file)
+{
+  if (key.empty()) {
+    return;
+  }
+
+  // A library LEF may add vias or rules to the technology.  They are not
+  // part of the library snapshot, so such a file is always parsed.
+  if (!_create_tech && lef_cache_tech_hash(_tech) != _tech_hash) {
+    _logger->info(utl::ODB,
+                  445,
+                  "LEF file: {} changes the technology and is not cached.",
+                  lef_file);
+    return;
+  }
+
+  std::ostringstream payload;
+  payload.put((_create_tech ? 1 : 0) | (_lib ? 2 : 0));
+  if (_create_tech) {
+    _tech->writeSnapshot(payload);
+  }
+  if (_lib) {
+    _lib->writeSnapshot(payload);
+  }
+  const std::string data = payload.str();
+  const uint64_t checksum
+      = lef_cache_hash(data.data(), data.size(), lef_cache_hash_seed);
+
+  // Write to a private file and rename it into place so that concurrent
+  // runs sharing the directory never see a partial snapshot.
+  const std::string path = _cache_dir + "/" + key + ".lefcache";
+  const std::string tmp_path = path + "." + std::to_string(getpid());
+  std::error_code error;
+  std::filesystem::create_directories(_cache_dir, error);
+  std::ofstream file(tmp_path, std::ios::binary);
+  file.write(lef_cache_magic, sizeof(lef_cache_magic));
+  file.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+  file.write(data.data(), data.size());
+  file.close();
+  bool written = !file.fail();
+  if (written) {
+    std::filesystem::rename(tmp_path, path, error);
+    written = !error;
+  }
+  if (!written) {
+    _logger->warn(utl::ODB, 442, "Unable to write LEF cache file {}.", path);
+    std::filesystem::remove(tmp_path, error);
+  }
+}
+
 dbTech* lefin::createTech(const char* name, const char* lef_file)
 {
   lefrSetRelaxMode();
@@ -2286,12 +2468,18 @@ dbTech* lefin::createTech(const char* name, const char* lef_file)
   _tech = dbTech::create(_db, name, _dbu_per_micron);
   _create_tech = true;
 
+  const std::string cache_key = cacheKey(lef_file);
+  if (loadCache(cache_key, lef_file)) {
+    return _tech;
+  }
+
   if (!readLef(lef_file) || _errors != 0) {
     dbTech::destroy(_tech);
     _logger->error(
         utl::ODB, 288, "LEF data from {} is discarded due to errors", lef_file);
   }
 
+  saveCache(cache_key, lef_file);
   return _tech;
 }
 
@@ -2316,6 +2504,11 @@ dbLib* lefin::createLib(dbTech* tech, const char* name, const char* lef_file)
   _lib_name = name;
   _create_lib = true;
 
+  const std::string cache_key = cacheKey(lef_file);
+  if (loadCache(cache_key, lef_file)) {
+    return _lib;
+  }
+
   if (!readLef(lef_file) || _errors != 0) {
     if (_lib) {
       dbLib::destroy(_lib);
@@ -2324,6 +2517,7 @@ dbLib* lefin::createLib(dbTech* tech, const char* name, const char* lef_file)
         utl::ODB, 292, "LEF data from {} is discarded due to errors", lef_file);
   }
 
+  saveCache(cache_key, lef_file);
   return _lib;
 }
 
@@ -2352,6 +2546,11 @@ dbLib* lefin::createTechAndLib(const char* tech_name,
   _create_lib = true;
   _create_tech = true;
 
+  const std::string cache_key = cacheKey(lef_file);
+  if (loadCache(cache_key, lef_file)) {
+    return _lib;
+  }
+
   if (!readLef(lef_file) || _errors != 0) {
     if (_lib) {
       dbLib::destroy(_lib);
@@ -2366,6 +2565,7 @@ dbLib* lefin::createTechAndLib(const char* tech_name,
   if (rules.orderReversed())
     rules.reverse();
 
+  saveCache(cache_key, lef_file);
   return _lib;
 }
 
@@ -5,6 +5,7 @@
 #include "CallBack.h"
 #include "helper.h"
 #include "odb/db.h"
+#include "odb/dbNetlistBuilder.h"
 
 namespace odb {
 namespace {
@@ -265,6 +266,41 @@ BOOST_AUTO_TEST_CASE(test_swire)
   BOOST_TEST(cb->events[1] == "PostDestroySBoxes");
   BOOST_TEST(cb->events[2] == "Destroy swire");
 }
+BOOST_AUTO_TEST_CASE(test_netlist_builder)
+{
+  setup();
+  db = createSimpleDB();
+  block = db->getChip()->getBlock();
+  cb->addOwner(block);
+  {
+    dbNetlistBuilder builder(block);
+    builder.reserve(300, 1, 900);
+    dbNet* n1 = builder.createNet("n1");
+    for (int i = 0; i < 300; ++i) {
+      const std::string name = "b" + std::to_string(i);
+      dbInst* inst
+          = builder.createInst(db->findMaster("and2"), name.c_str());
+      builder.connect(inst->findITerm("o"), n1);
+    }
+    BOOST_TEST(cb->events.size() == 0);
+    BOOST_TEST(builder.createNet("n1") == nullptr);
+  }
+  // 300 instances with 3 iterms each, one net and 300 connections
+  BOOST_TEST(cb->events.size() == 300 * 4 + 1 + 300);
+  BOOST_TEST(cb->events[0] == "Create inst b0");
+  BOOST_TEST(cb->events[1] == "Create iterm a of inst b0");
+  BOOST_TEST(cb->events[300 * 4] == "Create net n1");
+  BOOST_TEST(cb->events[300 * 4 + 1] == "PostConnect iterm to net n1");
+  BOOST_TEST(block->findNet("n1")->getITermCount() == 300);
+
+  // The reserved pages still hand out ids in creation order.
+  int next = 0;
+  for (dbInst* inst : block->getInsts()) {
+    BOOST_TEST(inst->getName() == "b" + std::to_string(next++));
+  }
+  BOOST_TEST(next == 300);
+  tearDown();
+}
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace
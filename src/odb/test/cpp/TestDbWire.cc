@@ -11,6 +11,7 @@
 #include "gtest/gtest.h"
 #include "odb/db.h"
 #include "odb/dbWireCodec.h"
+#include "odb/dbWireShapeCache.h"
 #include "odb/lefin.h"
 #include "utl/Logger.h"
 
@@ -130,4 +131,89 @@ TEST_F(OdbMultiPatternedTest, WireColorIsClearedOnNewPath)
   EXPECT_EQ(decoder.getColor().value(), /*mask_color=*/2);
 }
 
+TEST_F(OdbMultiPatternedTest, WireShapeCacheFollowsWireChanges)
+{
+  // Arrange
+  dbNet* net = dbNet::create(block_.get(), "net0");
+  dbTech* tech = lib_->getTech();
+  dbTechLayer* met1 = tech->findLayer("met1");
+  dbTechLayer* met2 = tech->findLayer("met2");
+  dbTechVia* met1_met2 = tech->findVia("M1M2_PR_MR");
+  dbWire* wire = dbWire::create(net);
+
+  dbWireEncoder encoder;
+  encoder.begin(wire);
+  encoder.newPath(met1, dbWireType::ROUTED);
+  encoder.addPoint(50, 50);
+  int junction_1 = encoder.addPoint(100, 50);
+  encoder.addTechVia(met1_met2);
+  encoder.newPath(junction_1);
+  encoder.addPoint(130, 50);
+  encoder.end();
+
+  // Act & Assert
+  dbWireShapeCache* cache = block_->getWireShapeCache();
+  EXPECT_EQ(cache->getSegments(net).size(), 2);
+  EXPECT_EQ(cache->getVias(net).size(), 1);
+  ASSERT_EQ(cache->getSegments(net, met1).size(), 1);
+  EXPECT_EQ(cache->getSegments(net, met1)[0].getTechLayer(), met1);
+  ASSERT_EQ(cache->getSegments(net, met2).size(), 1);
+  EXPECT_EQ(cache->getSegments(net, met2)[0].getTechLayer(), met2);
+
+  // Rewriting the wire drops the decoded shapes
+  encoder.begin(wire);
+  encoder.newPath(met1, dbWireType::ROUTED);
+  encoder.addPoint(50, 50);
+  encoder.addPoint(100, 50);
+  encoder.end();
+
+  EXPECT_EQ(cache->getSegments(net).size(), 1);
+  EXPECT_TRUE(cache->getVias(net).empty());
+  EXPECT_TRUE(cache->getSegments(net, met2).empty());
+
+  // Erasing a net only drops its decoded shapes
+  EXPECT_EQ(cache->size(), 1);
+  cache->erase(net);
+  EXPECT_EQ(cache->size(), 0);
+  EXPECT_EQ(cache->getSegments(net).size(), 1);
+
+  dbWire::destroy(wire);
+  EXPECT_TRUE(cache->getSegments(net).empty());
+}
+
+TEST_F(OdbMultiPatternedTest, WireShapeCacheSurvivesBlockClear)
+{
+  // Arrange
+  dbTechLayer* met1 = lib_->getTech()->findLayer("met1");
+  dbNet* net = dbNet::create(block_.get(), "net0");
+  dbWire* wire = dbWire::create(net);
+
+  dbWireEncoder encoder;
+  encoder.begin(wire);
+  encoder.newPath(met1, dbWireType::ROUTED);
+  encoder.addPoint(50, 50);
+  encoder.addPoint(100, 50);
+  encoder.end();
+  EXPECT_EQ(block_->getWireShapeCache()->getSegments(net).size(), 1);
+
+  // Act
+  block_->clear();
+
+  // Assert: net and wire events after the clear must not reach the
+  // destroyed cache
+  net = dbNet::create(block_.get(), "net0");
+  wire = dbWire::create(net);
+  encoder.begin(wire);
+  encoder.newPath(met1, dbWireType::ROUTED);
+  encoder.addPoint(50, 50);
+  encoder.addPoint(100, 50);
+  encoder.addPoint(100, 150);
+  encoder.end();
+
+  dbWireShapeCache* cache = block_->getWireShapeCache();
+  EXPECT_EQ(cache->getSegments(net).size(), 2);
+  dbNet::destroy(net);
+  EXPECT_EQ(cache->size(), 0);
+}
+
 }  // namespace odb
@@ -0,0 +1,350 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "odb/db.h"
+#include "odb/dbWireCodec.h"
+#include "odb/gdsout.h"
+#include "utl/Logger.h"
+
+namespace odb {
+namespace {
+
+// The parts of a GDSII element checked by these tests.
+struct Element
+{
+  int type = 0;
+  int layer = -1;
+  int datatype = -1;
+  std::vector<Point> xy;
+  std::string name;
+  int strans = 0;
+  double angle = 0;
+};
+
+struct Structure
+{
+  std::string name;
+  std::vector<Element> elements;
+};
+
+// Reads back the records written by gdsout.
+class GdsReader
+{
+ public:
+  explicit GdsReader(const std::string& data) : data_(data) {}
+
+  std::vector<Structure> read()
+  {
+    std::vector<Structure> structures;
+    Element element;
+    size_t pos = 0;
+    while (pos < data_.size()) {
+      const int length = int2(pos);
+      const int type = byte(pos + 2);
+      const size_t data = pos + 4;
+      const int data_length = length - 4;
+      EXPECT_GE(length, 4);
+      switch (type) {
+        case 0x03:  // UNITS
+          user_unit_ = real8(data);
+          break;
+        case 0x05:  // BGNSTR
+          structures.emplace_back();
+          break;
+        case 0x06:  // STRNAME
+          structures.back().name = ascii(data, data_length);
+          break;
+        case 0x08:  // BOUNDARY
+        case 0x0a:  // SREF
+        case 0x0c:  // TEXT
+          element = Element();
+          element.type = type;
+          break;
+        case 0x0d:  // LAYER
+          element.layer = int2(data);
+          break;
+        case 0x0e:  // DATATYPE
+        case 0x16:  // TEXTTYPE
+          element.datatype = int2(data);
+          break;
+        case 0x10:  // XY
+          for (int i = 0; i < data_length; i += 8) {
+            element.xy.emplace_back(int4(data + i), int4(data + i + 4));
+          }
+          break;
+        case 0x12:  // SNAME
+        case 0x19:  // STRING
+          element.name = ascii(data, data_length);
+          break;
+        case 0x1a:  // STRANS
+          element.strans = uint16_t(int2(data));  // a bit array
+          break;
+        case 0x1c:  // ANGLE
+          element.angle = real8(data);
+          break;
+        case 0x11:  // ENDEL
+          structures.back().elements.push_back(element);
+          break;
+        case 0x04:  // ENDLIB
+          ended_ = true;
+          break;
+      }
+      pos += length;
+    }
+    return structures;
+  }
+
+  double userUnit() const { return user_unit_; }
+  bool ended() const { return ended_; }
+
+ private:
+  int byte(size_t pos) const { return (unsigned char) data_[pos]; }
+
+  int int2(size_t pos) const
+  {
+    return int16_t((byte(pos) << 8) | byte(pos + 1));
+  }
+
+  int int4(size_t pos) const
+  {
+    return int32_t((uint32_t(byte(pos)) << 24) | (byte(pos + 1) << 16)
+                   | (byte(pos + 2) << 8) | byte(pos + 3));
+  }
+
+  double real8(size_t pos) const
+  {
+    uint64_t mantissa = 0;
+    for (int i = 1; i < 8; ++i) {
+      mantissa = (mantissa << 8) | byte(pos + i);
+    }
+    const int exponent = (byte(pos) & 0x7f) - 64;
+    const double value = mantissa / std::pow(2.0, 56) * std::pow(16, exponent);
+    return (byte(pos) & 0x80) ? -value : value;
+  }
+
+  std::string ascii(size_t pos, int length) const
+  {
+    std::string s = data_.substr(pos, length);
+    return s.substr(0, s.find('\0'));
+  }
+
+  const std::string& data_;
+  double user_unit_ = 0;
+  bool ended_ = false;
+};
+
+class GdsWriterTest : public ::testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    db_ = dbDatabase::create();
+    db_->setLogger(&logger_);
+    dbTech* tech = dbTech::create(db_, "tech", 2000);
+    metal1_ = dbTechLayer::create(tech, "metal1", dbTechLayerType::ROUTING);
+    metal1_->setWidth(100);
+    dbTechLayer* via1 = dbTechLayer::create(tech, "via1", dbTechLayerType::CUT);
+    metal2_ = dbTechLayer::create(tech, "metal2", dbTechLayerType::ROUTING);
+    metal2_->setWidth(100);
+
+    dbTechVia* via = dbTechVia::create(tech, "M2_M1");
+    dbBox::create(via, metal1_, -50, -50, 50, 50);
+    dbBox::create(via, via1, -40, -40, 40, 40);
+    dbBox::create(via, metal2_, -50, -50, 50, 50);
+
+    dbLib* lib = dbLib::create(db_, "lib", tech);
+    dbMaster* master = dbMaster::create(lib, "INV");
+    master->setWidth(1000);
+    master->setHeight(2000);
+    master->setType(dbMasterType::CORE);
+    dbMTerm* mterm
+        = dbMTerm::create(master, "A", dbIoType::INPUT, dbSigType::SIGNAL);
+    dbBox::create(dbMPin::create(mterm), metal1_, 100, 100, 200, 300);
+    master->setFrozen();
+
+    dbBlock* block = dbBlock::create(dbChip::create(db_), "top");
+    dbInst* inst = dbInst::create(block, master, "u1");
+    inst->setOrient(dbOrientType::MX);
+    inst->setOrigin(1000, 2000);
+    inst->setPlacementStatus(dbPlacementStatus::PLACED);
+
+    dbNet* net = dbNet::create(block, "n1");
+    dbWireEncoder encoder;
+    encoder.begin(dbWire::create(net));
+    encoder.newPath(metal1_, dbWireType::ROUTED);
+    encoder.addPoint(0, 0);
+    encoder.addPoint(2000, 0);
+    encoder.addTechVia(via);
+    encoder.addPoint(2000, 1000);
+    encoder.end();
+
+    dbBPin* bpin = dbBPin::create(dbBTerm::create(net, "in"));
+    dbBox::create(bpin, metal2_, 0, 0, 100, 100);
+    bpin->setPlacementStatus(dbPlacementStatus::PLACED);
+
+    dbFill::create(block, false, 0, metal1_, 5000, 5000, 5100, 5100);
+  }
+
+  void TearDown() override { dbDatabase::destroy(db_); }
+
+  std::vector<Structure> write(const char* layer_map = nullptr)
+  {
+    std::ostringstream out;
+    gdsout writer(&logger_, out);
+    if (layer_map) {
+      writer.readLayerMap(layer_map);
+    }
+    writer.writeBlock(db_->getChip()->getBlock());
+    data_ = out.str();
+    GdsReader reader(data_);
+    std::vector<Structure> structures = reader.read();
+    EXPECT_TRUE(reader.ended());
+    EXPECT_DOUBLE_EQ(reader.userUnit(), 1.0 / 2000);
+    return structures;
+  }
+
+  static const Structure* find(const std::vector<Structure>& structures,
+                               const std::string& name)
+  {
+    for (const Structure& structure : structures) {
+      if (structure.name == name) {
+        return &structure;
+      }
+    }
+    return nullptr;
+  }
+
+  utl::Logger logger_;
+  dbDatabase* db_ = nullptr;
+  dbTechLayer* metal1_ = nullptr;
+  dbTechLayer* metal2_ = nullptr;
+  std::string data_;
+};
+
+TEST_F(GdsWriterTest, WritesHierarchyAndShapes)
+{
+  const std::vector<Structure> structures = write();
+  ASSERT_EQ(structures.size(), 3);
+  EXPECT_EQ(structures.back().name, "top");
+
+  const Structure* via = find(structures, "M2_M1");
+  ASSERT_NE(via, nullptr);
+  EXPECT_EQ(via->elements.size(), 3);
+
+  const Structure* master = find(structures, "INV");
+  ASSERT_NE(master, nullptr);
+  ASSERT_EQ(master->elements.size(), 2);
+  const Element& pin = master->elements[0];
+  EXPECT_EQ(pin.type, 0x08);
+  EXPECT_EQ(pin.layer, metal1_->getNumber());
+  EXPECT_EQ(pin.datatype, gdsout::PIN);
+  ASSERT_EQ(pin.xy.size(), 5);
+  EXPECT_EQ(pin.xy[0], Point(100, 100));
+  EXPECT_EQ(pin.xy[2], Point(200, 300));
+  const Element& label = master->elements[1];
+  EXPECT_EQ(label.type, 0x0c);
+  EXPECT_EQ(label.datatype, gdsout::LABEL);
+  EXPECT_EQ(label.name, "A");
+
+  int metal1_wires = 0;
+  int metal2_wires = 0;
+  int fills = 0;
+  int pins = 0;
+  bool found_inst = false;
+  bool found_via = false;
+  for (const Element& element : structures.back().elements) {
+    if (element.type == 0x0a && element.name == "INV") {
+      found_inst = true;
+      EXPECT_EQ(element.strans, 0x8000);
+      EXPECT_EQ(element.angle, 0);
+      EXPECT_EQ(element.xy[0], Point(1000, 2000));
+    } else if (element.type == 0x0a && element.name == "M2_M1") {
+      found_via = true;
+      EXPECT_EQ(element.xy[0], Point(2000, 0));
+    } else if (element.type == 0x08) {
+      if (element.datatype == gdsout::DRAWING) {
+        metal1_wires += element.layer == metal1_->getNumber();
+        metal2_wires += element.layer == metal2_->getNumber();
+      } else if (element.datatype == gdsout::FILL) {
+        ++fills;
+        EXPECT_EQ(element.xy[0], Point(5000, 5000));
+      } else if (element.datatype == gdsout::PIN) {
+        ++pins;
+      }
+    } else if (element.type == 0x0c) {
+      EXPECT_EQ(element.name, "in");
+    }
+  }
+  EXPECT_TRUE(found_inst);
+  EXPECT_TRUE(found_via);
+  EXPECT_EQ(metal1_wires, 1);
+  EXPECT_EQ(metal2_wires, 1);
+  EXPECT_EQ(fills, 1);
+  EXPECT_EQ(pins, 1);
+}
+
+TEST_F(GdsWriterTest, LayerMapSelectsLayers)
+{
+  const std::string map_file
+      = (std::filesystem::temp_directory_path() / "gds_layer_map.txt")
+            .string();
+  {
+    std::ofstream map(map_file);
+    map << "# layer purpose gds_layer gds_datatype\n";
+    map << "metal1 drawing 31 7\n";
+  }
+
+  const std::vector<Structure> structures = write(map_file.c_str());
+  std::filesystem::remove(map_file);
+
+  for (const Structure& structure : structures) {
+    for (const Element& element : structure.elements) {
+      if (element.type == 0x08) {
+        EXPECT_EQ(element.layer, 31);
+        EXPECT_EQ(element.datatype, 7);
+      }
+      EXPECT_NE(element.type, 0x0c);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace odb
@@ -0,0 +1,247 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "odb/db.h"
+#include "odb/lefin.h"
+#include "utl/Logger.h"
+
+namespace odb {
+namespace {
+
+dbLib* readLefs(dbDatabase* db,
+                utl::Logger* logger,
+                const std::string& cache_dir)
+{
+  db->setLogger(logger);
+  lefin tech_reader(db, logger, /*ignore_non_routing_layers=*/false);
+  tech_reader.setCacheDir(cache_dir);
+  dbLib* lib = tech_reader.createTechAndLib(
+      "gscl45nm", "gscl45nm", "data/gscl45nm.lef");
+
+  lefin lib_reader(db, logger, /*ignore_non_routing_layers=*/false);
+  lib_reader.setCacheDir(cache_dir);
+  lib_reader.createLib(lib->getTech(), "ext", "data/gscl45nm_ext_macros.lef");
+  return lib;
+}
+
+void expectSameLibs(dbDatabase* expected, dbDatabase* actual)
+{
+  dbTech* expected_tech = expected->getTech();
+  dbTech* actual_tech = actual->getTech();
+  EXPECT_EQ(actual_tech->getName(), expected_tech->getName());
+  EXPECT_EQ(actual_tech->getDbUnitsPerMicron(),
+            expected_tech->getDbUnitsPerMicron());
+  ASSERT_EQ(actual_tech->getLayers().size(), expected_tech->getLayers().size());
+  for (dbTechLayer* layer : expected_tech->getLayers()) {
+    dbTechLayer* other = actual_tech->findLayer(layer->getConstName());
+    ASSERT_NE(other, nullptr);
+    EXPECT_EQ(other->getId(), layer->getId());
+    EXPECT_EQ(other->getWidth(), layer->getWidth());
+    EXPECT_EQ(other->getSpacing(), layer->getSpacing());
+  }
+  EXPECT_EQ(actual_tech->getVias().size(), expected_tech->getVias().size());
+
+  ASSERT_EQ(actual->getLibs().size(), expected->getLibs().size());
+  for (dbLib* lib : expected->getLibs()) {
+    dbLib* other = actual->findLib(lib->getConstName());
+    ASSERT_NE(other, nullptr);
+    EXPECT_EQ(other->getTech(), actual_tech);
+    ASSERT_EQ(other->getMasters().size(), lib->getMasters().size());
+    for (dbMaster* master : lib->getMasters()) {
+      dbMaster* other_master = other->findMaster(master->getConstName());
+      ASSERT_NE(other_master, nullptr);
+      EXPECT_EQ(other_master->getWidth(), master->getWidth());
+      EXPECT_EQ(other_master->getHeight(), master->getHeight());
+      EXPECT_EQ(other_master->getMTermCount(), master->getMTermCount());
+      if (master->getSite()) {
+        ASSERT_NE(other_master->getSite(), nullptr);
+        EXPECT_EQ(other_master->getSite()->getName(),
+                  master->getSite()->getName());
+      }
+    }
+  }
+}
+
+TEST(TestLefCache, CachedLefsMatchParsedLefs)
+{
+  utl::Logger logger;
+  const std::string cache_dir = ::testing::TempDir() + "/lef_cache";
+  std::filesystem::remove_all(cache_dir);
+
+  dbDatabase* parsed = dbDatabase::create();
+  readLefs(parsed, &logger, "");
+  dbDatabase* first = dbDatabase::create();
+  readLefs(first, &logger, cache_dir);
+  dbDatabase* cached = dbDatabase::create();
+  readLefs(cached, &logger, cache_dir);
+
+  int num_snapshots = 0;
+  for (const auto& entry : std::filesystem::directory_iterator(cache_dir)) {
+    EXPECT_EQ(entry.path().extension(), ".lefcache");
+    ++num_snapshots;
+  }
+  EXPECT_EQ(num_snapshots, 2);
+
+  expectSameLibs(parsed, first);
+  expectSameLibs(parsed, cached);
+
+  // Masters loaded from a snapshot still get unique ids.
+  EXPECT_EQ(cached->getNumberOfMasters(), parsed->getNumberOfMasters());
+
+  dbDatabase::destroy(parsed);
+  dbDatabase::destroy(first);
+  dbDatabase::destroy(cached);
+  std::filesystem::remove_all(cache_dir);
+}
+
+void writeFile(const std::string& path, const char* contents)
+{
+  std::ofstream file(path);
+  file << contents;
+}
+
+constexpr const char* via_rule_tech_lef = R"(VERSION 5.8 ;
+BUSBITCHARS "[]" ;
+DIVIDERCHAR "/" ;
+UNITS
+  DATABASE MICRONS 2000 ;
+END UNITS
+MANUFACTURINGGRID 0.005 ;
+
+LAYER metal1
+  TYPE ROUTING ;
+  DIRECTION HORIZONTAL ;
+  PITCH 0.19 ;
+  WIDTH 0.07 ;
+  SPACING 0.065 ;
+END metal1
+
+LAYER via1
+  TYPE CUT ;
+  SPACING 0.08 ;
+  WIDTH 0.07 ;
+END via1
+
+LAYER metal2
+  TYPE ROUTING ;
+  DIRECTION VERTICAL ;
+  PITCH 0.19 ;
+  WIDTH 0.07 ;
+  SPACING 0.07 ;
+END metal2
+
+VIARULE via1Array GENERATE
+  LAYER metal1 ;
+    ENCLOSURE 0 0.035 ;
+  LAYER metal2 ;
+    ENCLOSURE 0 0.035 ;
+  LAYER via1 ;
+    RECT -0.035 -0.035 0.035 0.035 ;
+    SPACING 0.15 BY 0.15 ;
+END via1Array
+
+END LIBRARY
+)";
+
+constexpr const char* via_rule_lib_lef = R"(VERSION 5.8 ;
+BUSBITCHARS "[]" ;
+DIVIDERCHAR "/" ;
+
+VIA via1_2x1 DEFAULT
+  VIARULE via1Array ;
+  CUTSIZE 0.07 0.07 ;
+  LAYERS metal1 via1 metal2 ;
+  CUTSPACING 0.08 0.08 ;
+  ENCLOSURE 0 0.035 0 0.035 ;
+  ROWCOL 1 2 ;
+END via1_2x1
+
+MACRO TAP
+  CLASS CORE WELLTAP ;
+  ORIGIN 0 0 ;
+  SIZE 0.19 BY 1.4 ;
+END TAP
+
+END LIBRARY
+)";
+
+// A library LEF can add vias to the technology, which its snapshot can't
+// hold, so it is parsed every time while its technology is still cached.
+TEST(TestLefCache, LibraryWithTechViasIsNotCached)
+{
+  utl::Logger logger;
+  const std::string dir = ::testing::TempDir() + "/lef_cache_via_rule";
+  const std::string cache_dir = dir + "/cache";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const std::string tech_lef = dir + "/tech.lef";
+  const std::string lib_lef = dir + "/lib.lef";
+  writeFile(tech_lef, via_rule_tech_lef);
+  writeFile(lib_lef, via_rule_lib_lef);
+
+  for (int i = 0; i < 2; i++) {
+    dbDatabase* db = dbDatabase::create();
+    db->setLogger(&logger);
+    lefin tech_reader(db, &logger, /*ignore_non_routing_layers=*/false);
+    tech_reader.setCacheDir(cache_dir);
+    dbTech* tech = tech_reader.createTech("tech", tech_lef.c_str());
+    ASSERT_NE(tech, nullptr);
+    EXPECT_EQ(tech->getVias().size(), 0);
+
+    lefin lib_reader(db, &logger, /*ignore_non_routing_layers=*/false);
+    lib_reader.setCacheDir(cache_dir);
+    dbLib* lib = lib_reader.createLib(tech, "lib", lib_lef.c_str());
+    ASSERT_NE(lib, nullptr);
+    EXPECT_NE(lib->findMaster("TAP"), nullptr);
+    dbTechVia* via = tech->findVia("via1_2x1");
+    ASSERT_NE(via, nullptr);
+    EXPECT_NE(via->getViaGenerateRule(), nullptr);
+    dbDatabase::destroy(db);
+  }
+
+  int num_snapshots = 0;
+  for (const auto& entry : std::filesystem::directory_iterator(cache_dir)) {
+    EXPECT_EQ(entry.path().extension(), ".lefcache");
+    ++num_snapshots;
+  }
+  EXPECT_EQ(num_snapshots, 1);
+
+  std::filesystem::remove_all(dir);
+}
+
+}  // namespace
+}  // namespace odb
@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "dbDatabase.h"
+#include "gtest/gtest.h"
+#include "odb/db.h"
+#include "odb/dbStream.h"
+#include "utl/Logger.h"
+
+namespace odb {
+namespace {
+
+// A name and the kind it is written as; nullptr stands for a null name.
+struct Name
+{
+  dbStreamNameKind kind;
+  const char* name;
+};
+
+std::vector<std::string> readNames(dbDatabase* db,
+                                   const std::string& data,
+                                   const std::vector<Name>& names)
+{
+  std::istringstream in(data);
+  dbIStream stream((_dbDatabase*) db, in);
+  std::vector<std::string> result;
+  for (const Name& name : names) {
+    char* read = nullptr;
+    stream.readName(name.kind, read);
+    result.emplace_back(read ? read : "<null>");
+    free(read);
+  }
+  return result;
+}
+
+std::vector<std::string> expectedNames(const std::vector<Name>& names)
+{
+  std::vector<std::string> result;
+  for (const Name& name : names) {
+    result.emplace_back(name.name ? name.name : "<null>");
+  }
+  return result;
+}
+
+TEST(NameStream, RoundTripsFrontCodedNames)
+{
+  dbDatabase* db = dbDatabase::create();
+
+  const std::vector<Name> names = {
+      {DB_STREAM_INST_NAME, "top/core/alu/add_0"},
+      {DB_STREAM_INST_NAME, "top/core/alu/add_1"},
+      {DB_STREAM_NET_NAME, "top/core/alu/n1"},
+      {DB_STREAM_INST_NAME, "top/core/alu/add_1"},  // same as previous
+      {DB_STREAM_INST_NAME, "top/core/alu"},        // prefix of previous
+      {DB_STREAM_INST_NAME, "io/pad_3"},            // nothing shared
+      {DB_STREAM_NET_NAME, nullptr},
+      {DB_STREAM_NET_NAME, "top/core/alu/n2"},  // after a null name
+      {DB_STREAM_NET_NAME, ""},
+      {DB_STREAM_INST_NAME, "io/pad_30"},
+      {DB_STREAM_NET_NAME, "top/core/alu/n2"},
+  };
+
+  std::ostringstream out;
+  dbOStream stream((_dbDatabase*) db, out);
+  for (const Name& name : names) {
+    stream.writeName(name.kind, name.name);
+  }
+
+  EXPECT_EQ(readNames(db, out.str(), names), expectedNames(names));
+
+  dbDatabase::destroy(db);
+}
+
+TEST(NameStream, ReadsPlainNamesOfSchema85)
+{
+  dbDatabase* db = dbDatabase::create();
+
+  // Before front coding names were written as plain strings
+  const std::vector<Name> names = {
+      {DB_STREAM_INST_NAME, "top/core/alu/add_0"},
+      {DB_STREAM_NET_NAME, nullptr},
+      {DB_STREAM_INST_NAME, "top/core/alu/add_1"},
+      {DB_STREAM_NET_NAME, "top/core/alu/n1"},
+  };
+  std::ostringstream out;
+  dbOStream stream((_dbDatabase*) db, out);
+  for (const Name& name : names) {
+    stream << name.name;
+  }
+
+  ((_dbDatabase*) db)->_schema_minor = 85;
+  EXPECT_EQ(readNames(db, out.str(), names), expectedNames(names));
+
+  dbDatabase::destroy(db);
+}
+
+TEST(NameStream, RoundTripsNamesInterleavedAcrossBlocks)
+{
+  utl::Logger logger;
+  dbDatabase* db = dbDatabase::create();
+  db->setLogger(&logger);
+  dbTech* tech = dbTech::create(db, "tech");
+  dbLib* lib = dbLib::create(db, "lib", tech);
+  dbMaster* master = dbMaster::create(lib, "cell");
+  master->setFrozen();
+  dbBlock* top = dbBlock::create(dbChip::create(db), "top");
+  dbBlock* child = dbBlock::create(top, "child");
+
+  // Alternate between the blocks so consecutive names in the stream come
+  // from different blocks.
+  for (int i = 0; i < 20; ++i) {
+    dbBlock* block = (i % 2 == 0) ? top : child;
+    const std::string suffix = std::to_string(i);
+    dbInst::create(block, master, ("u_core/u_alu/reg_" + suffix).c_str());
+    dbNet::create(block, ("u_core/u_alu/n" + suffix).c_str());
+    dbNet::create(block, ("io_" + suffix).c_str());
+  }
+
+  std::stringstream data;
+  db->write(data);
+
+  dbDatabase* copy = dbDatabase::create();
+  copy->setLogger(&logger);
+  copy->read(data);
+
+  for (dbBlock* block : {top, child}) {
+    dbBlock* read = copy->getChip()->getBlock();
+    if (block == child) {
+      read = read->findChild("child");
+    }
+    ASSERT_NE(read, nullptr);
+    EXPECT_EQ(read->getInsts().size(), block->getInsts().size());
+    EXPECT_EQ(read->getNets().size(), block->getNets().size());
+    for (dbInst* inst : block->getInsts()) {
+      dbInst* read_inst = dbInst::getInst(read, inst->getId());
+      EXPECT_EQ(read_inst->getName(), inst->getName());
+    }
+    for (dbNet* net : block->getNets()) {
+      dbNet* read_net = dbNet::getNet(read, net->getId());
+      EXPECT_EQ(read_net->getName(), net->getName());
+      EXPECT_EQ(read->findNet(net->getConstName()), read_net);
+    }
+  }
+
+  dbDatabase::destroy(copy);
+  dbDatabase::destroy(db);
+}
+
+}  // namespace
+}  // namespace odb
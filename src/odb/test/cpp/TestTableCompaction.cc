@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "odb/db.h"
+#include "odb/dbNetlistBuilder.h"
+#include "utl/Logger.h"
+
+namespace odb {
+namespace {
+
+TEST(TableCompaction, KeepsIdsAndReusesLowestFreeId)
+{
+  utl::Logger logger;
+  dbDatabase* db = dbDatabase::create();
+  db->setLogger(&logger);
+  dbTech::create(db, "tech");
+  dbBlock* block = dbBlock::create(dbChip::create(db), "block");
+
+  std::vector<dbNet*> nets;
+  for (int i = 0; i < 1000; ++i) {
+    nets.push_back(dbNet::create(block, ("n" + std::to_string(i)).c_str()));
+  }
+
+  // Keep the even nets of the first hundred, free all others.
+  const uint first_free_id = nets[1]->getId();
+  std::vector<std::pair<std::string, uint>> kept;
+  for (int i = 0; i < 1000; ++i) {
+    if (i < 100 && i % 2 == 0) {
+      kept.emplace_back(nets[i]->getName(), nets[i]->getId());
+    } else {
+      dbNet::destroy(nets[i]);
+    }
+  }
+
+  EXPECT_GT(block->compactTables(), 0);
+  EXPECT_EQ(block->compactTables(), 0);
+
+  EXPECT_EQ(block->getNets().size(), kept.size());
+  for (const auto& [name, id] : kept) {
+    dbNet* net = block->findNet(name.c_str());
+    ASSERT_NE(net, nullptr);
+    EXPECT_EQ(net->getId(), id);
+  }
+
+  EXPECT_EQ(dbNet::create(block, "new")->getId(), first_free_id);
+
+  dbDatabase::destroy(db);
+}
+
+TEST(TableReserve, HandsOutFreeObjectsBeforeNewPages)
+{
+  utl::Logger logger;
+  dbDatabase* db = dbDatabase::create();
+  db->setLogger(&logger);
+  dbTech::create(db, "tech");
+  dbBlock* block = dbBlock::create(dbChip::create(db), "block");
+
+  std::vector<dbNet*> nets;
+  for (int i = 0; i < 10; ++i) {
+    nets.push_back(dbNet::create(block, ("n" + std::to_string(i)).c_str()));
+  }
+  const uint free_id = nets[3]->getId();
+  const uint top_id = nets.back()->getId();
+  dbNet::destroy(nets[3]);
+
+  {
+    dbNetlistBuilder builder(block);
+    builder.reserve(0, 5000, 0);
+    EXPECT_EQ(builder.createNet("a")->getId(), free_id);
+    EXPECT_EQ(builder.createNet("b")->getId(), top_id + 1);
+  }
+  // The pages were reserved even though the table had a free object
+  EXPECT_GT(block->compactTables(), 0);
+
+  for (int i = 0; i < 5000; ++i) {
+    dbNet::create(block, ("m" + std::to_string(i)).c_str());
+  }
+  EXPECT_EQ(block->getNets().size(), 5011);
+  for (int i = 0; i < 5000; ++i) {
+    dbNet* net = block->findNet(("m" + std::to_string(i)).c_str());
+    ASSERT_NE(net, nullptr);
+    EXPECT_EQ(net->getId(), top_id + 2 + i);
+  }
+
+  // Removing most entries shrinks the hash table, lookups still work
+  for (int i = 0; i < 4990; ++i) {
+    dbNet::destroy(block->findNet(("m" + std::to_string(i)).c_str()));
+  }
+  EXPECT_NE(block->findNet("m4999"), nullptr);
+  EXPECT_NE(block->findNet("a"), nullptr);
+  EXPECT_EQ(block->findNet("m0"), nullptr);
+
+  dbDatabase::destroy(db);
+}
+
+}  // namespace
+}  // namespace odb
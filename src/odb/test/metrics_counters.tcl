@@ -0,0 +1,25 @@
+# Design counters recorded with each metrics stage
+source "helpers.tcl"
+
+set metrics [make_result_file metrics_counters.json]
+utl::open_metrics $metrics
+utl::set_metrics_stage "load__{}"
+read_lef "data/gscl45nm.lef"
+read_def "data/design.def"
+utl::clear_metrics_stage
+utl::close_metrics $metrics
+
+set stream [open $metrics r]
+set json [read $stream]
+close $stream
+foreach metric {design__instance__count design__net__count design__io__count} {
+  foreach suffix {start end} {
+    regexp "\"load__${metric}__${suffix}\": (\[0-9\]+)" $json ignore value
+    puts "$metric $suffix $value"
+  }
+}
+
+# A stage still open at exit is closed before the design is destroyed.
+utl::set_metrics_stage "exit__{}"
+puts "pass"
+exit 0
@@ -38,12 +38,12 @@
 #include <functional>
 #include <queue>
 #include <random>
-#include <thread>
 
 #include "Evaluator.h"
 #include "Hypergraph.h"
 #include "Partitioner.h"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 namespace par {
 
@@ -519,20 +519,10 @@ void MultilevelPartitioner::RefinePartition(
     }
 
     // Parallel refine all the solutions
-    std::vector<std::thread> threads;
-    threads.reserve(top_solutions.size());
-    for (auto& top_solution : top_solutions) {
-      threads.emplace_back(&par::MultilevelPartitioner::CallRefiner,
-                           this,
-                           hgraph,
-                           std::ref(upper_block_balance),
-                           std::ref(lower_block_balance),
-                           std::ref(top_solution));
-    }
-    for (auto& th : threads) {
-      th.join();
-    }
-    threads.clear();
+    utl::ThreadPool::global().parallelFor(0, top_solutions.size(), [&](int i) {
+      CallRefiner(
+          hgraph, upper_block_balance, lower_block_balance, top_solutions[i]);
+    });
 
     // update the best_solution_id
     float best_cost = std::numeric_limits<float>::max();
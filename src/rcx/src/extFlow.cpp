@@ -33,6 +33,7 @@
 #include <map>
 #include <vector>
 
+#include "odb/dbWireShapeCache.h"
 #include "rcx/dbUtil.h"
 #include "rcx/extRCap.h"
 #include "utl/Logger.h"
@@ -53,6 +54,7 @@ using odb::dbTechLayerDir;
 using odb::dbTechLayerType;
 using odb::dbTrackGrid;
 using odb::dbWire;
+using odb::dbWireShapeCache;
 using odb::dbWireShapeItr;
 using odb::MAX_INT;
 using odb::MIN_INT;
@@ -581,6 +583,7 @@ uint extMain::signalWireCounter(uint& maxWidth)
   uint cnt = 0;
   dbSet<dbNet> nets = _block->getNets();
   dbSet<dbNet>::iterator net_itr;
+  dbWireShapeCache* cache = _block->getWireShapeCache();
 
   for (net_itr = nets.begin(); net_itr != nets.end(); ++net_itr) {
     dbNet* net = *net_itr;
@@ -594,13 +597,7 @@ uint extMain::signalWireCounter(uint& maxWidth)
       continue;
     }
 
-    dbWireShapeItr shapes;
-    dbShape s;
-    for (shapes.begin(wire); shapes.next(s);) {
-      if (s.isVia()) {
-        continue;
-      }
-
+    for (const dbShape& s : cache->getSegments(net)) {
       uint x = s.getDX();
       uint y = s.getDY();
       uint w = y;
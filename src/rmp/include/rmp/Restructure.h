@@ -37,6 +37,7 @@
 
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "db_sta/dbSta.hh"
 #include "rsz/Resizer.hh"
@@ -97,18 +98,31 @@ class Restructure
   void setTieHiPort(sta::LibertyPort* hiport);
 
  private:
+  // The outcome of one ABC run, passed back from its worker process.
+  struct AbcResult
+  {
+    bool success = false;
+    int failed_command = -1;
+    int num_instances = 0;
+    int level_gain = 0;
+    float delay = 0;
+  };
+
   void deleteComponents();
   void getBlob(unsigned max_depth);
   void runABC();
   void postABC(float worst_slack);
-  bool writeAbcScript(std::string file_name);
-  void writeOptCommands(std::ofstream& script);
+  std::vector<std::string> abcCommands(Mode mode,
+                                       const std::string& output_blif) const;
+  void addOptCommands(Mode mode, std::vector<std::string>& commands) const;
+  bool writeAbcScript(const std::string& file_name,
+                      const std::vector<std::string>& commands);
+  AbcResult runAbcCommands(const std::vector<std::string>& commands);
   void initDB();
   void getEndPoints(sta::PinSet& ends, bool area_mode, unsigned max_depth);
   int countConsts(odb::dbBlock* top_block);
   void removeConstCells();
   void removeConstCell(odb::dbInst* inst);
-  bool readAbcLog(std::string abc_file_name, int& level_gain, float& delay_val);
 
   Logger* logger_;
   std::string logfile_;
@@ -125,7 +139,6 @@ class Restructure
   odb::dbBlock* block_ = nullptr;
 
   std::string input_blif_file_name_;
-  std::string output_blif_file_name_;
   std::vector<std::string> lib_file_names_;
   std::set<odb::dbInst*> path_insts_;
 
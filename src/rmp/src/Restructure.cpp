@@ -40,12 +40,14 @@
 #include <time.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 
 #include "base/abc/abc.h"
 #include "base/main/abcapis.h"
+#include "base/main/main.h"
 #include "db_sta/dbNetwork.hh"
 #include "db_sta/dbSta.hh"
 #include "odb/db.h"
@@ -63,6 +65,7 @@
 #include "sta/Search.hh"
 #include "sta/Sta.hh"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 
 using utl::RMP;
 using namespace abc;
@@ -177,7 +180,6 @@ void Restructure::runABC()
 
   // abc optimization
   std::vector<Mode> modes;
-  std::vector<pid_t> child_proc;
 
   if (is_area_mode_) {
     // Area Mode
@@ -187,96 +189,160 @@ void Restructure::runABC()
     modes = {Mode::DELAY_1, Mode::DELAY_2, Mode::DELAY_3, Mode::DELAY_4};
   }
 
-  child_proc.resize(modes.size(), 0);
-
   std::string best_blif;
   int best_inst_count = std::numeric_limits<int>::max();
   float best_delay_gain = std::numeric_limits<float>::max();
 
+  if (logfile_.empty()) {
+    logfile_ = work_dir_name_ + "abc.log";
+  }
+
   debugPrint(
       logger_, RMP, "remap", 1, "Running ABC with {} modes.", modes.size());
 
+  // ABC keeps its state in a process wide frame so each mode runs in its
+  // own forked worker.  The workers send their scores back through a pipe
+  // and at most one worker per thread is alive at a time.
+  //
+  // Only this thread exists in a forked worker; locks held by the other
+  // threads (thread pool, sta, logger sinks) at fork time are never
+  // released there.  The worker must therefore only run ABC and write to
+  // its own stdout and pipe: no logging and nothing that reaches shared
+  // OpenROAD state.
+  std::vector<pid_t> child_proc(modes.size(), -1);
+  std::vector<int> result_fds(modes.size(), -1);
+  std::vector<AbcResult> results(modes.size());
+  std::vector<char> received(modes.size(), false);
+  const size_t max_children
+      = std::max(1, utl::ThreadPool::global().getThreadCount());
+  size_t live_children = 0;
+  size_t next_collect = 0;
+  auto collect = [&](size_t mode_idx) {
+    if (child_proc[mode_idx] < 0) {
+      return;
+    }
+    AbcResult& result = results[mode_idx];
+    received[mode_idx] = read(result_fds[mode_idx], &result, sizeof(result))
+                         == static_cast<ssize_t>(sizeof(result));
+    close(result_fds[mode_idx]);
+    int status = 0;
+    waitpid(child_proc[mode_idx], &status, 0);
+    if (!received[mode_idx] || !WIFEXITED(status)
+        || WEXITSTATUS(status) != 0) {
+      result.success = false;
+    }
+    live_children--;
+  };
+  std::vector<std::string> output_blifs(modes.size());
+  std::vector<std::vector<std::string>> mode_commands(modes.size());
+  std::cout.flush();
+  fflush(stdout);
   for (size_t curr_mode_idx = 0; curr_mode_idx < modes.size();
        curr_mode_idx++) {
-    output_blif_file_name_
+    output_blifs[curr_mode_idx]
         = work_dir_name_ + std::string(block_->getConstName())
           + std::to_string(curr_mode_idx) + "_crit_path_out.blif";
+    mode_commands[curr_mode_idx]
+        = abcCommands(modes[curr_mode_idx], output_blifs[curr_mode_idx]);
+
+    if (logger_->debugCheck(RMP, "remap", 1)) {
+      // Keep a script to reproduce the run by hand.
+      const std::string abc_script_file = work_dir_name_
+                                          + std::to_string(curr_mode_idx)
+                                          + "ord_abc_script.tcl";
+      debugPrint(logger_,
+                 RMP,
+                 "remap",
+                 1,
+                 "Writing ABC script file {}.",
+                 abc_script_file);
+      writeAbcScript(abc_script_file, mode_commands[curr_mode_idx]);
+    }
 
-    opt_mode_ = modes[curr_mode_idx];
-
-    const std::string abc_script_file
-        = work_dir_name_ + std::to_string(curr_mode_idx) + "ord_abc_script.tcl";
-    if (logfile_ == "")
-      logfile_ = work_dir_name_ + "abc.log";
+    while (live_children >= max_children) {
+      collect(next_collect++);
+    }
 
-    debugPrint(logger_,
-               RMP,
-               "remap",
-               1,
-               "Writing ABC script file {}.",
-               abc_script_file);
-
-    if (writeAbcScript(abc_script_file)) {
-      // call linked abc
-      Abc_Start();
-      Abc_Frame_t* abc_frame = Abc_FrameGetGlobalFrame();
-      const std::string command = "source " + abc_script_file;
-      child_proc[curr_mode_idx]
-          = Cmd_CommandExecute(abc_frame, command.c_str());
-      if (child_proc[curr_mode_idx]) {
-        logger_->error(RMP, 26, "Error executing ABC command {}.", command);
-        return;
+    int fds[2];
+    if (pipe(fds) != 0) {
+      logger_->warn(RMP, 38, "Unable to start ABC run {}.", curr_mode_idx);
+      continue;
+    }
+    const pid_t pid = fork();
+    if (pid == 0) {
+      // Worker: ABC reports go to this mode's log file.
+      close(fds[0]);
+      const std::string abc_log_name = logfile_ + std::to_string(curr_mode_idx);
+      if (freopen(abc_log_name.c_str(), "w", stdout) == nullptr) {
+        _exit(1);
       }
-      Abc_Stop();
-      // exit linked abc
-      files_to_remove.emplace_back(abc_script_file);
+      const AbcResult result = runAbcCommands(mode_commands[curr_mode_idx]);
+      fflush(stdout);
+      const bool sent = write(fds[1], &result, sizeof(result))
+                        == static_cast<ssize_t>(sizeof(result));
+      _exit(sent ? 0 : 1);
     }
+    close(fds[1]);
+    if (pid < 0) {
+      close(fds[0]);
+      logger_->warn(RMP, 38, "Unable to start ABC run {}.", curr_mode_idx);
+      continue;
+    }
+    child_proc[curr_mode_idx] = pid;
+    result_fds[curr_mode_idx] = fds[0];
+    live_children++;
   }  // end modes
+  while (next_collect < modes.size()) {
+    collect(next_collect++);
+  }
 
-  // Inspect ABC results to choose blif with least instance count
+  // Use the scores in mode order to choose the best blif
   for (int curr_mode_idx = 0; curr_mode_idx < modes.size(); curr_mode_idx++) {
-    // Skip failed ABC runs
-    if (child_proc[curr_mode_idx] != 0) {
+    if (child_proc[curr_mode_idx] < 0) {
       continue;
     }
-
-    output_blif_file_name_
-        = work_dir_name_ + std::string(block_->getConstName())
-          + std::to_string(curr_mode_idx) + "_crit_path_out.blif";
+    const AbcResult& result = results[curr_mode_idx];
     const std::string abc_log_name = logfile_ + std::to_string(curr_mode_idx);
-
-    int level_gain = 0;
-    float delay = std::numeric_limits<float>::max();
-    int num_instances = 0;
-    bool success = readAbcLog(abc_log_name, level_gain, delay);
-    if (success) {
-      success
-          = blif_.inspectBlif(output_blif_file_name_.c_str(), num_instances);
-      logger_->report(
-          "Optimized to {} instances in iteration {} with max path depth "
-          "decrease of {}, delay of {}.",
-          num_instances,
-          curr_mode_idx,
-          level_gain,
-          delay);
-
-      if (success) {
-        if (is_area_mode_) {
-          if (num_instances < best_inst_count) {
-            best_inst_count = num_instances;
-            best_blif = output_blif_file_name_;
-          }
-        } else {
-          // Using only DELAY_4 for delay based gain since other modes not
-          // showing good gains
-          if (modes[curr_mode_idx] == Mode::DELAY_4) {
-            best_delay_gain = delay;
-            best_blif = output_blif_file_name_;
-          }
-        }
+    // Skip failed ABC runs
+    if (!result.success) {
+      if (received[curr_mode_idx] && result.failed_command >= 0) {
+        logger_->warn(
+            RMP,
+            26,
+            "Error executing ABC command {}, see log file {} for details.",
+            mode_commands[curr_mode_idx][result.failed_command],
+            abc_log_name);
+      } else {
+        logger_->warn(RMP,
+                      25,
+                      "ABC run failed, see log file {} for details.",
+                      abc_log_name);
+      }
+      continue;
+    }
+    files_to_remove.emplace_back(output_blifs[curr_mode_idx]);
+
+    logger_->report(
+        "Optimized to {} instances in iteration {} with max path depth "
+        "decrease of {}, delay of {}.",
+        result.num_instances,
+        curr_mode_idx,
+        result.level_gain,
+        result.delay);
+
+    if (is_area_mode_) {
+      if (result.num_instances < best_inst_count) {
+        best_inst_count = result.num_instances;
+        best_blif = output_blifs[curr_mode_idx];
+      }
+    } else {
+      // Using only DELAY_4 for delay based gain since other modes not
+      // showing good gains
+      if (modes[curr_mode_idx] == Mode::DELAY_4) {
+        best_delay_gain = result.delay;
+        best_blif = output_blifs[curr_mode_idx];
       }
     }
-    files_to_remove.emplace_back(output_blif_file_name_);
   }
 
   if (best_inst_count < std::numeric_limits<int>::max()
@@ -479,42 +545,90 @@ void Restructure::removeConstCell(odb::dbInst* inst)
   odb::dbInst::destroy(inst);
 }
 
-bool Restructure::writeAbcScript(std::string file_name)
+std::vector<std::string> Restructure::abcCommands(
+    const Mode mode,
+    const std::string& output_blif) const
 {
-  std::ofstream script(file_name.c_str());
-
-  if (!script.is_open()) {
-    logger_->error(RMP, 20, "Cannot open file {} for writing.", file_name);
-    return false;
-  }
-
+  std::vector<std::string> commands;
   for (const auto& lib_name : lib_file_names_) {
     // abc read_lib prints verbose by default, -v toggles to off to avoid read
     // time being printed
-    std::string read_lib_str = "read_lib -v " + lib_name + "\n";
-    script << read_lib_str;
+    commands.push_back("read_lib -v " + lib_name);
+  }
+
+  commands.push_back("read_blif -n " + input_blif_file_name_);
+
+  if (logger_->debugCheck(RMP, "remap", 1)) {
+    commands.push_back("write_verilog " + input_blif_file_name_ + ".v");
   }
 
-  script << "read_blif -n " << input_blif_file_name_ << std::endl;
+  addOptCommands(mode, commands);
 
-  if (logger_->debugCheck(RMP, "remap", 1))
-    script << "write_verilog " << input_blif_file_name_ + std::string(".v")
-           << std::endl;
+  commands.push_back("write_blif " + output_blif);
 
-  writeOptCommands(script);
+  if (logger_->debugCheck(RMP, "remap", 1)) {
+    commands.push_back("write_verilog " + output_blif + ".v");
+  }
+
+  return commands;
+}
 
-  script << "write_blif " << output_blif_file_name_ << std::endl;
+bool Restructure::writeAbcScript(const std::string& file_name,
+                                 const std::vector<std::string>& commands)
+{
+  std::ofstream script(file_name.c_str());
+
+  if (!script.is_open()) {
+    logger_->error(RMP, 20, "Cannot open file {} for writing.", file_name);
+    return false;
+  }
 
-  if (logger_->debugCheck(RMP, "remap", 1))
-    script << "write_verilog " << output_blif_file_name_ + std::string(".v")
-           << std::endl;
+  for (const std::string& command : commands) {
+    script << command << std::endl;
+  }
 
   script.close();
 
   return true;
 }
 
-void Restructure::writeOptCommands(std::ofstream& script)
+// Run commands in the ABC frame of this process and score the resulting
+// network.  Called in a forked worker so nothing here may use the logger.
+Restructure::AbcResult Restructure::runAbcCommands(
+    const std::vector<std::string>& commands)
+{
+  AbcResult result;
+  Abc_Start();
+  Abc_Frame_t* abc_frame = Abc_FrameGetGlobalFrame();
+  int start_level = -1;
+  for (int i = 0; i < commands.size(); i++) {
+    if (Cmd_CommandExecute(abc_frame, commands[i].c_str()) != 0) {
+      result.failed_command = i;
+      return result;
+    }
+    Abc_Ntk_t* ntk = Abc_FrameReadNtk(abc_frame);
+    if (start_level < 0 && ntk != nullptr) {
+      // The network as read from the blif
+      start_level = Abc_NtkLevel(ntk);
+    }
+  }
+
+  Abc_Ntk_t* ntk = Abc_FrameReadNtk(abc_frame);
+  if (ntk == nullptr) {
+    return result;
+  }
+  result.num_instances = Abc_NtkNodeNum(ntk);
+  result.level_gain = start_level - Abc_NtkLevel(ntk);
+  if (Abc_NtkHasMapping(ntk)) {
+    result.delay = Abc_NtkDelayTrace(ntk, nullptr, nullptr, 0);
+  }
+  result.success = true;
+  Abc_Stop();
+  return result;
+}
+
+void Restructure::addOptCommands(const Mode mode,
+                                 std::vector<std::string>& commands) const
 {
   std::string choice
       = "alias choice \"fraig_store; resyn2; fraig_store; resyn2; fraig_store; "
@@ -523,61 +637,63 @@ void Restructure::writeOptCommands(std::ofstream& script)
       = "alias choice2 \"fraig_store; balance; fraig_store; resyn2; "
         "fraig_store; resyn2; fraig_store; resyn2; fraig_store; "
         "fraig_restore\"";
-  script << "bdd; sop" << std::endl;
+  commands.emplace_back("bdd; sop");
 
-  script << "alias resyn2 \"balance; rewrite; refactor; balance; rewrite; "
-            "rewrite -z; balance; refactor -z; rewrite -z; balance\""
-         << std::endl;
-  script << choice << std::endl;
-  script << choice2 << std::endl;
+  commands.emplace_back(
+      "alias resyn2 \"balance; rewrite; refactor; balance; rewrite; "
+      "rewrite -z; balance; refactor -z; rewrite -z; balance\"");
+  commands.push_back(choice);
+  commands.push_back(choice2);
 
-  if (opt_mode_ == Mode::AREA_3)
-    script << "choice2" << std::endl;  // << "scleanup" << std::endl;
+  if (mode == Mode::AREA_3)
+    commands.emplace_back("choice2");  // "scleanup"
   else
-    script << "resyn2" << std::endl;  // << "scleanup" << std::endl;
+    commands.emplace_back("resyn2");  // "scleanup"
 
-  switch (opt_mode_) {
+  switch (mode) {
     case Mode::DELAY_1: {
-      script << "map -D 0.01 -A 0.9 -B 0.2 -M 0 -p" << std::endl;
-      script << "buffer -p -c" << std::endl;
+      commands.emplace_back("map -D 0.01 -A 0.9 -B 0.2 -M 0 -p");
+      commands.emplace_back("buffer -p -c");
       break;
     }
     case Mode::DELAY_2: {
-      script << "choice" << std::endl;
-      script << "map -D 0.01 -A 0.9 -B 0.2 -M 0 -p" << std::endl;
-      script << "choice" << std::endl;
-      script << "map -D 0.01" << std::endl;
-      script << "buffer -p -c" << std::endl << "topo" << std::endl;
+      commands.emplace_back("choice");
+      commands.emplace_back("map -D 0.01 -A 0.9 -B 0.2 -M 0 -p");
+      commands.emplace_back("choice");
+      commands.emplace_back("map -D 0.01");
+      commands.emplace_back("buffer -p -c");
+      commands.emplace_back("topo");
       break;
     }
     case Mode::DELAY_3: {
-      script << "choice2" << std::endl;
-      script << "map -D 0.01 -A 0.9 -B 0.2 -M 0 -p" << std::endl;
-      script << "choice2" << std::endl;
-      script << "map -D 0.01" << std::endl;
-      script << "buffer -p -c" << std::endl << "topo" << std::endl;
+      commands.emplace_back("choice2");
+      commands.emplace_back("map -D 0.01 -A 0.9 -B 0.2 -M 0 -p");
+      commands.emplace_back("choice2");
+      commands.emplace_back("map -D 0.01");
+      commands.emplace_back("buffer -p -c");
+      commands.emplace_back("topo");
       break;
     }
     case Mode::DELAY_4: {
-      script << "choice2" << std::endl;
-      script << "amap -F 20 -A 20 -C 5000 -Q 0.1 -m" << std::endl;
-      script << "choice2" << std::endl;
-      script << "map -D 0.01 -A 0.9 -B 0.2 -M 0 -p" << std::endl;
-      script << "buffer -p -c" << std::endl;
+      commands.emplace_back("choice2");
+      commands.emplace_back("amap -F 20 -A 20 -C 5000 -Q 0.1 -m");
+      commands.emplace_back("choice2");
+      commands.emplace_back("map -D 0.01 -A 0.9 -B 0.2 -M 0 -p");
+      commands.emplace_back("buffer -p -c");
       break;
     }
     case Mode::AREA_2:
     case Mode::AREA_3: {
-      script << "choice2" << std::endl;
-      script << "amap -m -Q 0.1 -F 20 -A 20 -C 5000" << std::endl;
-      script << "choice2" << std::endl;
-      script << "amap -m -Q 0.1 -F 20 -A 20 -C 5000" << std::endl;
+      commands.emplace_back("choice2");
+      commands.emplace_back("amap -m -Q 0.1 -F 20 -A 20 -C 5000");
+      commands.emplace_back("choice2");
+      commands.emplace_back("amap -m -Q 0.1 -F 20 -A 20 -C 5000");
       break;
     }
     case Mode::AREA_1:
     default: {
-      script << "choice2" << std::endl;
-      script << "amap -m -Q 0.1 -F 20 -A 20 -C 5000" << std::endl;
+      commands.emplace_back("choice2");
+      commands.emplace_back("amap -m -Q 0.1 -F 20 -A 20 -C 5000");
       break;
     }
   }
@@ -613,67 +729,4 @@ void Restructure::setTieLoPort(sta::LibertyPort* tieLoPort)
   }
 }
 
-bool Restructure::readAbcLog(std::string abc_file_name,
-                             int& level_gain,
-                             float& final_delay)
-{
-  std::ifstream abc_file(abc_file_name);
-  if (abc_file.bad()) {
-    logger_->error(RMP, 16, "cannot open file {}", abc_file_name);
-    return false;
-  }
-  logger_->report("Reading ABC log {}.", abc_file_name);
-  std::string buf;
-  const char delimiter = ' ';
-  bool status = true;
-  std::vector<double> level;
-  std::vector<float> delay;
-
-  // read the file line by line
-  while (std::getline(abc_file, buf)) {
-    // convert the line in to stream:
-    std::istringstream ss(buf);
-    std::vector<std::string> tokens;
-
-    // read the line, word by word
-    while (std::getline(ss, buf, delimiter))
-      tokens.push_back(buf);
-
-    if (!tokens.empty() && tokens[0] == "Error:") {
-      status = false;
-      logger_->warn(RMP,
-                    25,
-                    "ABC run failed, see log file {} for details.",
-                    abc_file_name);
-      break;
-    }
-    if (tokens.size() > 7 && tokens[tokens.size() - 3] == "lev"
-        && tokens[tokens.size() - 2] == "=") {
-      level.emplace_back(std::stoi(tokens[tokens.size() - 1]));
-    }
-    if (tokens.size() > 7) {
-      std::string prev_token = "";
-      for (std::string token : tokens) {
-        if (prev_token == "delay" && token.at(0) == '=') {
-          std::string delay_str = token;
-          if (delay_str.size() > 1) {
-            delay_str.erase(
-                delay_str.begin());  // remove first char which is '='
-            delay.emplace_back(std::stof(delay_str));
-          }
-          break;
-        }
-        prev_token = std::move(token);
-      }
-    }
-  }
-
-  if (level.size() > 1) {
-    level_gain = level[0] - level[level.size() - 1];
-  }
-  if (delay.size() > 0) {
-    final_delay = delay[delay.size() - 1];  // last value in file
-  }
-  return status;
-}
 }  // namespace rmp
@@ -66,6 +66,7 @@
 #include "sta/TimingModel.hh"
 #include "sta/Units.hh"
 #include "utl/Logger.h"
+#include "utl/Profiler.h"
 
 // http://vlsicad.eecs.umich.edu/BK/Slots/cache/dropzone.tamu.edu/~zhuoli/GSRC/fast_buffer_insertion.html
 
@@ -2528,6 +2529,7 @@ void Resizer::repairDesign(double max_wire_length,
                            double cap_margin,
                            bool verbose)
 {
+  utl::ProfileScope profile_scope("rsz::repair_design");
   resizePreamble();
   if (parasitics_src_ == ParasiticsSrc::global_routing) {
     opendp_->initMacrosAndGrid();
@@ -2675,6 +2677,7 @@ void Resizer::repairSetup(double setup_margin,
                           bool skip_gate_cloning,
                           bool skip_buffer_removal)
 {
+  utl::ProfileScope profile_scope("rsz::repair_setup");
   resizePreamble();
   if (parasitics_src_ == ParasiticsSrc::global_routing) {
     opendp_->initMacrosAndGrid();
@@ -2717,6 +2720,7 @@ void Resizer::repairHold(
     int max_passes,
     bool verbose)
 {
+  utl::ProfileScope profile_scope("rsz::repair_hold");
   resizePreamble();
   if (parasitics_src_ == ParasiticsSrc::global_routing) {
     opendp_->initMacrosAndGrid();
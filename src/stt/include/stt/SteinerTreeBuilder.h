@@ -75,6 +75,30 @@ struct Tree
   int branchCount() const { return branch.size(); }
 };
 
+// The pins of many nets in structure of arrays form for building their
+// trees in one batch.  The pins of net i are x/y[net_start[i],
+// net_start[i + 1]) and drvr_index[i] is relative to net_start[i].
+// alpha is empty or holds one value per net, where a negative alpha means
+// SteinerTreeBuilder::getAlpha().
+struct NetPins
+{
+  std::vector<int> x;
+  std::vector<int> y;
+  std::vector<int> net_start{0};
+  std::vector<int> drvr_index;
+  std::vector<float> alpha;
+
+  void addNet(const std::vector<int>& xs,
+              const std::vector<int>& ys,
+              int drvr);
+  void addNet(const std::vector<int>& xs,
+              const std::vector<int>& ys,
+              int drvr,
+              float net_alpha);
+  int netCount() const { return net_start.size() - 1; }
+  void clear();
+};
+
 class SteinerTreeBuilder
 {
  public:
@@ -94,6 +118,10 @@ class SteinerTreeBuilder
                        const std::vector<int>& x,
                        const std::vector<int>& y,
                        int drvr_index);
+  // Build the trees of all nets in parallel on the shared thread pool.
+  // Nets with a negative or no alpha use getAlpha().  Tree i is the same as
+  // makeSteinerTree on net i alone whatever the thread count.
+  std::vector<Tree> makeSteinerTrees(const NetPins& nets);
   // API only for FastRoute, that requires the use of flutes in its
   // internal flute implementation
   Tree makeSteinerTree(const std::vector<int>& x,
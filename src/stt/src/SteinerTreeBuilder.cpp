@@ -41,6 +41,7 @@
 #include "odb/db.h"
 #include "stt/flute.h"
 #include "stt/pd.h"
+#include "utl/ThreadPool.h"
 
 namespace stt {
 
@@ -109,6 +110,34 @@ Tree SteinerTreeBuilder::makeSteinerTree(const std::vector<int>& x,
   return flt::flute(x, y, flute_accuracy);
 }
 
+std::vector<Tree> SteinerTreeBuilder::makeSteinerTrees(const NetPins& nets)
+{
+  const int net_count = nets.netCount();
+  if (nets.drvr_index.size() != net_count
+      || (!nets.alpha.empty() && nets.alpha.size() != net_count)
+      || nets.x.size() != nets.net_start.back()
+      || nets.y.size() != nets.x.size()) {
+    logger_->error(utl::STT, 8, "Inconsistent net pin arrays.");
+  }
+
+  std::vector<Tree> trees(net_count);
+  utl::ThreadPool::global().parallelFor(0, net_count, [&](const int net) {
+    // Per thread scratch for the pins of one net
+    thread_local std::vector<int> x;
+    thread_local std::vector<int> y;
+    const auto begin = nets.net_start[net];
+    const auto end = nets.net_start[net + 1];
+    x.assign(nets.x.begin() + begin, nets.x.begin() + end);
+    y.assign(nets.y.begin() + begin, nets.y.begin() + end);
+    float alpha = nets.alpha.empty() ? -1 : nets.alpha[net];
+    if (alpha < 0) {
+      alpha = alpha_;
+    }
+    trees[net] = makeSteinerTree(x, y, nets.drvr_index[net], alpha);
+  });
+  return trees;
+}
+
 Tree SteinerTreeBuilder::makeSteinerTree(const std::vector<int>& x,
                                          const std::vector<int>& y,
                                          const std::vector<int>& s,
@@ -373,6 +402,34 @@ static int findPathDepth(int node, int from, PDedges& edges, int length)
   return max_length;
 }
 
+void NetPins::addNet(const std::vector<int>& xs,
+                     const std::vector<int>& ys,
+                     const int drvr)
+{
+  addNet(xs, ys, drvr, -1);
+}
+
+void NetPins::addNet(const std::vector<int>& xs,
+                     const std::vector<int>& ys,
+                     const int drvr,
+                     const float net_alpha)
+{
+  x.insert(x.end(), xs.begin(), xs.end());
+  y.insert(y.end(), ys.begin(), ys.end());
+  net_start.push_back(x.size());
+  drvr_index.push_back(drvr);
+  alpha.push_back(net_alpha);
+}
+
+void NetPins::clear()
+{
+  x.clear();
+  y.clear();
+  net_start.assign(1, 0);
+  drvr_index.clear();
+  alpha.clear();
+}
+
 void Tree::printTree(utl::Logger* logger) const
 {
   if (deg > 1) {
@@ -33,12 +33,16 @@
 #include "stt/flute.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cctype>
 #include <climits>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include <string>
 
 // Use flute LUT file reader.
@@ -59,13 +63,10 @@ namespace stt {
 namespace flt {
 
 #if FLUTE_D <= 7
-#define MGROUP 5040 / 4  // Max. # of groups, 7! = 5040
 #define MPOWV 15         // Max. # of POWVs per group
 #elif FLUTE_D == 8
-#define MGROUP 40320 / 4  // Max. # of groups, 8! = 40320
 #define MPOWV 33          // Max. # of POWVs per group
 #elif FLUTE_D == 9
-#define MGROUP 362880 / 4  // Max. # of groups, 9! = 362880
 #define MPOWV 79           // Max. # of POWVs per group
 #endif
 int numgrp[10] = {0, 0, 0, 0, 6, 30, 180, 1260, 10080, 90720};
@@ -78,15 +79,22 @@ struct csoln
   unsigned char neighbor[2 * FLUTE_D - 2];
 };
 
-// struct csoln *LUT[FLUTE_D + 1][MGROUP];  // storing 4 .. FLUTE_D
-// int numsoln[FLUTE_D + 1][MGROUP];
+// The solutions of all groups of one degree stored contiguously.  Group k
+// has count[k] solutions starting at solns[first[k]].  Groups that repeat
+// an earlier group share its solutions.
+struct DegreeLUT
+{
+  std::vector<csoln> solns;
+  std::vector<int> first;
+  std::vector<int> count;
+
+  const csoln* solutions(int k) const { return &solns[first[k]]; }
+};
 
-using LUT_TYPE = struct csoln***;
-using NUMSOLN_TYPE = int**;
+using LUT_TYPE = std::array<DegreeLUT, FLUTE_D + 1>;
 
-// Dynamically allocate LUTs.
-LUT_TYPE LUT = nullptr;
-NUMSOLN_TYPE numsoln;
+// LUT[d] is built the first time a net of degree d is seen (see ensureLUT).
+static LUT_TYPE LUT;
 
 struct point
 {
@@ -111,11 +119,10 @@ inline T ADIFF(T x, T y)
 ////////////////////////////////////////////////////////////////
 
 #if LUT_SOURCE == LUT_FILE || LUT_SOURCE == LUT_VAR_CHECK
-static void readLUTfiles(LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
+static void readLUTfiles(LUT_TYPE& LUT)
 {
   unsigned char charnum[256], line[32], *linep, c;
   FILE *fpwv, *fprt;
-  struct csoln* p;
   int d, i, j, k, kk, ns, nn;
 
   for (i = 0; i <= 255; i++) {
@@ -148,20 +155,23 @@ static void readLUTfiles(LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
     fscanf(fprt, "d=%d", &d);
     fgetc(fprt);  // '/n'
 #endif
+    DegreeLUT& lut = LUT[d];
+    lut.first.resize(numgrp[d]);
+    lut.count.resize(numgrp[d]);
     for (k = 0; k < numgrp[d]; k++) {
       ns = (int) charnum[fgetc(fpwv)];
 
       if (ns == 0) {  // same as some previous group
         fscanf(fpwv, "%d", &kk);
         fgetc(fpwv);  // '/n'
-        numsoln[d][k] = numsoln[d][kk];
-        LUT[d][k] = LUT[d][kk];
+        lut.count[k] = lut.count[kk];
+        lut.first[k] = lut.first[kk];
       } else {
         fgetc(fpwv);  // '\n'
-        numsoln[d][k] = ns;
-        p = (struct csoln*) malloc(ns * sizeof(struct csoln));
-        LUT[d][k] = p;
+        lut.count[k] = ns;
+        lut.first[k] = lut.solns.size();
         for (i = 1; i <= ns; i++) {
+          struct csoln* p = &lut.solns.emplace_back();
           linep = (unsigned char*) fgets((char*) line, 32, fpwv);
           p->parent = charnum[*(linep++)];
           j = 0;
@@ -186,7 +196,6 @@ static void readLUTfiles(LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
             p->neighbor[j++] = c % 16;
           }
 #endif
-          p++;
         }
       }
     }
@@ -200,73 +209,130 @@ static void readLUTfiles(LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
 
 ////////////////////////////////////////////////////////////////
 
-static void readLUT();
-static void makeLUT(LUT_TYPE& LUT, NUMSOLN_TYPE& numsoln);
-static void deleteLUT(LUT_TYPE& LUT, NUMSOLN_TYPE& numsoln);
-static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln);
-static void ensureLUT(int d);
-static std::string base64_decode(std::string const& encoded_string);
-#if LUT_SOURCE == LUT_VAR_CHECK
-static void checkLUT(LUT_TYPE LUT1,
-                     NUMSOLN_TYPE numsoln1,
-                     LUT_TYPE LUT2,
-                     NUMSOLN_TYPE numsoln2);
-#endif
+/*
+   base64.cpp and base64.h
 
-// LUTs are initialized to this order at startup.
-static constexpr int lut_initial_d = 8;
-static int lut_valid_d = 0;
+   Copyright (C) 2004-2008 René Nyffenegger
 
-extern std::string post9;
-extern std::string powv9;
+   This source code is provided 'as-is', without any express or implied
+   warranty. In no event will the author be held liable for any damages
+   arising from the use of this software.
+
+   Permission is granted to anyone to use this software for any purpose,
+   including commercial applications, and to alter it and redistribute it
+   freely, subject to the following restrictions:
 
-static void readLUT()
+   1. The origin of this source code must not be misrepresented; you must not
+   claim that you wrote the original source code. If you use this source code
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+
+   2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original source code.
+
+   3. This notice may not be removed or altered from any source distribution.
+
+   René Nyffenegger rene.nyffenegger@adp-gmbh.ch
+
+*/
+
+// Reads the bytes of a base64 encoded string one at a time so the LUT
+// text can be parsed in place without decoding all of it up front.
+// Decoded offset pos lives in the 4 character group pos / 3 so parsing can
+// start at any offset.
+class Base64Reader
 {
-  makeLUT(LUT, numsoln);
+ public:
+  Base64Reader(const std::string& encoded, size_t pos)
+      : encoded_(encoded), pos_(pos)
+  {
+  }
 
-#if LUT_SOURCE == LUT_FILE
-  readLUTfiles(LUT, numsoln);
-  lut_valid_d = FLUTE_D;
+  size_t pos() const { return pos_; }
+  unsigned char peek(int ahead = 0) { return byteAt(pos_ + ahead); }
+  unsigned char get() { return byteAt(pos_++); }
+  void skip(int count) { pos_ += count; }
+  int getInt();
 
-#elif LUT_SOURCE == LUT_VAR
-  // Only init to d=8 on startup because d=9 is big and slow.
-  initLUT(lut_initial_d, LUT, numsoln);
+ private:
+  unsigned char byteAt(size_t pos);
 
-#elif LUT_SOURCE == LUT_VAR_CHECK
-  readLUTfiles(LUT, numsoln);
-  // Temporaries to compare to file results.
-  LUT_TYPE LUT_;
-  NUMSOLN_TYPE numsoln_;
-  makeLUT(LUT_, numsoln_);
-  initLUT(FLUTE_D, LUT_, numsoln_);
-  checkLUT(LUT, numsoln, LUT_, numsoln_);
-#endif
-}
+  const std::string& encoded_;
+  size_t pos_;
+  size_t group_ = std::string::npos;
+  unsigned char bytes_[3] = {0, 0, 0};
+};
 
-static void makeLUT(LUT_TYPE& LUT, NUMSOLN_TYPE& numsoln)
+static constexpr std::array<unsigned char, 256> base64_values = [] {
+  std::array<unsigned char, 256> values{};
+  for (int i = 0; i < 26; i++) {
+    values['A' + i] = i;
+    values['a' + i] = 26 + i;
+  }
+  for (int i = 0; i < 10; i++) {
+    values['0' + i] = 52 + i;
+  }
+  values['+'] = 62;
+  values['/'] = 63;
+  return values;
+}();
+
+unsigned char Base64Reader::byteAt(const size_t pos)
 {
-  LUT = new struct csoln**[FLUTE_D + 1];
-  numsoln = new int*[FLUTE_D + 1];
-  for (int d = 4; d <= FLUTE_D; d++) {
-    LUT[d] = new struct csoln*[MGROUP];
-    numsoln[d] = new int[MGROUP];
+  const size_t group = pos / 3;
+  if (group != group_) {
+    unsigned char chars[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++) {
+      const size_t idx = 4 * group + i;
+      if (idx < encoded_.size() && encoded_[idx] != '=') {
+        chars[i] = base64_values[static_cast<unsigned char>(encoded_[idx])];
+      }
+    }
+    bytes_[0] = (chars[0] << 2) + ((chars[1] & 0x30) >> 4);
+    bytes_[1] = ((chars[1] & 0xf) << 4) + ((chars[2] & 0x3c) >> 2);
+    bytes_[2] = ((chars[2] & 0x3) << 6) + chars[3];
+    group_ = group;
   }
+  return bytes_[pos % 3];
 }
 
-void deleteLUT()
+int Base64Reader::getInt()
 {
-  deleteLUT(LUT, numsoln);
+  int value = 0;
+  const bool negative = (peek() == '-');
+  if (negative || peek() == '+') {
+    skip(1);
+  }
+  while (peek() >= '0' && peek() <= '9') {
+    value = 10 * value + (get() - '0');
+  }
+  return negative ? -value : value;
 }
 
-static void deleteLUT(LUT_TYPE& LUT, NUMSOLN_TYPE& numsoln)
+////////////////////////////////////////////////////////////////
+
+static void ensureLUT(int d);
+#if LUT_SOURCE == LUT_VAR || LUT_SOURCE == LUT_VAR_CHECK
+static void initLUT(int d, DegreeLUT& lut);
+#endif
+#if LUT_SOURCE == LUT_VAR_CHECK
+static void checkLUT(const LUT_TYPE& LUT1, const LUT_TYPE& LUT2);
+#endif
+
+// Readers check lut_ready without locking; lut_mutex serializes building
+// the tables so flute can be called from many threads.
+static std::array<std::atomic<bool>, FLUTE_D + 1> lut_ready;
+static std::mutex lut_mutex;
+
+extern std::string post9;
+extern std::string powv9;
+
+void deleteLUT()
 {
-  if (LUT) {
-    for (int d = 4; d <= FLUTE_D; d++) {
-      delete[] LUT[d];
-      delete[] numsoln[d];
-    }
-    delete[] numsoln;
-    delete[] LUT;
+  std::lock_guard<std::mutex> lock(lut_mutex);
+  for (int d = 4; d <= FLUTE_D; d++) {
+    lut_ready[d] = false;
+    LUT[d] = DegreeLUT();
   }
 }
 
@@ -281,125 +347,157 @@ static unsigned char charNum(unsigned char c)
   return 0;
 }
 
-inline const char* readDecimalInt(const char* s, int& value)
+#if LUT_SOURCE == LUT_VAR || LUT_SOURCE == LUT_VAR_CHECK
+// Parse the section of degree d from the encoded POWV/POST text.  Without
+// a lut the section is only stepped over.
+static void parseLUTDegree(int d,
+                           Base64Reader& pwv,
+                           Base64Reader& prt,
+                           DegreeLUT* lut)
 {
-  value = 0;
-  bool negative = (*s == '-');
-  if (negative || *s == '+') {
-    ++s;
-  }
-  constexpr int zero_code = int('0');
-  while (*s >= '0' && *s <= '9') {
-    value = 10 * value + (int(*s) - zero_code);
-    ++s;
+  if (pwv.peek(0) == 'd' && pwv.peek(1) == '=') {
+    pwv.skip(2);
+    d = pwv.getInt();
   }
-  if (negative) {
-    value = -value;
-  }
-  return s;
-}
-
-// Init LUTs from base64 encoded string variables.
-static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
-{
-  std::string pwv_string = base64_decode(powv9);
-  const char* pwv = pwv_string.c_str();
-
-#if FLUTE_ROUTING == 1
-  std::string prt_string = base64_decode(post9);
-  const char* prt = prt_string.c_str();
-#endif
-
-  for (int d = 4; d <= to_d; d++) {
-    if (pwv[0] == 'd' && pwv[1] == '=') {
-      pwv = readDecimalInt(pwv + 2, d);
-    }
-    ++pwv;
+  pwv.skip(1);
 #if FLUTE_ROUTING == 1
-    if (prt[0] == 'd' && prt[1] == '=') {
-      prt = readDecimalInt(prt + 2, d);
-    }
-    ++prt;
+  if (prt.peek(0) == 'd' && prt.peek(1) == '=') {
+    prt.skip(2);
+    d = prt.getInt();
+  }
+  prt.skip(1);
 #endif
-    for (int k = 0; k < numgrp[d]; k++) {
-      int ns = charNum(*pwv++);
-      if (ns == 0) {  // same as some previous group
-        int kk;
-        pwv = readDecimalInt(pwv, kk) + 1;
-        numsoln[d][k] = numsoln[d][kk];
-        LUT[d][k] = LUT[d][kk];
+  if (lut) {
+    lut->first.resize(numgrp[d]);
+    lut->count.resize(numgrp[d]);
+  }
+  struct csoln skipped;
+  for (int k = 0; k < numgrp[d]; k++) {
+    int ns = charNum(pwv.get());
+    if (ns == 0) {  // same as some previous group
+      const int kk = pwv.getInt();
+      pwv.skip(1);  // '\n'
+      if (lut) {
+        lut->count[k] = lut->count[kk];
+        lut->first[k] = lut->first[kk];
+      }
+      continue;
+    }
+    pwv.skip(1);  // '\n'
+    if (lut) {
+      lut->count[k] = ns;
+      lut->first[k] = lut->solns.size();
+    }
+    for (int i = 1; i <= ns; i++) {
+      struct csoln* p = lut ? &lut->solns.emplace_back() : &skipped;
+      p->parent = charNum(pwv.get());
+
+      int j = 0;
+      unsigned char ch, seg;
+      do {
+        ch = pwv.get();
+        seg = charNum(ch);
+        p->seg[j++] = seg;
+      } while (seg != 0);
+
+      j = 10;
+      if (ch == '\n') {
+        p->seg[j] = 0;
       } else {
-        pwv++;  // '\n'
-        numsoln[d][k] = ns;
-        struct csoln* p = new struct csoln[ns];
-        LUT[d][k] = p;
-        for (int i = 1; i <= ns; i++) {
-          p->parent = charNum(*pwv++);
-
-          int j = 0;
-          unsigned char ch, seg;
-          do {
-            ch = *pwv++;
-            seg = charNum(ch);
-            p->seg[j++] = seg;
-          } while (seg != 0);
-
-          j = 10;
-          if (ch == '\n') {
-            p->seg[j] = 0;
-          } else {
-            do {
-              ch = *pwv++;
-              seg = charNum(ch);
-              p->seg[j--] = seg;
-            } while (seg != 0);
-          }
+        do {
+          ch = pwv.get();
+          seg = charNum(ch);
+          p->seg[j--] = seg;
+        } while (seg != 0);
+      }
 
 #if FLUTE_ROUTING == 1
-          int nn = 2 * d - 2;
-          for (int j = d; j < nn; j++) {
-            p->rowcol[j - d] = charNum(*prt++);
-          }
+      int nn = 2 * d - 2;
+      for (int j = d; j < nn; j++) {
+        p->rowcol[j - d] = charNum(prt.get());
+      }
 
-          for (int j = 0; j < nn;) {
-            unsigned char c = *prt++;
-            p->neighbor[j++] = c / 16;
-            p->neighbor[j++] = c % 16;
-          }
-          prt++;  // \n
-#endif
-          p++;
-        }
+      for (int j = 0; j < nn;) {
+        unsigned char c = prt.get();
+        p->neighbor[j++] = c / 16;
+        p->neighbor[j++] = c % 16;
       }
+      prt.skip(1);  // \n
+#endif
+    }
+  }
+}
+
+// Decoded offsets of the section of each degree in powv9/post9.  They are
+// known up to lut_known_d and extended as sections are stepped over.
+static std::array<size_t, FLUTE_D + 1> powv_start;
+static std::array<size_t, FLUTE_D + 1> post_start;
+static int lut_known_d = 4;
+
+// Init the LUT of degree d from the base64 encoded string variables.
+// Only the sections before d that haven't been seen yet are parsed (and
+// dropped) on the way, so the other degrees cost no memory until used.
+static void initLUT(const int d, DegreeLUT& lut)
+{
+  const int from_d = std::min(d, lut_known_d);
+  Base64Reader pwv(powv9, powv_start[from_d]);
+  Base64Reader prt(post9, post_start[from_d]);
+  for (int dd = from_d; dd <= d; dd++) {
+    parseLUTDegree(dd, pwv, prt, dd == d ? &lut : nullptr);
+    if (dd + 1 <= FLUTE_D && dd + 1 > lut_known_d) {
+      powv_start[dd + 1] = pwv.pos();
+      post_start[dd + 1] = prt.pos();
+      lut_known_d = dd + 1;
     }
   }
-  lut_valid_d = to_d;
 }
+#endif
 
 static void ensureLUT(int d)
 {
-  if (LUT == nullptr) {
-    readLUT();
+  if (d < 4 || d > FLUTE_D || lut_ready[d]) {
+    return;
   }
-  if (d > lut_valid_d && d <= FLUTE_D) {
-    initLUT(FLUTE_D, LUT, numsoln);
+  std::lock_guard<std::mutex> lock(lut_mutex);
+  if (lut_ready[d]) {
+    return;
   }
+
+#if LUT_SOURCE == LUT_FILE
+  readLUTfiles(LUT);
+  for (int dd = 4; dd <= FLUTE_D; dd++) {
+    lut_ready[dd] = true;
+  }
+
+#elif LUT_SOURCE == LUT_VAR
+  initLUT(d, LUT[d]);
+  lut_ready[d] = true;
+
+#elif LUT_SOURCE == LUT_VAR_CHECK
+  readLUTfiles(LUT);
+  // Temporaries to compare to file results.
+  auto LUT_ = std::make_unique<LUT_TYPE>();
+  for (int dd = 4; dd <= FLUTE_D; dd++) {
+    initLUT(dd, (*LUT_)[dd]);
+  }
+  checkLUT(LUT, *LUT_);
+  for (int dd = 4; dd <= FLUTE_D; dd++) {
+    lut_ready[dd] = true;
+  }
+#endif
 }
 
 #if LUT_SOURCE == LUT_VAR_CHECK
-static void checkLUT(LUT_TYPE LUT1,
-                     NUMSOLN_TYPE numsoln1,
-                     LUT_TYPE LUT2,
-                     NUMSOLN_TYPE numsoln2)
+static void checkLUT(const LUT_TYPE& LUT1, const LUT_TYPE& LUT2)
 {
   for (int d = 4; d <= FLUTE_D; d++) {
     for (int k = 0; k < numgrp[d]; k++) {
-      int ns1 = numsoln1[d][k];
-      int ns2 = numsoln2[d][k];
+      int ns1 = LUT1[d].count[k];
+      int ns2 = LUT2[d].count[k];
       if (ns1 != ns2)
         printf("numsoln[%d][%d] mismatch\n", d, k);
-      struct csoln* soln1 = LUT1[d][k];
-      struct csoln* soln2 = LUT2[d][k];
+      const struct csoln* soln1 = LUT1[d].solutions(k);
+      const struct csoln* soln2 = LUT2[d].solutions(k);
       if (soln1->parent != soln2->parent)
         printf("LUT[%d][%d]->parent mismatch\n", d, k);
       for (int j = 0; soln1->seg[j] != 0; j++) {
@@ -424,96 +522,6 @@ static void checkLUT(LUT_TYPE LUT1,
 }
 #endif
 
-/*
-   base64.cpp and base64.h
-
-   Copyright (C) 2004-2008 René Nyffenegger
-
-   This source code is provided 'as-is', without any express or implied
-   warranty. In no event will the author be held liable for any damages
-   arising from the use of this software.
-
-   Permission is granted to anyone to use this software for any purpose,
-   including commercial applications, and to alter it and redistribute it
-   freely, subject to the following restrictions:
-
-   1. The origin of this source code must not be misrepresented; you must not
-   claim that you wrote the original source code. If you use this source code
-   in a product, an acknowledgment in the product documentation would be
-   appreciated but is not required.
-
-   2. Altered source versions must be plainly marked as such, and must not be
-   misrepresented as being the original source code.
-
-   3. This notice may not be removed or altered from any source distribution.
-
-   René Nyffenegger rene.nyffenegger@adp-gmbh.ch
-
-*/
-
-static const std::string base64_chars
-    = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-      "abcdefghijklmnopqrstuvwxyz"
-      "0123456789+/";
-
-static inline bool is_base64(unsigned char c)
-{
-  return (isalnum(c) || (c == '+') || (c == '/'));
-}
-
-static std::string base64_decode(std::string const& encoded_string)
-{
-  int in_len = encoded_string.size();
-  int i = 0;
-  int j = 0;
-  int in_ = 0;
-  char char_array_4[4], char_array_3[3];
-  std::string ret;
-
-  while (in_len-- && (encoded_string[in_] != '=')
-         && is_base64(encoded_string[in_])) {
-    char_array_4[i++] = encoded_string[in_];
-    in_++;
-    if (i == 4) {
-      for (i = 0; i < 4; i++) {
-        char_array_4[i] = base64_chars.find(char_array_4[i]);
-      }
-
-      char_array_3[0]
-          = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-      char_array_3[1]
-          = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-      char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
-
-      for (i = 0; (i < 3); i++) {
-        ret += char_array_3[i];
-      }
-      i = 0;
-    }
-  }
-
-  if (i) {
-    for (j = i; j < 4; j++) {
-      char_array_4[j] = 0;
-    }
-
-    for (j = 0; j < 4; j++) {
-      char_array_4[j] = base64_chars.find(char_array_4[j]);
-    }
-
-    char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-    char_array_3[1]
-        = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-    char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
-
-    for (j = 0; (j < i - 1); j++) {
-      ret += char_array_3[j];
-    }
-  }
-
-  return ret;
-}
-
 ////////////////////////////////////////////////////////////////
 
 int flute_wl(int d,
@@ -672,7 +680,7 @@ int flutes_wl_LD(int d,
                  const std::vector<int>& s)
 {
   int k, pi, i, j;
-  struct csoln* rlist;
+  const struct csoln* rlist;
   int dd[2 * FLUTE_D - 2];  // 0..FLUTE_D-2 for v, FLUTE_D-1..2*D-3 for h
   int minl, sum, l[MPOWV + 1];
 
@@ -713,14 +721,14 @@ int flutes_wl_LD(int d,
     }
 
     minl = l[0] = xs[d - 1] - xs[0] + ys[d - 1] - ys[0];
-    rlist = LUT[d][k];
+    rlist = LUT[d].solutions(k);
     for (i = 0; rlist->seg[i] > 0; i++) {
       minl += dd[rlist->seg[i]];
     }
 
     l[1] = minl;
     j = 2;
-    while (j <= numsoln[d][k]) {
+    while (j <= LUT[d].count[k]) {
       rlist++;
       sum = l[rlist->parent];
       for (i = 0; rlist->seg[i] > 0; i++) {
@@ -1208,7 +1216,7 @@ Tree flutes_LD(int d,
                const std::vector<int>& s)
 {
   int k, pi, i, j;
-  struct csoln *rlist, *bestrlist;
+  const struct csoln *rlist, *bestrlist;
   int dd[2 * FLUTE_D - 2];  // 0..D-2 for v, D-1..2*D-3 for h
   int minl, sum, l[MPOWV + 1];
   int hflip;
@@ -1275,14 +1283,14 @@ Tree flutes_LD(int d,
     }
 
     minl = l[0] = xs[d - 1] - xs[0] + ys[d - 1] - ys[0];
-    rlist = LUT[d][k];
+    rlist = LUT[d].solutions(k);
     for (i = 0; rlist->seg[i] > 0; i++) {
       minl += dd[rlist->seg[i]];
     }
     bestrlist = rlist;
     l[1] = minl;
     j = 2;
-    while (j <= numsoln[d][k]) {
+    while (j <= LUT[d].count[k]) {
       rlist++;
       sum = l[rlist->parent];
       for (i = 0; rlist->seg[i] > 0; i++) {
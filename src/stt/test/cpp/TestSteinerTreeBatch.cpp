@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "stt/SteinerTreeBuilder.h"
+#include "utl/Logger.h"
+#include "utl/ThreadPool.h"
+
+namespace stt {
+namespace {
+
+void expectSameTree(const Tree& expected, const Tree& tree)
+{
+  EXPECT_EQ(tree.deg, expected.deg);
+  EXPECT_EQ(tree.length, expected.length);
+  ASSERT_EQ(tree.branch.size(), expected.branch.size());
+  for (size_t i = 0; i < tree.branch.size(); i++) {
+    EXPECT_EQ(tree.branch[i].x, expected.branch[i].x);
+    EXPECT_EQ(tree.branch[i].y, expected.branch[i].y);
+    EXPECT_EQ(tree.branch[i].n, expected.branch[i].n);
+  }
+}
+
+TEST(SteinerTreeBatch, MatchesSingleNetTreesForAnyThreadCount)
+{
+  utl::Logger logger;
+  SteinerTreeBuilder builder;
+  builder.init(nullptr, &logger);
+
+  // Nets of degree 2 to 60 so that FLUTE, its larger lookup tables and
+  // the PD-II path with a fallback to FLUTE are all exercised.
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> coord(0, 100000);
+  NetPins nets;
+  std::vector<Tree> expected;
+  for (int i = 0; i < 300; i++) {
+    const int degree = 2 + i % 59;
+    std::vector<int> x(degree);
+    std::vector<int> y(degree);
+    for (int pin = 0; pin < degree; pin++) {
+      x[pin] = coord(rng);
+      y[pin] = coord(rng);
+    }
+    const int drvr = rng() % degree;
+    const float alpha = (i % 3 == 0) ? 0.3 : 0.0;
+    nets.addNet(x, y, drvr, alpha);
+    expected.push_back(builder.makeSteinerTree(x, y, drvr, alpha));
+  }
+
+  utl::ThreadPool& pool = utl::ThreadPool::global();
+  const int threads = pool.getThreadCount();
+  for (const int thread_count : {1, 2, 8}) {
+    pool.setThreadCount(thread_count);
+    const std::vector<Tree> trees = builder.makeSteinerTrees(nets);
+    ASSERT_EQ(trees.size(), expected.size());
+    for (size_t net = 0; net < trees.size(); net++) {
+      expectSameTree(expected[net], trees[net]);
+    }
+  }
+  pool.setThreadCount(threads);
+}
+
+TEST(SteinerTreeBatch, MixedDefaultAndExplicitAlpha)
+{
+  utl::Logger logger;
+  SteinerTreeBuilder builder;
+  builder.init(nullptr, &logger);
+  builder.setAlpha(0.5);
+
+  // Nets added without an alpha use the builder's alpha, even when they
+  // come before or after nets with an explicit one.
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<int> coord(0, 100000);
+  NetPins nets;
+  std::vector<Tree> expected;
+  for (int i = 0; i < 12; i++) {
+    const int degree = 4 + i;
+    std::vector<int> x(degree);
+    std::vector<int> y(degree);
+    for (int pin = 0; pin < degree; pin++) {
+      x[pin] = coord(rng);
+      y[pin] = coord(rng);
+    }
+    if (i % 4 == 1) {
+      nets.addNet(x, y, 0, 0.0);
+      expected.push_back(builder.makeSteinerTree(x, y, 0, 0.0));
+    } else {
+      nets.addNet(x, y, 0);
+      expected.push_back(builder.makeSteinerTree(x, y, 0));
+    }
+  }
+  ASSERT_EQ(nets.alpha.size(), nets.netCount());
+  EXPECT_EQ(nets.alpha[1], 0.0);
+
+  const std::vector<Tree> trees = builder.makeSteinerTrees(nets);
+  ASSERT_EQ(trees.size(), expected.size());
+  for (size_t net = 0; net < trees.size(); net++) {
+    expectSameTree(expected[net], trees[net]);
+  }
+}
+
+}  // namespace
+}  // namespace stt
@@ -34,6 +34,10 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <boost/polygon/polygon.hpp>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
 
 #include "odb/db.h"
 
@@ -162,6 +166,33 @@ class Tapcell
   using Polygon90 = boost::polygon::polygon_90_with_holes_data<int>;
   using CornerMap = std::map<odb::dbRow*, std::set<odb::dbInst*>>;
 
+  // The occupied x ranges of a row.  Overlapping ranges are merged, abutting
+  // ones are kept apart, and all are sorted by their start so overlap
+  // queries are a binary search.
+  class RowOccupancy
+  {
+   public:
+    void insert(int x_start, int x_end);
+    // The leftmost occupied range overlapping [x_start, x_end), if any
+    std::optional<std::pair<int, int>> findOverlap(int x_start,
+                                                   int x_end) const;
+
+   private:
+    std::map<int, int> ranges_;  // start -> end
+  };
+
+  // A row that can hold tapcells and the locations found for them
+  struct TapRow
+  {
+    odb::dbRow* row;
+    odb::Rect bbox;
+    odb::dbOrientType orient;
+    int site_width;
+    int offset;
+    int pitch;
+    std::vector<int> locations;
+  };
+
   std::vector<odb::dbBox*> findBlockages();
   bool checkSymmetry(odb::dbMaster* master, const odb::dbOrientType& ori);
   odb::dbInst* makeInstance(odb::dbBlock* block,
@@ -173,23 +204,26 @@ class Tapcell
   std::optional<int> findValidLocation(int x,
                                        int width,
                                        const odb::dbOrientType& orient,
-                                       const std::set<odb::dbInst*>& row_insts,
+                                       const RowOccupancy& row_insts,
                                        int site_width,
                                        int tap_width,
                                        int row_urx,
-                                       bool disallow_one_site_gaps);
+                                       bool disallow_one_site_gaps) const;
   bool isOverlapping(int x,
                      int width,
                      const odb::dbOrientType& orient,
-                     const std::set<odb::dbInst*>& row_insts);
-  int placeTapcells(odb::dbMaster* tapcell_master,
-                    int dist,
-                    bool disallow_one_site_gaps);
+                     const RowOccupancy& row_insts) const;
   int placeTapcells(odb::dbMaster* tapcell_master,
                     int dist,
-                    odb::dbRow* row,
-                    bool is_edge,
                     bool disallow_one_site_gaps);
+  std::optional<TapRow> makeTapRow(odb::dbMaster* tapcell_master,
+                                   int dist,
+                                   odb::dbRow* row,
+                                   bool is_edge);
+  void findTapLocations(TapRow& tap_row,
+                        const std::vector<odb::Rect>& fixed_insts,
+                        int tap_width,
+                        bool disallow_one_site_gaps) const;
 
   int defaultDistance() const;
 
@@ -35,6 +35,7 @@
 
 #include "tap/tapcell.h"
 
+#include <algorithm>
 #include <map>
 #include <optional>
 #include <string>
@@ -45,6 +46,7 @@
 #include "ord/OpenRoad.hh"
 #include "sta/StaMain.hh"
 #include "utl/Logger.h"
+#include "utl/ThreadPool.h"
 #include "utl/algorithms.h"
 
 namespace tap {
@@ -159,31 +161,71 @@ int Tapcell::placeTapcells(odb::dbMaster* tapcell_master,
     edge_rows.insert(rows.begin(), rows.end());
   }
 
-  int inst = 0;
-  for (auto* row : db_->getChip()->getBlock()->getRows()) {
+  odb::dbBlock* block = db_->getChip()->getBlock();
+
+  std::vector<TapRow> tap_rows;
+  for (auto* row : block->getRows()) {
     const bool is_edge = edge_rows.find(row) != edge_rows.end();
-    inst += placeTapcells(
-        tapcell_master, dist, row, is_edge, disallow_one_site_gaps);
+    if (auto tap_row = makeTapRow(tapcell_master, dist, row, is_edge)) {
+      tap_rows.push_back(std::move(*tap_row));
+    }
+  }
+
+  // Fixed instances sorted by (ylo, xlo) so each row can find the ones it
+  // contains with a binary search rather than a scan of the block.
+  std::vector<odb::Rect> fixed_insts;
+  for (auto* inst : block->getInsts()) {
+    if (inst->isFixed()) {
+      fixed_insts.push_back(inst->getBBox()->getBox());
+    }
+  }
+  std::sort(fixed_insts.begin(),
+            fixed_insts.end(),
+            [](const odb::Rect& lhs, const odb::Rect& rhs) {
+              return std::make_pair(lhs.yMin(), lhs.xMin())
+                     < std::make_pair(rhs.yMin(), rhs.xMin());
+            });
+
+  // Rows are independent so their locations are found in parallel and the
+  // instances are then created in row order.
+  const int tap_width = tapcell_master->getWidth();
+  utl::ThreadPool::global().parallelFor(0, tap_rows.size(), [&](int i) {
+    findTapLocations(
+        tap_rows[i], fixed_insts, tap_width, disallow_one_site_gaps);
+  });
+
+  int inst = 0;
+  for (const TapRow& tap_row : tap_rows) {
+    const std::string prefix
+        = fmt::format("{}TAPCELL_{}_", tap_prefix_, tap_row.row->getName());
+    for (const int x : tap_row.locations) {
+      makeInstance(block,
+                   tapcell_master,
+                   tap_row.orient,
+                   x,
+                   tap_row.bbox.yMin(),
+                   prefix);
+      inst++;
+    }
   }
   logger_->info(utl::TAP, 5, "Inserted {} tapcells.", inst);
   return inst;
 }
 
-int Tapcell::placeTapcells(odb::dbMaster* tapcell_master,
-                           const int dist,
-                           odb::dbRow* row,
-                           const bool is_edge,
-                           const bool disallow_one_site_gaps)
+std::optional<Tapcell::TapRow> Tapcell::makeTapRow(
+    odb::dbMaster* tapcell_master,
+    const int dist,
+    odb::dbRow* row,
+    const bool is_edge)
 {
   if (row->getSite()->getName() != tapcell_master->getSite()->getName()) {
-    return 0;
+    return std::nullopt;
   }
   if (!checkSymmetry(tapcell_master, row->getOrient())) {
-    return 0;
+    return std::nullopt;
   }
 
   const int tap_width = tapcell_master->getWidth();
-  int insts = 0;
 
   int offset = 0;
   int pitch_mult = 2;
@@ -199,51 +241,108 @@ int Tapcell::placeTapcells(odb::dbMaster* tapcell_master,
     offset = pitch;
   }
 
-  const odb::Rect row_bb = row->getBBox();
+  TapRow tap_row;
+  tap_row.row = row;
+  tap_row.bbox = row->getBBox();
+  tap_row.orient = row->getOrient();
+  tap_row.site_width = row->getSite()->getWidth();
+  tap_row.offset = offset;
+  tap_row.pitch = pitch;
+  return tap_row;
+}
 
-  std::set<odb::dbInst*> row_insts;
-  for (auto* inst : db_->getChip()->getBlock()->getInsts()) {
-    if (!inst->isFixed()) {
-      continue;
-    }
+// Find the tapcell locations in a row.  Only touches tap_row so rows can be
+// processed concurrently.
+void Tapcell::findTapLocations(TapRow& tap_row,
+                               const std::vector<odb::Rect>& fixed_insts,
+                               const int tap_width,
+                               const bool disallow_one_site_gaps) const
+{
+  const odb::Rect& row_bb = tap_row.bbox;
 
-    if (row_bb.contains(inst->getBBox()->getBox())) {
-      row_insts.insert(inst);
+  RowOccupancy row_insts;
+  auto by_y = [](const odb::Rect& rect, const std::pair<int, int>& key) {
+    return std::make_pair(rect.yMin(), rect.xMin()) < key;
+  };
+  auto it = std::lower_bound(fixed_insts.begin(),
+                             fixed_insts.end(),
+                             std::make_pair(row_bb.yMin(), row_bb.xMin()),
+                             by_y);
+  while (it != fixed_insts.end() && it->yMin() <= row_bb.yMax()) {
+    const int y = it->yMin();
+    for (; it != fixed_insts.end() && it->yMin() == y
+           && it->xMin() <= row_bb.xMax();
+         it++) {
+      if (row_bb.contains(*it)) {
+        row_insts.insert(it->xMin(), it->xMax());
+      }
     }
+    // Skip the rest of this ylo and the part of the next one left of the row
+    it = std::lower_bound(
+        it, fixed_insts.end(), std::make_pair(y + 1, row_bb.xMin()), by_y);
   }
 
   const int llx = row_bb.xMin();
   const int urx = row_bb.xMax();
 
-  const int site_width = row->getSite()->getWidth();
-  for (int x = llx + offset; x < urx; x += pitch) {
+  const int site_width = tap_row.site_width;
+  for (int x = llx + tap_row.offset; x < urx; x += tap_row.pitch) {
     x = odb::makeSiteLoc(x, site_width, true, llx);
     // Check if site is filled
-    const odb::dbOrientType ori = row->getOrient();
     std::optional<int> x_loc = findValidLocation(x,
                                                  tap_width,
-                                                 ori,
+                                                 tap_row.orient,
                                                  row_insts,
                                                  site_width,
                                                  tap_width,
                                                  urx,
                                                  disallow_one_site_gaps);
-    if (x_loc) {
-      const int lly = row_bb.yMin();
-      auto* inst = makeInstance(
-          db_->getChip()->getBlock(),
-          tapcell_master,
-          ori,
-          *x_loc,
-          lly,
-          fmt::format("{}TAPCELL_{}_", tap_prefix_, row->getName()));
-      row_insts.insert(inst);
-      insts++;
+    if (x_loc && *x_loc >= 0 && row_bb.yMin() >= 0) {
+      tap_row.locations.push_back(*x_loc);
+      row_insts.insert(*x_loc, *x_loc + tap_width);
       x = *x_loc;
     }
   }
+}
 
-  return insts;
+void Tapcell::RowOccupancy::insert(int x_start, int x_end)
+{
+  // Merge only with ranges that overlap [x_start, x_end).  Abutting
+  // instances stay separate so findValidLocation sees the same instance
+  // edges it would when checking the instances one at a time.
+  auto it = ranges_.upper_bound(x_start);
+  if (it != ranges_.begin()) {
+    auto prev = std::prev(it);
+    if (prev->second > x_start) {
+      x_start = prev->first;
+      x_end = std::max(x_end, prev->second);
+      it = prev;
+    }
+  }
+  while (it != ranges_.end() && it->first < x_end) {
+    x_end = std::max(x_end, it->second);
+    it = ranges_.erase(it);
+  }
+  ranges_[x_start] = x_end;
+}
+
+std::optional<std::pair<int, int>> Tapcell::RowOccupancy::findOverlap(
+    const int x_start,
+    const int x_end) const
+{
+  // Ranges are disjoint so only the one starting at or before x_start and
+  // the one after it can be the leftmost overlap.
+  auto it = ranges_.upper_bound(x_start);
+  if (it != ranges_.begin()) {
+    auto prev = std::prev(it);
+    if (prev->second > x_start) {
+      return *prev;
+    }
+  }
+  if (it != ranges_.end() && it->first < x_end) {
+    return *it;
+  }
+  return std::nullopt;
 }
 
 inline void findStartEnd(int x,
@@ -265,11 +364,11 @@ std::optional<int> Tapcell::findValidLocation(
     const int x,
     const int width,
     const odb::dbOrientType& orient,
-    const std::set<odb::dbInst*>& row_insts,
+    const RowOccupancy& row_insts,
     const int site_width,
     const int tap_width,
     const int row_urx,
-    const bool disallow_one_site_gaps)
+    const bool disallow_one_site_gaps) const
 {
   int x_start;
   int x_end;
@@ -283,16 +382,13 @@ std::optional<int> Tapcell::findValidLocation(
 
   PartialOverlap partially_overlap;
   bool overlap = false;
-  for (const auto& inst : row_insts) {
-    const odb::Rect inst_bb = inst->getBBox()->getBox();
-    if (x_end > inst_bb.xMin() && x_start < inst_bb.xMax()) {
-      partially_overlap.left = x_end > inst_bb.xMax();
-      partially_overlap.x_start_left = inst_bb.xMax();
-      partially_overlap.right = x_start < inst_bb.xMin();
-      partially_overlap.x_limit_right = inst_bb.xMin();
-      overlap = true;
-      break;
-    }
+  if (auto range = row_insts.findOverlap(x_start, x_end)) {
+    const auto [inst_x_min, inst_x_max] = *range;
+    partially_overlap.left = x_end > inst_x_max;
+    partially_overlap.x_start_left = inst_x_max;
+    partially_overlap.right = x_start < inst_x_min;
+    partially_overlap.x_limit_right = inst_x_min;
+    overlap = true;
   }
 
   std::optional<int> x_loc;
@@ -320,19 +416,13 @@ std::optional<int> Tapcell::findValidLocation(
 bool Tapcell::isOverlapping(const int x,
                             const int width,
                             const odb::dbOrientType& orient,
-                            const std::set<odb::dbInst*>& row_insts)
+                            const RowOccupancy& row_insts) const
 {
   int x_start;
   int x_end;
   findStartEnd(x, width, orient, x_start, x_end);
 
-  for (const auto& inst : row_insts) {
-    const odb::Rect inst_bb = inst->getBBox()->getBox();
-    if (x_end > inst_bb.xMin() && x_start < inst_bb.xMax()) {
-      return true;
-    }
-  }
-  return false;
+  return row_insts.findOverlap(x_start, x_end).has_value();
 }
 
 vector<odb::dbBox*> Tapcell::findBlockages()
@@ -0,0 +1,33 @@
+# tapcell -disallow_one_site_gaps next to a run of abutting fixed instances
+source "helpers.tcl"
+
+read_lef Nangate45/Nangate45_tech.lef
+read_lef Nangate45/Nangate45_stdcell.lef
+
+set db [ord::get_db]
+set block [odb::dbBlock_create [odb::dbChip_create $db] "top"]
+$block setDefUnits 2000
+
+initialize_floorplan \
+  -die_area {0 0 7.6 1.4} \
+  -core_area {0 0 7.6 1.4} \
+  -site FreePDK45_38x28_10R_NP_162NW_34O
+
+# Sites 12-19, 20 and 21 are filled by three abutting instances
+foreach {name master x} {
+  wide FILLCELL_X8 4560
+  narrow1 FILLCELL_X1 7600
+  narrow2 FILLCELL_X1 7980
+} {
+  set inst [odb::dbInst_create $block [$db findMaster $master] $name]
+  $inst setLocation $x 0
+  $inst setPlacementStatus FIRM
+}
+
+tapcell -distance 2 -tapcell_master TAPCELL_X1 -disallow_one_site_gaps
+
+foreach inst [$block getInsts] {
+  if { [[$inst getMaster] getName] == "TAPCELL_X1" } {
+    puts "[$inst getName] [[$inst getBBox] xMin]"
+  }
+}
@@ -37,11 +37,13 @@
 
 #include <array>
 #include <atomic>
+#include <cstdint>
 #include <cstdlib>
+#include <functional>
 #include <iomanip>
 #include <map>
+#include <mutex>
 #include <sstream>
-#include <stack>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -52,6 +54,10 @@
 #include "spdlog/fmt/ostr.h"
 #include "spdlog/spdlog.h"
 
+namespace spdlog::details {
+class thread_pool;
+}
+
 namespace utl {
 
 // Keep this sorted
@@ -128,12 +134,15 @@ class Logger
                     const Args&... args)
   {
     // Message counters do NOT apply to debug messages.
+    fmt::memory_buffer buffer;
+    fmt::format_to(std::back_inserter(buffer),
+                   "[{} {}-{}] ",
+                   level_names[spdlog::level::level_enum::debug],
+                   tool_names_[tool],
+                   group);
+    fmt::format_to(std::back_inserter(buffer), FMT_RUNTIME(message), args...);
     logger_->log(spdlog::level::level_enum::debug,
-                 FMT_RUNTIME("[{} {}-{}] " + message),
-                 level_names[spdlog::level::level_enum::debug],
-                 tool_names_[tool],
-                 group,
-                 args...);
+                 spdlog::string_view_t(buffer.data(), buffer.size()));
     logger_->flush();
   }
 
@@ -178,6 +187,8 @@ class Logger
                                           const Args&... args)
   {
     log(tool, spdlog::level::level_enum::critical, id, message, args...);
+    // Make sure queued messages are written before exiting.
+    setAsync(false);
     exit(EXIT_FAILURE);
   }
 
@@ -213,7 +224,9 @@ class Logger
 
   bool debugCheck(ToolId tool, const char* group, int level) const
   {
-    if (!debug_on_) {
+    // Tools without a debug group at this level are rejected before the
+    // group lookup so debugPrint stays cheap in hot loops.
+    if (!debug_on_ || level > debug_tool_level_[tool]) {
       return false;
     }
     auto& groups = debug_group_level_[tool];
@@ -221,6 +234,10 @@ class Logger
     return (it != groups.end() && level <= it->second);
   }
 
+  // Messages are queued and written by a background thread when async.
+  // Only call this outside of parallel regions.
+  void setAsync(bool async);
+
   void suppressMessage(ToolId tool, int id);
   void unsuppressMessage(ToolId tool, int id);
 
@@ -231,10 +248,31 @@ class Logger
 
   void setMetricsStage(std::string_view format);
   void clearMetricsStage();
-  void pushMetricsStage(std::string_view format);
+  void pushMetricsStage(std::string_view format, bool record_resources = true);
   std::string popMetricsStage();
 
+  // Metrics stages record their wall time, CPU time, current and peak memory
+  // and thread count when they are closed (popped, replaced, cleared or at
+  // exit).  Counters added here (eg design object counts) are sampled at
+  // the start and end of each stage as <name>__start and <name>__end.
+  using MetricsCounter = std::function<int64_t()>;
+  void addMetricsCounter(std::string_view name, MetricsCounter counter);
+
  private:
+  struct ResourceUsage
+  {
+    double wall_seconds;
+    double cpu_seconds;
+    std::vector<int64_t> counters;
+  };
+
+  struct MetricsStage
+  {
+    std::string format;
+    ResourceUsage start;
+    bool record_resources;
+  };
+
   std::vector<std::string> metrics_sinks_;
   std::list<MetricsEntry> metrics_entries_;
   std::vector<MetricsPolicy> metrics_policies_;
@@ -248,14 +286,23 @@ class Logger
   {
     assert(id >= 0 && id <= max_message_id);
     auto& counter = message_counters_[tool][id];
+    // Messages over their limit are dropped without touching the counter
+    // so they don't contend on it when issued from parallel loops.
+    if (counter.load(std::memory_order_relaxed) > max_message_print) {
+      return;
+    }
     auto count = counter++;
     if (count < max_message_print) {
-      logger_->log(level,
-                   FMT_RUNTIME("[{} {}-{:04d}] " + message),
-                   level_names[level],
-                   tool_names_[tool],
-                   id,
-                   args...);
+      // The prefix is formatted separately to avoid building a new format
+      // string for every message.
+      fmt::memory_buffer buffer;
+      fmt::format_to(std::back_inserter(buffer),
+                     "[{} {}-{:04d}] ",
+                     level_names[level],
+                     tool_names_[tool],
+                     id);
+      fmt::format_to(std::back_inserter(buffer), FMT_RUNTIME(message), args...);
+      logger_->log(level, spdlog::string_view_t(buffer.data(), buffer.size()));
       return;
     }
 
@@ -273,14 +320,19 @@ class Logger
 
   inline void log_metric(const std::string metric, const std::string value)
   {
+    std::lock_guard<std::mutex> lock(metrics_mutex_);
     std::string key;
     if (metrics_stages_.empty())
       key = metric;
     else
-      key = fmt::format(FMT_RUNTIME(metrics_stages_.top()), metric);
+      key = fmt::format(FMT_RUNTIME(metrics_stages_.back().format), metric);
     metrics_entries_.push_back({std::move(key), value});
   }
 
+  // These expect metrics_mutex_ to be held.
+  ResourceUsage sampleResources() const;
+  void logStageResources(const MetricsStage& stage);
+
   void flushMetrics();
   void finalizeMetrics();
 
@@ -297,19 +349,28 @@ class Logger
   using DebugGroups = std::map<std::string, int, StringViewCmp>;
 
   static constexpr int max_message_id = 9999;
+  static constexpr size_t async_queue_size = 8192;
 
   // Stop issuing messages of a given tool/id when this limit is hit.
   static int max_message_print;
 
   std::vector<spdlog::sink_ptr> sinks_;
+  // Declared before logger_ so that queued messages are written when the
+  // async logger is destroyed.
+  std::shared_ptr<spdlog::details::thread_pool> async_pool_;
   std::shared_ptr<spdlog::logger> logger_;
-  std::stack<std::string> metrics_stages_;
+  // Innermost stage last.
+  std::vector<MetricsStage> metrics_stages_;
+  std::vector<std::pair<std::string, MetricsCounter>> metrics_counters_;
+  std::mutex metrics_mutex_;
 
   // This matrix is pre-allocated so it can be safely updated
   // from multiple threads without locks.
   using MessageCounter = std::array<std::atomic_int16_t, max_message_id + 1>;
   std::array<MessageCounter, ToolId::SIZE> message_counters_;
   std::array<DebugGroups, ToolId::SIZE> debug_group_level_;
+  // Highest debug level of any group of each tool.
+  std::array<int, ToolId::SIZE> debug_tool_level_;
   bool debug_on_;
   std::atomic_int warning_count_;
   std::atomic_int error_count_;
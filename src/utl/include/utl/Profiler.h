@@ -0,0 +1,141 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace utl {
+
+class Logger;
+
+// Hierarchical wall-clock profiler.  Code is instrumented with ProfileScope
+// objects; while the profiler is stopped a scope costs a single relaxed
+// atomic load.  While running, every thread records its scopes into its own
+// buffer so there is no contention on the hot path.  The recorded events can
+// be written as a Chrome trace (chrome://tracing, ui.perfetto.dev), as folded
+// stacks for flame graph tools, or summarized to the log.
+class Profiler
+{
+ public:
+  struct Event
+  {
+    std::string name;
+    int64_t begin_ns;
+    int64_t end_ns;
+    // Index of the enclosing scope in the same thread buffer, -1 at the root.
+    int parent;
+  };
+
+  static Profiler& instance();
+
+  static bool enabled()
+  {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  // Discards any previous recording and starts a new one.  start, stop and
+  // clear must not be called while other threads are inside a scope.
+  void start();
+  void stop();
+  void clear();
+  bool empty() const;
+
+  bool writeChromeTrace(const std::string& file_name) const;
+  bool writeFoldedStacks(const std::string& file_name) const;
+  // Reports the max_entries call paths with the largest inclusive time.
+  void report(Logger* logger, int max_entries = 20) const;
+
+  // Used by ProfileScope.
+  int beginScope(const char* name);
+  void endScope(int index);
+
+ private:
+  struct ThreadBuffer
+  {
+    int tid;
+    std::vector<Event> events;
+    int current = -1;
+  };
+
+  Profiler() = default;
+
+  // Buffers are owned by the profiler and never freed so that the
+  // thread_local pointer to them stays valid across start/clear.
+  ThreadBuffer* threadBuffer();
+  static int64_t now();
+
+  static std::atomic<bool> enabled_;
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+  int64_t origin_ns_ = 0;
+};
+
+// RAII helper that records the lifetime of the enclosing block.
+class ProfileScope
+{
+ public:
+  explicit ProfileScope(const char* name)
+      : index_(Profiler::enabled() ? Profiler::instance().beginScope(name) : -1)
+  {
+  }
+  explicit ProfileScope(const std::string& name) : ProfileScope(name.c_str())
+  {
+  }
+  ~ProfileScope() { done(); }
+
+  // Ends the scope early.
+  void done()
+  {
+    if (index_ >= 0) {
+      Profiler::instance().endScope(index_);
+      index_ = -1;
+    }
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+ private:
+  int index_;
+};
+
+}  // namespace utl
@@ -0,0 +1,241 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace utl {
+
+// A process-wide pool of worker threads shared by all tools so that the
+// total number of busy threads follows the thread count set in OpenROAD
+// (set_thread_count) instead of each tool creating its own threads.
+//
+// Parallel work issued from inside a pool task (nested parallelism) runs
+// serially on the calling thread.  This keeps nested tools from
+// oversubscribing the machine and cannot deadlock on the pool.
+class ThreadPool
+{
+ public:
+  // The shared pool.  It starts with a single thread (no workers).
+  static ThreadPool& global();
+
+  explicit ThreadPool(int threads = 1);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Total number of threads used by parallelFor including the caller.
+  // Must not be called while work is in flight.
+  void setThreadCount(int threads);
+  int getThreadCount() const { return threads_; }
+
+  // True on a pool worker thread.
+  static bool inWorker() { return in_worker_; }
+
+  // Queues fn on a worker.  With no workers, or from a worker, fn runs
+  // immediately on the calling thread.
+  template <typename Fn>
+  auto submit(Fn&& fn) -> std::future<std::invoke_result_t<Fn>>;
+
+  // Calls fn(i) for every i in [begin, end).  Indices are handed out in
+  // chunks of grain so fn should be cheap to call per index.  The calling
+  // thread takes part in the loop.  The first exception thrown by fn is
+  // rethrown to the caller once all running chunks are done.
+  template <typename Fn>
+  void parallelFor(int begin, int end, Fn&& fn, int grain = 1);
+
+ private:
+  void startWorkers(int count);
+  void stopWorkers();
+  void enqueue(std::function<void()> task);
+  void workerLoop();
+  // Runs one queued task if there is any, for callers waiting on tasks.
+  bool runPendingTask();
+
+  friend class TaskGroup;
+
+  int threads_ = 1;
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable task_ready_;
+  bool stopping_ = false;
+
+  static thread_local bool in_worker_;
+};
+
+// A set of tasks that are waited on together.  Tasks may be added from any
+// thread.  While waiting, the caller helps by running queued tasks.
+class TaskGroup
+{
+ public:
+  explicit TaskGroup(ThreadPool& pool = ThreadPool::global()) : pool_(pool) {}
+  ~TaskGroup();
+
+  template <typename Fn>
+  void run(Fn&& fn);
+
+  // Blocks until every task has finished and rethrows the first exception
+  // thrown by any of them.
+  void wait();
+
+ private:
+  void finish(std::exception_ptr error);
+
+  ThreadPool& pool_;
+  std::mutex mutex_;
+  std::condition_variable done_;
+  int pending_ = 0;
+  std::exception_ptr error_;
+};
+
+template <typename Fn>
+auto ThreadPool::submit(Fn&& fn) -> std::future<std::invoke_result_t<Fn>>
+{
+  using Result = std::invoke_result_t<Fn>;
+  auto task
+      = std::make_shared<std::packaged_task<Result()>>(std::forward<Fn>(fn));
+  std::future<Result> result = task->get_future();
+  if (workers_.empty() || in_worker_) {
+    (*task)();
+  } else {
+    enqueue([task] { (*task)(); });
+  }
+  return result;
+}
+
+template <typename Fn>
+void ThreadPool::parallelFor(int begin, int end, Fn&& fn, int grain)
+{
+  if (begin >= end) {
+    return;
+  }
+  grain = std::max(grain, 1);
+  const int chunks = (end - begin + grain - 1) / grain;
+  const int helpers = std::min<int>(workers_.size(), chunks - 1);
+  if (helpers <= 0 || in_worker_) {
+    for (int i = begin; i < end; ++i) {
+      fn(i);
+    }
+    return;
+  }
+
+  std::atomic<int> next{begin};
+  std::atomic<bool> failed{false};
+  auto run_chunks = [&] {
+    while (!failed.load(std::memory_order_relaxed)) {
+      const int first = next.fetch_add(grain, std::memory_order_relaxed);
+      if (first >= end) {
+        break;
+      }
+      const int last = std::min(first + grain, end);
+      try {
+        for (int i = first; i < last; ++i) {
+          fn(i);
+        }
+      } catch (...) {
+        failed = true;
+        throw;
+      }
+    }
+  };
+
+  TaskGroup group(*this);
+  for (int i = 0; i < helpers; ++i) {
+    group.run(run_chunks);
+  }
+  std::exception_ptr error;
+  try {
+    run_chunks();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  try {
+    group.wait();
+  } catch (...) {
+    if (!error) {
+      error = std::current_exception();
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+template <typename Fn>
+void TaskGroup::run(Fn&& fn)
+{
+  if (pool_.workers_.empty() || ThreadPool::inWorker()) {
+    std::exception_ptr error;
+    try {
+      fn();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (error && !error_) {
+      error_ = error;
+    }
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_++;
+  }
+  pool_.enqueue([this, fn = std::forward<Fn>(fn)]() mutable {
+    std::exception_ptr error;
+    try {
+      fn();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    finish(error);
+  });
+}
+
+}  // namespace utl
@@ -35,10 +35,15 @@
 
 #include "utl/Logger.h"
 
+#include <sys/resource.h>
+#include <unistd.h>
+
 #include <atomic>
+#include <chrono>
 #include <fstream>
 #include <mutex>
 
+#include "spdlog/async.h"
 #include "spdlog/sinks/basic_file_sink.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 #include "spdlog/spdlog.h"
@@ -71,6 +76,7 @@ Logger::Logger(const char* log_filename, const char* metrics_filename)
       counter = 0;
     }
   }
+  debug_tool_level_.fill(0);
 }
 
 Logger::~Logger()
@@ -108,8 +114,8 @@ ToolId Logger::findToolId(const char* tool_name)
 
 void Logger::setDebugLevel(ToolId tool, const char* group, int level)
 {
+  auto& groups = debug_group_level_.at(tool);
   if (level == 0) {
-    auto& groups = debug_group_level_[tool];
     auto it = groups.find(group);
     if (it != groups.end()) {
       groups.erase(it);
@@ -119,8 +125,38 @@ void Logger::setDebugLevel(ToolId tool, const char* group, int level)
     }
   } else {
     debug_on_ = true;
-    debug_group_level_.at(tool)[group] = level;
+    groups[group] = level;
+  }
+  int tool_level = 0;
+  for (const auto& [name, group_level] : groups) {
+    tool_level = std::max(tool_level, group_level);
   }
+  debug_tool_level_[tool] = tool_level;
+}
+
+void Logger::setAsync(bool async)
+{
+  if (async == (async_pool_ != nullptr)) {
+    return;
+  }
+  if (async) {
+    async_pool_
+        = std::make_shared<spdlog::details::thread_pool>(async_queue_size, 1);
+    logger_ = std::make_shared<spdlog::async_logger>(
+        "logger",
+        sinks_.begin(),
+        sinks_.end(),
+        async_pool_,
+        spdlog::async_overflow_policy::block);
+  } else {
+    // Releasing the async logger and then its pool writes out the queued
+    // messages before returning.
+    logger_ = std::make_shared<spdlog::logger>(
+        "logger", sinks_.begin(), sinks_.end());
+    async_pool_.reset();
+  }
+  logger_->set_pattern(pattern_);
+  logger_->set_level(spdlog::level::level_enum::debug);
 }
 
 void Logger::addSink(spdlog::sink_ptr sink)
@@ -147,34 +183,133 @@ void Logger::removeSink(spdlog::sink_ptr sink)
 
 void Logger::setMetricsStage(std::string_view format)
 {
-  if (metrics_stages_.empty())
-    metrics_stages_.push(std::string(format));
-  else
-    metrics_stages_.top() = format;
+  std::lock_guard<std::mutex> lock(metrics_mutex_);
+  if (metrics_stages_.empty()) {
+    metrics_stages_.push_back({std::string(format), sampleResources(), true});
+  } else {
+    logStageResources(metrics_stages_.back());
+    metrics_stages_.back() = {std::string(format), sampleResources(), true};
+  }
 }
 
 void Logger::clearMetricsStage()
 {
-  std::stack<std::string> new_stack;
-  metrics_stages_.swap(new_stack);
+  std::lock_guard<std::mutex> lock(metrics_mutex_);
+  for (auto stage = metrics_stages_.rbegin(); stage != metrics_stages_.rend();
+       ++stage) {
+    logStageResources(*stage);
+  }
+  metrics_stages_.clear();
 }
 
-void Logger::pushMetricsStage(std::string_view format)
+void Logger::pushMetricsStage(std::string_view format, bool record_resources)
 {
-  metrics_stages_.push(std::string(format));
+  std::lock_guard<std::mutex> lock(metrics_mutex_);
+  metrics_stages_.push_back(
+      {std::string(format), sampleResources(), record_resources});
 }
 
 std::string Logger::popMetricsStage()
 {
+  std::lock_guard<std::mutex> lock(metrics_mutex_);
   if (!metrics_stages_.empty()) {
-    std::string stage = metrics_stages_.top();
-    metrics_stages_.pop();
+    logStageResources(metrics_stages_.back());
+    std::string stage = std::move(metrics_stages_.back().format);
+    metrics_stages_.pop_back();
     return stage;
   } else {
     return "";
   }
 }
 
+void Logger::addMetricsCounter(std::string_view name, MetricsCounter counter)
+{
+  std::lock_guard<std::mutex> lock(metrics_mutex_);
+  metrics_counters_.emplace_back(std::string(name), std::move(counter));
+}
+
+namespace {
+
+int64_t currentRSS()
+{
+  int64_t pages = 0;
+  std::ifstream statm("/proc/self/statm");
+  if (statm >> pages >> pages) {
+    return pages * sysconf(_SC_PAGESIZE);
+  }
+  return 0;
+}
+
+int64_t peakRSS()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+  return usage.ru_maxrss;
+#else
+  return usage.ru_maxrss * 1024L;
+#endif
+}
+
+int threadCount()
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, 8, "Threads:") == 0) {
+      return std::atoi(line.c_str() + 8);
+    }
+  }
+  return 0;
+}
+
+}  // namespace
+
+Logger::ResourceUsage Logger::sampleResources() const
+{
+  ResourceUsage usage;
+  usage.wall_seconds = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                           .count();
+  struct rusage rusage;
+  getrusage(RUSAGE_SELF, &rusage);
+  usage.cpu_seconds = rusage.ru_utime.tv_sec + rusage.ru_stime.tv_sec
+                      + (rusage.ru_utime.tv_usec + rusage.ru_stime.tv_usec)
+                            / 1e6;
+  usage.counters.reserve(metrics_counters_.size());
+  for (const auto& [name, counter] : metrics_counters_) {
+    usage.counters.push_back(counter());
+  }
+  return usage;
+}
+
+void Logger::logStageResources(const MetricsStage& stage)
+{
+  if (!stage.record_resources) {
+    return;
+  }
+  const ResourceUsage end = sampleResources();
+  auto add = [&](const std::string& metric, const std::string& value) {
+    metrics_entries_.push_back(
+        {fmt::format(FMT_RUNTIME(stage.format), metric), value});
+  };
+  add("runtime__wall",
+      fmt::format("{:.3f}", end.wall_seconds - stage.start.wall_seconds));
+  add("runtime__cpu",
+      fmt::format("{:.3f}", end.cpu_seconds - stage.start.cpu_seconds));
+  add("mem__current", std::to_string(currentRSS()));
+  add("mem__peak", std::to_string(peakRSS()));
+  add("threads", std::to_string(threadCount()));
+  // Counters added after the stage started have no start value.
+  for (size_t i = 0; i < metrics_counters_.size(); ++i) {
+    const std::string& name = metrics_counters_[i].first;
+    if (i < stage.start.counters.size()) {
+      add(name + "__start", std::to_string(stage.start.counters[i]));
+    }
+    add(name + "__end", std::to_string(end.counters[i]));
+  }
+}
+
 void Logger::flushMetrics()
 {
   const std::string json = MetricsEntry::assembleJSON(metrics_entries_);
@@ -191,6 +326,15 @@ void Logger::flushMetrics()
 
 void Logger::finalizeMetrics()
 {
+  {
+    std::lock_guard<std::mutex> lock(metrics_mutex_);
+    for (auto stage = metrics_stages_.rbegin();
+         stage != metrics_stages_.rend();
+         ++stage) {
+      logStageResources(*stage);
+    }
+  }
+
   log_metric("flow__warnings__count", std::to_string(warning_count_));
   log_metric("flow__errors__count", std::to_string(error_count_));
 
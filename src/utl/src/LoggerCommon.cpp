@@ -36,6 +36,7 @@
 #include "LoggerCommon.h"
 
 #include "utl/Logger.h"
+#include "utl/Profiler.h"
 
 namespace ord {
 // Defined in OpenRoad.i
@@ -118,10 +119,10 @@ void clear_metrics_stage()
   logger->clearMetricsStage();
 }
 
-void push_metrics_stage(const char* fmt)
+void push_metrics_stage(const char* fmt, bool record_resources)
 {
   Logger* logger = getLogger();
-  logger->pushMetricsStage(fmt);
+  logger->pushMetricsStage(fmt, record_resources);
 }
 
 std::string pop_metrics_stage()
@@ -142,4 +143,39 @@ void unsuppress_message(utl::ToolId tool, int id)
   logger->unsuppressMessage(tool, id);
 }
 
+void set_async_logging(bool async)
+{
+  Logger* logger = getLogger();
+  logger->setAsync(async);
+}
+
+void start_profiler()
+{
+  Profiler::instance().start();
+}
+
+void stop_profiler()
+{
+  Profiler::instance().stop();
+}
+
+void write_profiler_trace(const char* file_name)
+{
+  if (!Profiler::instance().writeChromeTrace(file_name)) {
+    getLogger()->error(UTL, 10, "Unable to write trace file {}.", file_name);
+  }
+}
+
+void write_profiler_stacks(const char* file_name)
+{
+  if (!Profiler::instance().writeFoldedStacks(file_name)) {
+    getLogger()->error(UTL, 11, "Unable to write stacks file {}.", file_name);
+  }
+}
+
+void report_profiler(int max_entries)
+{
+  Profiler::instance().report(getLogger(), max_entries);
+}
+
 }  // namespace utl
@@ -49,9 +49,15 @@ void metric_integer(const char* metric, const int value);
 void metric_float(const char* metric, const double value);
 void set_metrics_stage(const char* fmt);
 void clear_metrics_stage();
-void push_metrics_stage(const char* fmt);
+void push_metrics_stage(const char* fmt, bool record_resources = true);
 std::string pop_metrics_stage();
 void suppress_message(utl::ToolId tool, int id);
 void unsuppress_message(utl::ToolId tool, int id);
+void set_async_logging(bool async);
+void start_profiler();
+void stop_profiler();
+void write_profiler_trace(const char* file_name);
+void write_profiler_stacks(const char* file_name);
+void report_profiler(int max_entries);
 
 }  // namespace utl
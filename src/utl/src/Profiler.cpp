@@ -0,0 +1,257 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "utl/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+
+#include "utl/Logger.h"
+
+namespace utl {
+
+std::atomic<bool> Profiler::enabled_{false};
+
+Profiler& Profiler::instance()
+{
+  static Profiler profiler;
+  return profiler;
+}
+
+int64_t Profiler::now()
+{
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void Profiler::start()
+{
+  clear();
+  origin_ns_ = now();
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Profiler::stop()
+{
+  enabled_.store(false, std::memory_order_relaxed);
+}
+
+void Profiler::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& buffer : buffers_) {
+    buffer->events.clear();
+    buffer->current = -1;
+  }
+}
+
+bool Profiler::empty() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return std::all_of(buffers_.begin(), buffers_.end(), [](const auto& buffer) {
+    return buffer->events.empty();
+  });
+}
+
+Profiler::ThreadBuffer* Profiler::threadBuffer()
+{
+  thread_local ThreadBuffer* buffer = nullptr;
+  if (buffer == nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffers_.push_back(std::make_unique<ThreadBuffer>());
+    buffer = buffers_.back().get();
+    buffer->tid = buffers_.size() - 1;
+  }
+  return buffer;
+}
+
+int Profiler::beginScope(const char* name)
+{
+  ThreadBuffer* buffer = threadBuffer();
+  const int index = buffer->events.size();
+  buffer->events.push_back({name, now(), -1, buffer->current});
+  buffer->current = index;
+  return index;
+}
+
+void Profiler::endScope(int index)
+{
+  ThreadBuffer* buffer = threadBuffer();
+  // The recording may have been cleared while the scope was open.
+  if (index >= static_cast<int>(buffer->events.size())) {
+    return;
+  }
+  Event& event = buffer->events[index];
+  event.end_ns = now();
+  buffer->current = event.parent;
+}
+
+namespace {
+
+std::string escapeJson(const std::string& str)
+{
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped += ' ';
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+struct PathStats
+{
+  int64_t inclusive_ns = 0;
+  int64_t self_ns = 0;
+  int64_t count = 0;
+};
+
+// Aggregates the closed events of one thread by their call path
+// ("outer;inner").  Events that are still open are ignored.
+void aggregate(const std::vector<Profiler::Event>& events,
+               std::map<std::string, PathStats>& stats)
+{
+  std::vector<std::string> paths(events.size());
+  std::vector<int64_t> child_ns(events.size(), 0);
+  for (size_t i = 0; i < events.size(); ++i) {
+    const Profiler::Event& event = events[i];
+    paths[i] = event.parent < 0 ? event.name
+                                : paths[event.parent] + ';' + event.name;
+    if (event.end_ns >= 0 && event.parent >= 0) {
+      child_ns[event.parent] += event.end_ns - event.begin_ns;
+    }
+  }
+  for (size_t i = 0; i < events.size(); ++i) {
+    const Profiler::Event& event = events[i];
+    if (event.end_ns < 0) {
+      continue;
+    }
+    const int64_t duration = event.end_ns - event.begin_ns;
+    PathStats& path_stats = stats[paths[i]];
+    path_stats.inclusive_ns += duration;
+    path_stats.self_ns += std::max<int64_t>(duration - child_ns[i], 0);
+    path_stats.count++;
+  }
+}
+
+}  // namespace
+
+bool Profiler::writeChromeTrace(const std::string& file_name) const
+{
+  std::ofstream out(file_name);
+  if (!out) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto& buffer : buffers_) {
+    for (const Event& event : buffer->events) {
+      if (event.end_ns < 0) {
+        continue;
+      }
+      if (!first) {
+        out << ',';
+      }
+      first = false;
+      out << "\n{\"name\":\"" << escapeJson(event.name)
+          << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+          << ",\"ts\":" << (event.begin_ns - origin_ns_) / 1e3
+          << ",\"dur\":" << (event.end_ns - event.begin_ns) / 1e3 << '}';
+    }
+  }
+  out << "\n]}\n";
+  return static_cast<bool>(out);
+}
+
+bool Profiler::writeFoldedStacks(const std::string& file_name) const
+{
+  std::ofstream out(file_name);
+  if (!out) {
+    return false;
+  }
+  std::map<std::string, PathStats> stats;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& buffer : buffers_) {
+      aggregate(buffer->events, stats);
+    }
+  }
+  // Folded stack format: "outer;inner <self time in us>".
+  for (const auto& [path, path_stats] : stats) {
+    out << path << ' ' << path_stats.self_ns / 1000 << '\n';
+  }
+  return static_cast<bool>(out);
+}
+
+void Profiler::report(Logger* logger, int max_entries) const
+{
+  std::map<std::string, PathStats> stats;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& buffer : buffers_) {
+      aggregate(buffer->events, stats);
+    }
+  }
+  std::vector<std::pair<std::string, PathStats>> sorted(stats.begin(),
+                                                        stats.end());
+  std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+    return a.second.inclusive_ns > b.second.inclusive_ns;
+  });
+  if (static_cast<int>(sorted.size()) > max_entries) {
+    sorted.resize(max_entries);
+  }
+
+  logger->report("{:>12} {:>12} {:>8}  {}", "Total (ms)", "Self (ms)", "Calls",
+                 "Scope");
+  for (const auto& [path, path_stats] : sorted) {
+    logger->report("{:>12.3f} {:>12.3f} {:>8}  {}",
+                   path_stats.inclusive_ns / 1e6,
+                   path_stats.self_ns / 1e6,
+                   path_stats.count,
+                   path);
+  }
+}
+
+}  // namespace utl
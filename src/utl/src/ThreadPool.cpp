@@ -0,0 +1,183 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "utl/ThreadPool.h"
+
+namespace utl {
+
+thread_local bool ThreadPool::in_worker_ = false;
+
+ThreadPool& ThreadPool::global()
+{
+  static ThreadPool pool;
+  return pool;
+}
+
+ThreadPool::ThreadPool(int threads)
+{
+  setThreadCount(threads);
+}
+
+ThreadPool::~ThreadPool()
+{
+  stopWorkers();
+}
+
+void ThreadPool::setThreadCount(int threads)
+{
+  threads = std::max(threads, 1);
+  if (threads == threads_ && workers_.size() == threads - 1U) {
+    return;
+  }
+  stopWorkers();
+  threads_ = threads;
+  startWorkers(threads - 1);
+}
+
+void ThreadPool::startWorkers(int count)
+{
+  stopping_ = false;
+  workers_.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    workers_.emplace_back(&ThreadPool::workerLoop, this);
+  }
+}
+
+void ThreadPool::stopWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  task_ready_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+void ThreadPool::enqueue(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  task_ready_.notify_one();
+}
+
+void ThreadPool::workerLoop()
+{
+  in_worker_ = true;
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_ready_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+      // Queued tasks are drained before stopping.
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+bool ThreadPool::runPendingTask()
+{
+  std::function<void()> task;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tasks_.empty()) {
+      return false;
+    }
+    task = std::move(tasks_.front());
+    tasks_.pop_front();
+  }
+  // Run as a worker so that nested parallel work stays serial.
+  const bool was_worker = in_worker_;
+  in_worker_ = true;
+  task();
+  in_worker_ = was_worker;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////
+
+TaskGroup::~TaskGroup()
+{
+  // Tasks reference this group so they must finish before it goes away.
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this] { return pending_ == 0; });
+}
+
+void TaskGroup::finish(std::exception_ptr error)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (error && !error_) {
+    error_ = error;
+  }
+  if (--pending_ == 0) {
+    done_.notify_all();
+  }
+}
+
+void TaskGroup::wait()
+{
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (pending_ == 0) {
+        break;
+      }
+    }
+    if (!pool_.runPendingTask()) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      done_.wait(lock, [this] { return pending_ == 0; });
+      break;
+    }
+  }
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(error, error_);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+}  // namespace utl
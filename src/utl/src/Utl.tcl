@@ -128,6 +128,34 @@ proc man { args } {
   }
 }
 
+sta::define_cmd_args "start_profiler" {}
+proc start_profiler { args } {
+  sta::check_argc_eq0 "start_profiler" $args
+  utl::start_profiler
+}
+
+sta::define_cmd_args "stop_profiler" { [-trace_file trace_file]\
+                                       [-stacks_file stacks_file]\
+                                       [-report_count count]}
+proc stop_profiler { args } {
+  sta::parse_key_args "stop_profiler" args \
+    keys {-trace_file -stacks_file -report_count} flags {}
+  sta::check_argc_eq0 "stop_profiler" $args
+
+  utl::stop_profiler
+  if { [info exists keys(-trace_file)] } {
+    utl::write_profiler_trace [file nativename $keys(-trace_file)]
+  }
+  if { [info exists keys(-stacks_file)] } {
+    utl::write_profiler_stacks [file nativename $keys(-stacks_file)]
+  }
+  if { [info exists keys(-report_count)] } {
+    set count $keys(-report_count)
+    sta::check_positive_integer "-report_count" $count
+    utl::report_profiler $count
+  }
+}
+
 namespace eval utl {
 
 proc get_input { } {
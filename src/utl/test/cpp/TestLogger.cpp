@@ -0,0 +1,167 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "spdlog/sinks/ostream_sink.h"
+#include "utl/Logger.h"
+
+namespace utl {
+
+namespace {
+
+int countLines(const std::string& text, const std::string& pattern)
+{
+  int count = 0;
+  std::istringstream stream(text);
+  std::string line;
+  while (std::getline(stream, line)) {
+    if (line.find(pattern) != std::string::npos) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void logFromThreads(Logger* logger, int threads, int messages)
+{
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; t++) {
+    workers.emplace_back([logger, t, messages] {
+      for (int i = 0; i < messages; i++) {
+        logger->info(UTL, 9001, "thread {} message {}", t, i);
+        debugPrint(logger, UTL, "test", 2, "thread {} debug {}", t, i);
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+}  // namespace
+
+// Messages issued from many threads respect the per-message limit.
+TEST(Utl, parallel_message_limit)
+{
+  Logger logger;
+  std::ostringstream out;
+  auto sink = std::make_shared<spdlog::sinks::ostream_sink_mt>(out);
+  logger.addSink(sink);
+  logFromThreads(&logger, 8, 500);
+  logger.removeSink(sink);
+
+  EXPECT_EQ(countLines(out.str(), "UTL-9001] thread"), 1000);
+  EXPECT_EQ(countLines(out.str(), "UTL-9001] message limit reached"), 1);
+  EXPECT_EQ(countLines(out.str(), "DEBUG"), 0);
+}
+
+TEST(Utl, debug_check)
+{
+  Logger logger;
+  EXPECT_FALSE(logger.debugCheck(UTL, "test", 1));
+  logger.setDebugLevel(UTL, "test", 2);
+  logger.setDebugLevel(UTL, "other", 1);
+  EXPECT_TRUE(logger.debugCheck(UTL, "test", 2));
+  EXPECT_FALSE(logger.debugCheck(UTL, "test", 3));
+  EXPECT_TRUE(logger.debugCheck(UTL, "other", 1));
+  EXPECT_FALSE(logger.debugCheck(UTL, "other", 2));
+  EXPECT_FALSE(logger.debugCheck(DRT, "test", 1));
+  logger.setDebugLevel(UTL, "test", 0);
+  EXPECT_FALSE(logger.debugCheck(UTL, "test", 1));
+  EXPECT_TRUE(logger.debugCheck(UTL, "other", 1));
+  logger.setDebugLevel(UTL, "other", 0);
+  EXPECT_FALSE(logger.debugCheck(UTL, "other", 1));
+}
+
+// Async logging writes every message once it is turned off again.
+TEST(Utl, async_logging)
+{
+  Logger logger;
+  std::ostringstream out;
+  auto sink = std::make_shared<spdlog::sinks::ostream_sink_mt>(out);
+  logger.addSink(sink);
+  logger.setDebugLevel(UTL, "test", 2);
+  logger.setAsync(true);
+  logFromThreads(&logger, 4, 100);
+  logger.setAsync(false);
+  logger.removeSink(sink);
+
+  EXPECT_EQ(countLines(out.str(), "UTL-9001] thread"), 400);
+  EXPECT_EQ(countLines(out.str(), "[DEBUG UTL-test] thread"), 400);
+}
+
+// Closed metrics stages record their resource usage and counters.
+TEST(Utl, metrics_stage_resources)
+{
+  const char* metrics_file = "metrics_stage_resources.json";
+  {
+    Logger logger(nullptr, metrics_file);
+    int64_t instances = 10;
+    logger.addMetricsCounter("design__instance__count",
+                             [&instances] { return instances; });
+    logger.pushMetricsStage("place__{}");
+    instances = 25;
+    logger.metric("value", 1);
+    logger.popMetricsStage();
+    logger.pushMetricsStage("units__{}", false);
+    logger.popMetricsStage();
+  }
+  std::ifstream in(metrics_file);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  const std::string json = buffer.str();
+  std::remove(metrics_file);
+
+  for (const char* key : {"place__value",
+                          "place__runtime__wall",
+                          "place__runtime__cpu",
+                          "place__mem__peak",
+                          "place__mem__current",
+                          "place__threads"}) {
+    EXPECT_NE(json.find(std::string("\"") + key + "\""), std::string::npos)
+        << key;
+  }
+  EXPECT_NE(json.find("\"place__design__instance__count__start\": 10"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"place__design__instance__count__end\": 25"),
+            std::string::npos);
+  EXPECT_EQ(json.find("units__"), std::string::npos);
+}
+
+}  // namespace utl
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utl/Profiler.h"
+
+namespace utl {
+
+namespace {
+
+std::string readFile(const std::string& file_name)
+{
+  std::ifstream in(file_name);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  return buffer.str();
+}
+
+void nested()
+{
+  ProfileScope outer("outer");
+  for (int i = 0; i < 3; ++i) {
+    ProfileScope inner("inner");
+  }
+}
+
+}  // namespace
+
+TEST(ProfilerTest, disabled_records_nothing)
+{
+  Profiler& profiler = Profiler::instance();
+  profiler.clear();
+  profiler.stop();
+  nested();
+  EXPECT_TRUE(profiler.empty());
+}
+
+TEST(ProfilerTest, folded_stacks)
+{
+  Profiler& profiler = Profiler::instance();
+  profiler.start();
+  nested();
+  profiler.stop();
+
+  const std::string file_name = "profiler_test.folded";
+  ASSERT_TRUE(profiler.writeFoldedStacks(file_name));
+  const std::string stacks = readFile(file_name);
+  std::remove(file_name.c_str());
+
+  EXPECT_NE(stacks.find("outer "), std::string::npos);
+  EXPECT_NE(stacks.find("outer;inner "), std::string::npos);
+}
+
+TEST(ProfilerTest, chrome_trace_from_threads)
+{
+  Profiler& profiler = Profiler::instance();
+  profiler.start();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back(nested);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  profiler.stop();
+
+  const std::string file_name = "profiler_test.json";
+  ASSERT_TRUE(profiler.writeChromeTrace(file_name));
+  const std::string trace = readFile(file_name);
+  std::remove(file_name.c_str());
+
+  int outer = 0;
+  int inner = 0;
+  for (size_t pos = trace.find("\"name\":"); pos != std::string::npos;
+       pos = trace.find("\"name\":", pos + 1)) {
+    if (trace.compare(pos, 14, "\"name\":\"outer\"") == 0) {
+      outer++;
+    } else if (trace.compare(pos, 14, "\"name\":\"inner\"") == 0) {
+      inner++;
+    }
+  }
+  EXPECT_EQ(outer, 4);
+  EXPECT_EQ(inner, 12);
+  EXPECT_EQ(trace.front(), '{');
+}
+
+TEST(ProfilerTest, scope_done_early)
+{
+  Profiler& profiler = Profiler::instance();
+  profiler.start();
+  {
+    ProfileScope scope("early");
+    scope.done();
+    ProfileScope sibling("sibling");
+  }
+  profiler.stop();
+
+  const std::string file_name = "profiler_test_early.folded";
+  ASSERT_TRUE(profiler.writeFoldedStacks(file_name));
+  const std::string stacks = readFile(file_name);
+  std::remove(file_name.c_str());
+
+  // sibling must not be nested under the closed scope.
+  EXPECT_EQ(stacks.find("early;sibling"), std::string::npos);
+  EXPECT_NE(stacks.find("sibling "), std::string::npos);
+}
+
+}  // namespace utl
@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utl/ThreadPool.h"
+
+namespace utl {
+
+TEST(ThreadPoolTest, parallel_for_visits_each_index_once)
+{
+  ThreadPool pool(4);
+  std::vector<int> visits(1000, 0);
+  pool.parallelFor(0, visits.size(), [&](int i) { visits[i]++; }, 7);
+  for (int count : visits) {
+    EXPECT_EQ(count, 1);
+  }
+}
+
+TEST(ThreadPoolTest, single_thread_runs_inline)
+{
+  ThreadPool pool(1);
+  const std::thread::id caller = std::this_thread::get_id();
+  bool same_thread = true;
+  pool.parallelFor(0, 100, [&](int) {
+    same_thread &= std::this_thread::get_id() == caller;
+  });
+  EXPECT_TRUE(same_thread);
+  EXPECT_EQ(pool.submit([] { return 42; }).get(), 42);
+}
+
+// Nested parallel loops run serially inside the worker that issued them.
+TEST(ThreadPoolTest, nested_parallel_for)
+{
+  ThreadPool pool(4);
+  std::atomic<int> sum{0};
+  pool.parallelFor(0, 16, [&](int) {
+    const std::thread::id outer = std::this_thread::get_id();
+    const bool in_worker = ThreadPool::inWorker();
+    pool.parallelFor(0, 16, [&](int j) {
+      if (in_worker) {
+        EXPECT_EQ(std::this_thread::get_id(), outer);
+      }
+      sum += j;
+    });
+  });
+  EXPECT_EQ(sum, 16 * (15 * 16 / 2));
+}
+
+TEST(ThreadPoolTest, exception_is_rethrown)
+{
+  ThreadPool pool(4);
+  EXPECT_THROW(pool.parallelFor(0,
+                                1000,
+                                [](int i) {
+                                  if (i == 500) {
+                                    throw std::runtime_error("fail");
+                                  }
+                                }),
+               std::runtime_error);
+  // The pool is still usable afterwards.
+  std::atomic<int> count{0};
+  pool.parallelFor(0, 100, [&](int) { count++; });
+  EXPECT_EQ(count, 100);
+}
+
+TEST(ThreadPoolTest, task_group)
+{
+  ThreadPool pool(3);
+  std::vector<int> results(10, 0);
+  TaskGroup group(pool);
+  for (int i = 0; i < results.size(); ++i) {
+    group.run([&results, i] { results[i] = i * i; });
+  }
+  group.wait();
+  for (int i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i], i * i);
+  }
+}
+
+TEST(ThreadPoolTest, resize)
+{
+  ThreadPool pool(2);
+  std::atomic<int> count{0};
+  pool.parallelFor(0, 100, [&](int) { count++; });
+  pool.setThreadCount(6);
+  EXPECT_EQ(pool.getThreadCount(), 6);
+  pool.parallelFor(0, 100, [&](int) { count++; });
+  EXPECT_EQ(count, 200);
+}
+
+}  // namespace utl